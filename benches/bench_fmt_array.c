@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    bench_fmt_array.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   整数数组格式化的性能
+ * @version 1.0
+ * @date    2023-08-02
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "bench_helper.h"
+
+/**
+ * @brief 数组长度 (比如一次ADC采样的数据)
+ *
+ */
+#define BENCH_ARRAY_SIZE 4096
+
+/**
+ * @brief 迭代次数
+ *
+ */
+#define BENCH_ARRAY_ITERATIONS 500
+
+static uint8_t array_u8[BENCH_ARRAY_SIZE];
+static uint16_t array_u16[BENCH_ARRAY_SIZE];
+static int32_t array_i32[BENCH_ARRAY_SIZE];
+
+/**
+ * @brief 逐个元素格式化, 作为对比
+ *
+ */
+static void format_per_element(MString* str, const int32_t* array)
+{
+    usize_t i;
+    for (i = 0; i < BENCH_ARRAY_SIZE; i += 1) {
+        mstr_fmt_itoa(
+            str, array[i], MStrFmtIntIndex_Dec, MStrFmtSignDisplay_NegOnly
+        );
+        if (i + 1 < BENCH_ARRAY_SIZE) {
+            mstr_append(str, ',');
+        }
+    }
+}
+
+int main(void)
+{
+    const long iter = BENCH_ARRAY_ITERATIONS;
+    const uint32_t size = BENCH_ARRAY_SIZE;
+    usize_t i;
+    bench_init();
+    for (i = 0; i < BENCH_ARRAY_SIZE; i += 1) {
+        uint32_t value = (uint32_t)i * 2654435761u;
+        array_u8[i] = (uint8_t)value;
+        array_u16[i] = (uint16_t)(value >> 4);
+        array_i32[i] = (int32_t)value;
+    }
+    BENCH_RUN("{[0:u8]} x 4096", iter, {
+        MString str;
+        mstr_create_empty(&str);
+        mstr_format(&str, "{[0:u8]}", 2, array_u8, size);
+        mstr_free(&str);
+    });
+    BENCH_RUN("{[0:u16]} x 4096", iter, {
+        MString str;
+        mstr_create_empty(&str);
+        mstr_format(&str, "{[0:u16]}", 2, array_u16, size);
+        mstr_free(&str);
+    });
+    BENCH_RUN("{[0:u16:x]} x 4096", iter, {
+        MString str;
+        mstr_create_empty(&str);
+        mstr_format(&str, "{[0:u16:x]}", 2, array_u16, size);
+        mstr_free(&str);
+    });
+    BENCH_RUN("{[0:i32]} x 4096", iter, {
+        MString str;
+        mstr_create_empty(&str);
+        mstr_format(&str, "{[0:i32]}", 2, array_i32, size);
+        mstr_free(&str);
+    });
+    BENCH_RUN("mstr_fmt_itoa per element x 4096", iter, {
+        MString str;
+        mstr_create_empty(&str);
+        format_per_element(&str, array_i32);
+        mstr_free(&str);
+    });
+    return 0;
+}
@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    bench_fmt_chrono.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   Unix时间戳格式化和gmtime + BCD转换的性能对比
+ * @version 1.0
+ * @date    2023-08-12
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "bench_helper.h"
+
+/**
+ * @brief 样本数目 (比如日志的时间戳)
+ *
+ */
+#define BENCH_SAMPLE_COUNT 256
+
+/**
+ * @brief 迭代次数
+ *
+ */
+#define BENCH_SAMPLE_ITERATIONS 2000
+
+static MStrTimestamp samples[BENCH_SAMPLE_COUNT];
+
+/**
+ * @brief 单调递增的日期时间, 间隔1ms (比如连续的日志)
+ *
+ */
+static MStrTime log_times[BENCH_SAMPLE_COUNT];
+
+/**
+ * @brief 小于100的值转为BCD码
+ *
+ */
+static uint8_t to_bcd(int v)
+{
+    return (uint8_t)(((v / 10) << 4) | (v % 10));
+}
+
+/**
+ * @brief 使用gmtime转换时间戳, 然后按照BCD码打包
+ *
+ */
+static void gmtime_to_time(MStrTime* tm, const MStrTimestamp* ts)
+{
+    struct tm gm;
+    time_t sec = (time_t)ts->second;
+    uint32_t sub = ts->nanosecond / 100000;
+    gm = *gmtime(&sec);
+    tm->year = (uint16_t)((to_bcd((gm.tm_year + 1900) / 100) << 8) |
+                          to_bcd((gm.tm_year + 1900) % 100));
+    tm->month = to_bcd(gm.tm_mon + 1);
+    tm->day = to_bcd(gm.tm_mday);
+    tm->hour = to_bcd(gm.tm_hour);
+    tm->minute = to_bcd(gm.tm_min);
+    tm->second = to_bcd(gm.tm_sec);
+    tm->week = (uint8_t)gm.tm_wday;
+    tm->sub_second = ((uint32_t)to_bcd((int)(sub / 100)) << 8) |
+                     to_bcd((int)(sub % 100));
+}
+
+int main(void)
+{
+    const long iter = BENCH_SAMPLE_ITERATIONS;
+    volatile uint32_t sink = 0;
+    usize_t i;
+    bench_init();
+    for (i = 0; i < BENCH_SAMPLE_COUNT; i += 1) {
+        // 间隔不均匀的, 递增的时间戳
+        samples[i].second = 1683392119 + (int64_t)i * i * 37;
+        samples[i].nanosecond = (uint32_t)i * 3906250;
+    }
+    for (i = 0; i < BENCH_SAMPLE_COUNT; i += 1) {
+        MStrTimestamp ts;
+        ts.second = 1683392119 + (int64_t)(i / 1000);
+        ts.nanosecond = (uint32_t)(i % 1000) * 1000000;
+        mstr_time_from_timestamp(&log_times[i], &ts);
+    }
+    BENCH_RUN("mstr_time_from_timestamp x 256", iter, {
+        MStrTime tm;
+        for (i = 0; i < BENCH_SAMPLE_COUNT; i += 1) {
+            mstr_time_from_timestamp(&tm, &samples[i]);
+            sink += tm.second;
+        }
+    });
+    BENCH_RUN("gmtime + BCD x 256", iter, {
+        MStrTime tm;
+        for (i = 0; i < BENCH_SAMPLE_COUNT; i += 1) {
+            gmtime_to_time(&tm, &samples[i]);
+            sink += tm.second;
+        }
+    });
+    BENCH_RUN("{0:T:%g} x 256", iter, {
+        MString str;
+        mstr_create_empty(&str);
+        for (i = 0; i < BENCH_SAMPLE_COUNT; i += 1) {
+            mstr_format(&str, "{0:T:%g}", 1, &samples[i]);
+        }
+        mstr_free(&str);
+    });
+    BENCH_RUN("gmtime + BCD, {0:t:%g} x 256", iter, {
+        MString str;
+        mstr_create_empty(&str);
+        for (i = 0; i < BENCH_SAMPLE_COUNT; i += 1) {
+            MStrTime tm;
+            gmtime_to_time(&tm, &samples[i]);
+            mstr_format(&str, "{0:t:%g}", 1, &tm);
+        }
+        mstr_free(&str);
+    });
+    BENCH_RUN("{0:t:%g}, +1ms x 256", iter, {
+        MString str;
+        mstr_create_empty(&str);
+        for (i = 0; i < BENCH_SAMPLE_COUNT; i += 1) {
+            mstr_format(&str, "{0:t:%g}", 1, &log_times[i]);
+        }
+        mstr_free(&str);
+    });
+    BENCH_RUN("gmtime, strftime x 256", iter, {
+        MString str;
+        char buff[32];
+        mstr_create_empty(&str);
+        for (i = 0; i < BENCH_SAMPLE_COUNT; i += 1) {
+            struct tm gm;
+            time_t sec = (time_t)samples[i].second;
+            gm = *gmtime(&sec);
+            strftime(buff, sizeof(buff), "%Y-%m-%d %H:%M:%S", &gm);
+            mstr_concat_cstr(&str, buff);
+        }
+        mstr_free(&str);
+    });
+    (void)sink;
+    return 0;
+}
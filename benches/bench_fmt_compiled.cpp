@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    bench_fmt_compiled.cpp
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   编译期解析的格式化串和运行时解析的对比
+ * @version 1.0
+ * @date    2023-08-01
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "bench_helper.h"
+#include "mm_string.hpp"
+
+#define BENCH_FMT_STRING "id={0:i32}, v={1:u32:#>8x}, s={2:s}"
+
+int main(void)
+{
+    using mtfmt::string;
+    const int32_t id = -1234;
+    const uint32_t value = 0xbeef;
+    const char* name = "mtfmt";
+    const long iter = BENCH_DEFAULT_ITERATIONS;
+    bench_init();
+    BENCH_RUN("mstr_format", iter, {
+        MString str;
+        mstr_create_empty(&str);
+        mstr_format(&str, BENCH_FMT_STRING, 3, id, value, name);
+        mstr_free(&str);
+    });
+    BENCH_RUN("string::format", iter, {
+        auto str = string::format(BENCH_FMT_STRING, id, value, name);
+        (void)str;
+    });
+#if _MSTR_USE_CONSTEXPR_PARSER
+    BENCH_RUN("string::format (MSTR_COMPILE_FORMAT)", iter, {
+        auto str = string::format(
+            MSTR_COMPILE_FORMAT(BENCH_FMT_STRING), id, value, name
+        );
+        (void)str;
+    });
+#endif // _MSTR_USE_CONSTEXPR_PARSER
+    return 0;
+}
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    bench_fmt_fixed.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   定点数格式化和先转为浮点数再格式化的性能对比
+ * @version 1.0
+ * @date    2023-08-06
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "bench_helper.h"
+
+/**
+ * @brief 样本数目 (比如一路ADC的采样值)
+ *
+ */
+#define BENCH_SAMPLE_COUNT 256
+
+/**
+ * @brief 迭代次数
+ *
+ */
+#define BENCH_SAMPLE_ITERATIONS 2000
+
+static int32_t samples[BENCH_SAMPLE_COUNT];
+
+int main(void)
+{
+    const long iter = BENCH_SAMPLE_ITERATIONS;
+    usize_t i;
+    bench_init();
+    for (i = 0; i < BENCH_SAMPLE_COUNT; i += 1) {
+        samples[i] = (int32_t)((uint32_t)i * 2654435761u);
+    }
+    BENCH_RUN("mstr_fmt_ifixtoa F16.16 .3 x 256", iter, {
+        MString str;
+        mstr_create_empty(&str);
+        for (i = 0; i < BENCH_SAMPLE_COUNT; i += 1) {
+            mstr_fmt_ifixtoa(
+                &str, samples[i], 16, 16, 3, MStrFmtSignDisplay_NegOnly
+            );
+        }
+        mstr_free(&str);
+    });
+    BENCH_RUN("mstr_fmt_ifixtoa F16.16 x 256", iter, {
+        MString str;
+        mstr_create_empty(&str);
+        for (i = 0; i < BENCH_SAMPLE_COUNT; i += 1) {
+            mstr_fmt_ifixtoa(
+                &str, samples[i], 16, 16, -1, MStrFmtSignDisplay_NegOnly
+            );
+        }
+        mstr_free(&str);
+    });
+    BENCH_RUN("{0:F16.16:.3} x 256", iter, {
+        MString str;
+        mstr_create_empty(&str);
+        for (i = 0; i < BENCH_SAMPLE_COUNT; i += 1) {
+            mstr_format(&str, "{0:F16.16:.3}", 1, samples[i]);
+        }
+        mstr_free(&str);
+    });
+    BENCH_RUN("mstr_fmt_iqtoa q31 x 256", iter, {
+        MString str;
+        mstr_create_empty(&str);
+        for (i = 0; i < BENCH_SAMPLE_COUNT; i += 1) {
+            mstr_fmt_iqtoa(
+                &str, samples[i], 31, MStrFmtSignDisplay_NegOnly
+            );
+        }
+        mstr_free(&str);
+    });
+    BENCH_RUN("mstr_fmt_iq64toa q63 .6 x 256", iter, {
+        MString str;
+        mstr_create_empty(&str);
+        for (i = 0; i < BENCH_SAMPLE_COUNT; i += 1) {
+            mstr_fmt_iq64toa(
+                &str,
+                (int64_t)samples[i] << 32,
+                63,
+                6,
+                MStrFmtSignDisplay_NegOnly
+            );
+        }
+        mstr_free(&str);
+    });
+    BENCH_RUN("float, snprintf %.3f x 256", iter, {
+        MString str;
+        char buff[32];
+        mstr_create_empty(&str);
+        for (i = 0; i < BENCH_SAMPLE_COUNT; i += 1) {
+            float v = (float)samples[i] / 65536.0f;
+            snprintf(buff, sizeof(buff), "%.3f", (double)v);
+            mstr_concat_cstr(&str, buff);
+        }
+        mstr_free(&str);
+    });
+    return 0;
+}
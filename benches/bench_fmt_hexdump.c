@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    bench_fmt_hexdump.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   字节数组十六进制转储和Base64/Base32编码的性能
+ * @version 1.0
+ * @date    2023-08-05
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "bench_helper.h"
+
+/**
+ * @brief 数据长度 (比如一个抓到的数据包)
+ *
+ */
+#define BENCH_FRAME_SIZE 4096
+
+/**
+ * @brief 迭代次数
+ *
+ */
+#define BENCH_FRAME_ITERATIONS 500
+
+static uint8_t frame[BENCH_FRAME_SIZE];
+
+int main(void)
+{
+    const long iter = BENCH_FRAME_ITERATIONS;
+    const uint32_t size = BENCH_FRAME_SIZE;
+    usize_t i;
+    bench_init();
+    for (i = 0; i < BENCH_FRAME_SIZE; i += 1) {
+        frame[i] = (uint8_t)(((uint32_t)i * 2654435761u) >> 24);
+    }
+    BENCH_RUN("{[0:u8|: :h]} x 4096", iter, {
+        MString str;
+        mstr_create_empty(&str);
+        mstr_format(&str, "{[0:u8|: :h]}", 2, frame, size);
+        mstr_free(&str);
+    });
+    BENCH_RUN("{[0:u8|::y]} x 4096", iter, {
+        MString str;
+        mstr_create_empty(&str);
+        mstr_format(&str, "{[0:u8|::y]}", 2, frame, size);
+        mstr_free(&str);
+    });
+    BENCH_RUN("{[0:u8|: :y]} x 4096", iter, {
+        MString str;
+        mstr_create_empty(&str);
+        mstr_format(&str, "{[0:u8|: :y]}", 2, frame, size);
+        mstr_free(&str);
+    });
+    BENCH_RUN("{[0:u8:D]} x 4096", iter, {
+        MString str;
+        mstr_create_empty(&str);
+        mstr_format(&str, "{[0:u8:D]}", 2, frame, size);
+        mstr_free(&str);
+    });
+    BENCH_RUN("{[0:u8:b64]} x 4096", iter, {
+        MString str;
+        mstr_create_empty(&str);
+        mstr_format(&str, "{[0:u8:b64]}", 2, frame, size);
+        mstr_free(&str);
+    });
+    BENCH_RUN("{[0:u8:b32]} x 4096", iter, {
+        MString str;
+        mstr_create_empty(&str);
+        mstr_format(&str, "{[0:u8:b32]}", 2, frame, size);
+        mstr_free(&str);
+    });
+    return 0;
+}
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    bench_hash.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   mstr_hash 和逐字节的哈希的吞吐量对比
+ * @version 1.0
+ * @date    2023-08-31
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "bench_helper.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief 最长的输入
+ *
+ */
+#define BENCH_DATA_SIZE 16384
+
+/**
+ * @brief 每个长度处理的总字节数
+ *
+ */
+#define BENCH_TOTAL_BYTES (64L * 1024 * 1024)
+
+/**
+ * @brief 输入数据
+ *
+ */
+static uint8_t data[BENCH_DATA_SIZE];
+
+/**
+ * @brief 防止结果被优化掉
+ *
+ */
+static volatile uint64_t sink;
+
+/**
+ * @brief 逐字节的FNV-1a, 作为对比
+ *
+ */
+static uint64_t fnv1a(const uint8_t* p, usize_t len)
+{
+    uint64_t h = 0xcbf29ce484222325ull;
+    usize_t i;
+    for (i = 0; i < len; i += 1) {
+        h ^= p[i];
+        h *= 0x100000001b3ull;
+    }
+    return h;
+}
+
+int main(void)
+{
+    static const usize_t sizes[] = {8, 32, 256, 4096, BENCH_DATA_SIZE};
+    char name[64];
+    usize_t i;
+    bench_init();
+    for (i = 0; i < BENCH_DATA_SIZE; i += 1) {
+        data[i] = (uint8_t)(i * 131 + 7);
+    }
+    for (i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i += 1) {
+        const usize_t len = sizes[i];
+        const long iter = BENCH_TOTAL_BYTES / (long)len;
+        sprintf(name, "mstr_hash_bytes %u bytes", (unsigned)len);
+        BENCH_RUN(name, iter, {
+            sink += mstr_hash_bytes(data, len, (uint64_t)bench_i_);
+        });
+        sprintf(name, "mstr_hash_update %u bytes", (unsigned)len);
+        BENCH_RUN(name, iter, {
+            MStrHashState st;
+            mstr_hash_init(&st, (uint64_t)bench_i_);
+            mstr_hash_update(&st, data, len);
+            sink += mstr_hash_final(&st);
+        });
+        sprintf(name, "fnv1a %u bytes", (unsigned)len);
+        BENCH_RUN(name, iter, {
+            data[0] = (uint8_t)bench_i_;
+            sink += fnv1a(data, len);
+        });
+    }
+    return 0;
+}
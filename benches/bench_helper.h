@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    bench_helper.h
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   benchmark 使用的工具
+ * @version 1.0
+ * @date    2023-08-01
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#if !defined(_INCLUDE_BENCH_HELPER_H_)
+#define _INCLUDE_BENCH_HELPER_H_ 1
+#include "mtfmt.h"
+#include <stdio.h>
+#include <time.h>
+
+/**
+ * @brief benchmark 使用的堆大小
+ *
+ */
+#define BENCH_HEAP_SIZE (256 * 1024)
+
+/**
+ * @brief 默认的迭代次数
+ *
+ */
+#define BENCH_DEFAULT_ITERATIONS 200000
+
+/**
+ * @brief 运行一个benchmark, 并打印每次迭代的平均耗时
+ *
+ * @param name: 名称
+ * @param iter: 迭代次数
+ * @param body: 每次迭代执行的语句
+ *
+ */
+#define BENCH_RUN(name, iter, body)                                  \
+    do {                                                             \
+        const clock_t bench_beg_ = clock();                          \
+        for (long bench_i_ = 0; bench_i_ < (long)(iter);             \
+             bench_i_ += 1) {                                        \
+            body;                                                    \
+        }                                                            \
+        bench_report(                                                \
+            (name), (long)(iter), (double)(clock() - bench_beg_)     \
+        );                                                           \
+    } while (0)
+
+/**
+ * @brief 打印结果
+ *
+ */
+static inline void bench_report(const char* name, long iter, double tick)
+{
+    double ns = tick * 1e9 / (double)CLOCKS_PER_SEC / (double)iter;
+    printf("%-40s %12.1f ns/iter (%ld iters)\n", name, ns, iter);
+}
+
+/**
+ * @brief 初始化堆
+ *
+ */
+static inline void bench_init(void)
+{
+#if !_MSTR_USE_MALLOC
+    static byte_t heap[BENCH_HEAP_SIZE];
+    mstr_heap_init(heap, BENCH_HEAP_SIZE);
+#endif // _MSTR_USE_MALLOC
+}
+#endif // _INCLUDE_BENCH_HELPER_H_
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    bench_rope.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   分块构建器和连续的MString构建大输出的性能对比
+ * @version 1.0
+ * @date    2023-08-28
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "bench_helper.h"
+#include <stdio.h>
+
+/**
+ * @brief 每次构建的行数
+ *
+ */
+#define BENCH_LINE_COUNT 4096
+
+/**
+ * @brief 迭代次数
+ *
+ */
+#define BENCH_SAMPLE_ITERATIONS 200
+
+/**
+ * @brief 每行的内容
+ *
+ */
+static const char* line = "sensor,1692000000,21.5,40,ok\n";
+
+/**
+ * @brief 防止结果被优化掉
+ *
+ */
+static volatile usize_t sink;
+
+/**
+ * @brief 丢弃数据的IO
+ *
+ */
+static mstr_result_t null_write(
+    void* ctx, const byte_t* data, usize_t len
+)
+{
+    (void)ctx;
+    sink += len + data[0];
+    return MStr_Ok;
+}
+
+int main(void)
+{
+    const long iter = BENCH_SAMPLE_ITERATIONS;
+    MStrRope rope;
+    MStrIOCallback io;
+    bench_init();
+    mstr_io_init(NULL, &io, null_write);
+    BENCH_RUN("mstr_concat_cstr x 4096", iter, {
+        MString str;
+        usize_t i;
+        mstr_create_empty(&str);
+        for (i = 0; i < BENCH_LINE_COUNT; i += 1) {
+            mstr_concat_cstr(&str, line);
+        }
+        sink += str.count;
+        mstr_free(&str);
+    });
+    BENCH_RUN("mstr_rope_concat_cstr x 4096 + flatten", iter, {
+        MString str;
+        usize_t i;
+        mstr_rope_init(&rope, 0);
+        for (i = 0; i < BENCH_LINE_COUNT; i += 1) {
+            mstr_rope_concat_cstr(&rope, line);
+        }
+        mstr_create_empty(&str);
+        mstr_rope_flatten(&rope, &str);
+        sink += str.count;
+        mstr_free(&str);
+        mstr_rope_free(&rope);
+    });
+    // 块在清空之后留给下一次使用
+    mstr_rope_init(&rope, 0);
+    BENCH_RUN("mstr_rope_concat_cstr x 4096 + flush", iter, {
+        usize_t i;
+        for (i = 0; i < BENCH_LINE_COUNT; i += 1) {
+            mstr_rope_concat_cstr(&rope, line);
+        }
+        mstr_rope_flush(&rope, &io);
+    });
+    mstr_rope_free(&rope);
+    BENCH_RUN("mstr_format {0:i32} x 4096", iter, {
+        MString str;
+        int32_t i;
+        mstr_create_empty(&str);
+        for (i = 0; i < BENCH_LINE_COUNT; i += 1) {
+            mstr_format(&str, "{0:i32},", 1, i);
+        }
+        sink += str.count;
+        mstr_free(&str);
+    });
+    BENCH_RUN("mstr_rope_format {0:i32} x 4096", iter, {
+        int32_t i;
+        mstr_rope_init(&rope, 0);
+        for (i = 0; i < BENCH_LINE_COUNT; i += 1) {
+            mstr_rope_format(&rope, "{0:i32},", 1, i);
+        }
+        sink += rope.count;
+        mstr_rope_free(&rope);
+    });
+    return 0;
+}
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    bench_scan_float.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   字符串到浮点数的转换和strtod、strtof的性能对比
+ * @version 1.0
+ * @date    2023-08-24
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "bench_helper.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief 样本数目
+ *
+ */
+#define BENCH_SAMPLE_COUNT 256
+
+/**
+ * @brief 迭代次数
+ *
+ */
+#define BENCH_SAMPLE_ITERATIONS 2000
+
+/**
+ * @brief 使用','分隔的样本: 17位有效位、6位有效位和float的9位有效位
+ *
+ */
+static char text_g17[BENCH_SAMPLE_COUNT * 32];
+static char text_g6[BENCH_SAMPLE_COUNT * 32];
+static char text_f32[BENCH_SAMPLE_COUNT * 32];
+static usize_t len_g17, len_g6, len_f32;
+
+/**
+ * @brief 防止转换结果被优化掉
+ *
+ */
+static volatile double sink;
+
+/**
+ * @brief 生成样本
+ *
+ * @return usize_t: 样本的长度
+ */
+static usize_t make_samples(char* text, const char* fmt, double scale)
+{
+    uint64_t seed = 0x9e3779b97f4a7c15ull;
+    usize_t i, len = 0;
+    for (i = 0; i < BENCH_SAMPLE_COUNT; i += 1) {
+        double v;
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        v = (double)(int64_t)seed / 9223372036854775808.0;
+        v *= scale;
+        len += (usize_t)sprintf(text + len, fmt, v);
+        scale = scale > 1e20 ? 1e-20 : scale * 10;
+    }
+    return len;
+}
+
+int main(void)
+{
+    const long iter = BENCH_SAMPLE_ITERATIONS;
+    bench_init();
+    len_g17 = make_samples(text_g17, "%.17g,", 1e-20);
+    len_g6 = make_samples(text_g6, "%.6g,", 1e-20);
+    len_f32 = make_samples(text_f32, "%.9g,", 1e-10);
+#if _MSTR_USE_FP_FLOAT64
+    BENCH_RUN("mstr_parse_f64 %.17g x 256", iter, {
+        const char* p = text_g17;
+        const char* end = p + len_g17;
+        double v = 0;
+        while (p < end) {
+            mstr_parse_f64(&v, p, end, &p);
+            sink += v;
+            p += 1;
+        }
+    });
+#endif // _MSTR_USE_FP_FLOAT64
+    BENCH_RUN("strtod %.17g x 256", iter, {
+        const char* p = text_g17;
+        const char* end = p + len_g17;
+        char* stop;
+        while (p < end) {
+            sink += strtod(p, &stop);
+            p = stop + 1;
+        }
+    });
+#if _MSTR_USE_FP_FLOAT64
+    BENCH_RUN("mstr_parse_f64 %.6g x 256", iter, {
+        const char* p = text_g6;
+        const char* end = p + len_g6;
+        double v = 0;
+        while (p < end) {
+            mstr_parse_f64(&v, p, end, &p);
+            sink += v;
+            p += 1;
+        }
+    });
+#endif // _MSTR_USE_FP_FLOAT64
+    BENCH_RUN("strtod %.6g x 256", iter, {
+        const char* p = text_g6;
+        const char* end = p + len_g6;
+        char* stop;
+        while (p < end) {
+            sink += strtod(p, &stop);
+            p = stop + 1;
+        }
+    });
+#if _MSTR_USE_FP_FLOAT32
+    BENCH_RUN("mstr_parse_f32 %.9g x 256", iter, {
+        const char* p = text_f32;
+        const char* end = p + len_f32;
+        float v = 0;
+        while (p < end) {
+            mstr_parse_f32(&v, p, end, &p);
+            sink += v;
+            p += 1;
+        }
+    });
+#endif // _MSTR_USE_FP_FLOAT32
+    BENCH_RUN("strtof %.9g x 256", iter, {
+        const char* p = text_f32;
+        const char* end = p + len_f32;
+        char* stop;
+        while (p < end) {
+            sink += strtof(p, &stop);
+            p = stop + 1;
+        }
+    });
+    return 0;
+}
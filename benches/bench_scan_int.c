@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    bench_scan_int.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   字符串到数值的转换、按照模板读取和strtoul等函数的性能对比
+ * @version 1.0
+ * @date    2023-08-20
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "bench_helper.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/**
+ * @brief 样本数目
+ *
+ */
+#define BENCH_SAMPLE_COUNT 256
+
+/**
+ * @brief 迭代次数
+ *
+ */
+#define BENCH_SAMPLE_ITERATIONS 2000
+
+/**
+ * @brief 使用','分隔的样本
+ *
+ */
+static MString text_u32, text_u64, text_q15;
+
+/**
+ * @brief 设备的回复和对应的扫描模板
+ *
+ */
+static const char* reply_cstr = "T=-1234 H=5678";
+static MString reply;
+static MStrScanTemplate reply_tpl;
+
+/**
+ * @brief 防止转换结果被优化掉
+ *
+ */
+static volatile uint64_t sink;
+
+int main(void)
+{
+    const long iter = BENCH_SAMPLE_ITERATIONS;
+    usize_t i;
+    bench_init();
+    mstr_create_empty(&text_u32);
+    mstr_create_empty(&text_u64);
+    mstr_create_empty(&text_q15);
+    for (i = 0; i < BENCH_SAMPLE_COUNT; i += 1) {
+        uint32_t v = (uint32_t)i * 2654435761u;
+        mstr_format(&text_u32, "{0:u32},", 1, v);
+        mstr_fmt_uq64toa(&text_u64, (uint64_t)v * v, 1, -1);
+        mstr_append(&text_u64, ',');
+        mstr_format(&text_q15, "{0:q15},", 1, (int32_t)(v >> 16));
+    }
+    mstr_create(&reply, reply_cstr);
+    mstr_scan_compile(&reply_tpl, "T={0:i32} H={1:u16}");
+    BENCH_RUN("mstr_parse_u32 x 256", iter, {
+        const char* p = text_u32.buff;
+        const char* end = p + text_u32.count;
+        uint32_t v = 0;
+        while (p < end) {
+            mstr_parse_u32(&v, p, end, MStrFmtIntIndex_Dec, &p);
+            sink += v;
+            p += 1;
+        }
+    });
+    BENCH_RUN("strtoul x 256", iter, {
+        const char* p = text_u32.buff;
+        const char* end = p + text_u32.count;
+        char* stop;
+        while (p < end) {
+            sink += strtoul(p, &stop, 10);
+            p = stop + 1;
+        }
+    });
+    BENCH_RUN("mstr_parse_u64 x 256", iter, {
+        const char* p = text_u64.buff;
+        const char* end = p + text_u64.count;
+        uint64_t v = 0;
+        while (p < end) {
+            mstr_parse_u64(&v, p, end, MStrFmtIntIndex_Dec, &p);
+            sink += v;
+            p += 1;
+        }
+    });
+    BENCH_RUN("strtoull x 256", iter, {
+        const char* p = text_u64.buff;
+        const char* end = p + text_u64.count;
+        char* stop;
+        while (p < end) {
+            sink += strtoull(p, &stop, 10);
+            p = stop + 1;
+        }
+    });
+    BENCH_RUN("mstr_parse_iq q15 x 256", iter, {
+        const char* p = text_q15.buff;
+        const char* end = p + text_q15.count;
+        int32_t v = 0;
+        while (p < end) {
+            mstr_parse_iq(&v, p, end, 15, &p);
+            sink += (uint32_t)v;
+            p += 1;
+        }
+    });
+    BENCH_RUN("strtod * 32768 x 256", iter, {
+        const char* p = text_q15.buff;
+        const char* end = p + text_q15.count;
+        char* stop;
+        while (p < end) {
+            sink += (uint32_t)(int32_t)(strtod(p, &stop) * 32768.0);
+            p = stop + 1;
+        }
+    });
+    BENCH_RUN("mstr_scan T={0:i32} H={1:u16}", iter * 64, {
+        int32_t t = 0;
+        uint16_t h = 0;
+        mstr_scan(&reply, "T={0:i32} H={1:u16}", 2, &t, &h);
+        sink += (uint32_t)t + h;
+    });
+    BENCH_RUN("mstr_scan_compiled T={0:i32} H={1:u16}", iter * 64, {
+        int32_t t = 0;
+        uint16_t h = 0;
+        mstr_scan_compiled(&reply, &reply_tpl, 2, &t, &h);
+        sink += (uint32_t)t + h;
+    });
+    BENCH_RUN("sscanf T=%d H=%hu", iter * 64, {
+        int t = 0;
+        unsigned short h = 0;
+        sscanf(reply_cstr, "T=%d H=%hu", &t, &h);
+        sink += (uint32_t)t + h;
+    });
+    return 0;
+}
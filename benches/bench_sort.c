@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    bench_sort.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   mstr_sort_view 和 qsort 的对比
+ * @version 1.0
+ * @date    2023-09-02
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "bench_helper.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief key的数目, 排序项需要 32 * BENCH_KEY_NUM 字节的堆
+ *
+ */
+#define BENCH_KEY_NUM 4096
+
+/**
+ * @brief 每个key的最大长度
+ *
+ */
+#define BENCH_KEY_SIZE 48
+
+/**
+ * @brief key的内容
+ *
+ */
+static char data[BENCH_KEY_NUM][BENCH_KEY_SIZE];
+
+/**
+ * @brief 乱序的key
+ *
+ */
+static MStringView input[BENCH_KEY_NUM];
+
+/**
+ * @brief 排序用的数组
+ *
+ */
+static MStringView work[BENCH_KEY_NUM];
+
+/**
+ * @brief 防止结果被优化掉
+ *
+ */
+static volatile usize_t sink;
+
+/**
+ * @brief qsort的比较函数
+ *
+ */
+static int compare_view(const void* a, const void* b)
+{
+    return mstr_compare_view(
+        (const MStringView*)a, (const MStringView*)b
+    );
+}
+
+int main(void)
+{
+    static const char* service[] = {
+        "gateway", "auth", "billing", "storage", "scheduler",
+    };
+    uint32_t seed = 12345;
+    usize_t i;
+    bench_init();
+    // 类似日志的key, 有较长的公共前缀
+    for (i = 0; i < BENCH_KEY_NUM; i += 1) {
+        seed = seed * 1103515245u + 12345u;
+        sprintf(
+            data[i],
+            "svc/%s/node-%02u/req-%08x",
+            service[(seed >> 8) % 5],
+            (unsigned)((seed >> 16) % 32),
+            (unsigned)(seed ^ (uint32_t)i)
+        );
+        mstr_view_from_cstr(&input[i], data[i], NULL);
+    }
+    BENCH_RUN("mstr_sort_view 4096 keys", 200, {
+        memcpy(work, input, sizeof(input));
+        mstr_sort_view(work, BENCH_KEY_NUM, NULL);
+        sink += work[bench_i_ % BENCH_KEY_NUM].count;
+    });
+    BENCH_RUN("qsort 4096 keys", 200, {
+        memcpy(work, input, sizeof(input));
+        qsort(work, BENCH_KEY_NUM, sizeof(MStringView), compare_view);
+        sink += work[bench_i_ % BENCH_KEY_NUM].count;
+    });
+    return 0;
+}
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    bench_split.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   分割迭代器和mstr_find + 复制字段的性能对比
+ * @version 1.0
+ * @date    2023-08-27
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "bench_helper.h"
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief 记录数目
+ *
+ */
+#define BENCH_RECORD_COUNT 256
+
+/**
+ * @brief 迭代次数
+ *
+ */
+#define BENCH_SAMPLE_ITERATIONS 2000
+
+/**
+ * @brief 类似CSV的传感器记录, 每条记录以';'结束
+ *
+ */
+static char text[BENCH_RECORD_COUNT * 64];
+static usize_t text_len;
+
+/**
+ * @brief 防止结果被优化掉
+ *
+ */
+static volatile usize_t sink;
+
+int main(void)
+{
+    const long iter = BENCH_SAMPLE_ITERATIONS;
+    MString input, field;
+    MStringView view;
+    usize_t i;
+    bench_init();
+    for (i = 0; i < BENCH_RECORD_COUNT; i += 1) {
+        text_len += (usize_t)sprintf(
+            text + text_len,
+            "%u,sensor_%02u,%u.%u,%u,ok;",
+            (unsigned)(1692000000u + i),
+            (unsigned)(i % 64),
+            (unsigned)(i * 7 % 50),
+            (unsigned)(i % 10),
+            (unsigned)(i * 13 % 100)
+        );
+    }
+    mstr_view_from_cstr(&view, text, text + text_len);
+    BENCH_RUN("mstr_split_next ','", iter, {
+        MStringSplit sp;
+        MStringView f;
+        mstr_split_by_chars(&sp, &view, ",", 1);
+        while (mstr_split_next(&sp, &f)) {
+            sink += f.count;
+        }
+    });
+    BENCH_RUN("mstr_split_next \",;\"", iter, {
+        MStringSplit sp;
+        MStringView f;
+        mstr_split_by_chars(&sp, &view, ",;", 2);
+        while (mstr_split_next(&sp, &f)) {
+            sink += f.count;
+        }
+    });
+    BENCH_RUN("mstr_split_next \",;\\t \"", iter, {
+        MStringSplit sp;
+        MStringView f;
+        mstr_split_by_chars(&sp, &view, ",;\t ", 4);
+        while (mstr_split_next(&sp, &f)) {
+            sink += f.count;
+        }
+    });
+    // 原来的做法: 查找分隔符, 再把字段复制出来
+    // mstr_find每次都要从头计算begin_pos的偏移, 所以减少迭代次数
+    mstr_create(&input, text);
+    mstr_create_empty(&field);
+    BENCH_RUN("mstr_find + mstr_concat_cstr_slice", iter / 100, {
+        usize_t pos = 0;
+        usize_t off = 0;
+        MStringMatchResult res;
+        for (;;) {
+            mstr_find(&input, &res, pos, ",", 1);
+            if (!res.is_matched) {
+                break;
+            }
+            mstr_clear(&field);
+            mstr_concat_cstr_slice(
+                &field,
+                input.buff + off,
+                input.buff + off + res.begin_offset
+            );
+            sink += field.count;
+            pos += res.begin_pos + 1;
+            off += res.begin_offset + 1;
+        }
+    });
+    mstr_free(&field);
+    mstr_free(&input);
+    return 0;
+}
@@ -360,6 +360,95 @@
  */
 #define _MSTR_USE_FP (_MSTR_USE_FP_FLOAT32 || _MSTR_USE_FP_FLOAT64)
 
+#if !defined(_MSTR_USE_SIMD)
+/**
+ * @brief 是否使用SIMD指令 (默认在支持的平台上启用)
+ *
+ */
+#define _MSTR_USE_SIMD 1
+#endif // _MSTR_USE_SIMD
+
+#if _MSTR_USE_SIMD &&                              \
+    (defined(__SSE2__) || defined(_M_X64) ||       \
+     (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+/**
+ * @brief 是否可以使用SSE2指令
+ *
+ */
+#define _MSTR_USE_SIMD_SSE2 1
+#else
+/**
+ * @brief 是否可以使用SSE2指令
+ *
+ */
+#define _MSTR_USE_SIMD_SSE2 0
+#endif // _MSTR_USE_SIMD_SSE2
+
+#if !defined(_MSTR_USE_FMT_CACHE)
+/**
+ * @brief 是否缓存格式化串的解析结果 (默认不启用)
+ *
+ * @attention 缓存以格式化串的地址为key,
+ * 启用后传入的格式化串必须是不会被修改的常量
+ */
+#define _MSTR_USE_FMT_CACHE 0
+#endif // _MSTR_USE_FMT_CACHE
+
+#if !defined(_MSTR_FMT_CACHE_SIZE)
+/**
+ * @brief 格式化串缓存的内存大小 (字节, 每个线程一份)
+ *
+ */
+#define _MSTR_FMT_CACHE_SIZE 1024
+#endif // _MSTR_FMT_CACHE_SIZE
+
+#if !defined(_MSTR_FMT_CACHE_SLOTS)
+/**
+ * @brief 格式化串缓存能容纳的格式化串数目 (2的幂)
+ *
+ */
+#define _MSTR_FMT_CACHE_SLOTS 16
+#endif // _MSTR_FMT_CACHE_SLOTS
+
+#if !defined(_MSTR_USE_CHRONO_CACHE)
+/**
+ * @brief 是否缓存上一次格式化的日期时间前缀 (默认不启用)
+ *
+ * @note 每个线程保存一份. 格式和秒以上的部分都相同时,
+ * 只重新格式化亚秒值及其后面的项
+ */
+#define _MSTR_USE_CHRONO_CACHE 0
+#endif // _MSTR_USE_CHRONO_CACHE
+
+#if !defined(_MSTR_USE_SHARED_BUFFER)
+/**
+ * @brief 是否让复制的字符串共享堆上的内存 (默认不启用)
+ *
+ * @note 启用之后 mstr_copy_from 只增加引用计数,
+ * 修改字符串之前才复制一份. stack_region上的字符串还是直接复制
+ */
+#define _MSTR_USE_SHARED_BUFFER 0
+#endif // _MSTR_USE_SHARED_BUFFER
+
+//
+// 线程局部存储的修辞
+//
+#if defined(__cplusplus) && __cplusplus >= 201103L
+#define MSTR_THREAD_LOCAL thread_local
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && \
+    !defined(__STDC_NO_THREADS__)
+#define MSTR_THREAD_LOCAL _Thread_local
+#elif MSTR_BUILD_CC == MSTR_BUILD_CC_GNUC ||     \
+    MSTR_BUILD_CC == MSTR_BUILD_CC_ARMCLANG ||   \
+    MSTR_BUILD_CC == MSTR_BUILD_CC_EMSCRIPTEN
+#define MSTR_THREAD_LOCAL __thread
+#elif MSTR_BUILD_CC == MSTR_BUILD_CC_MSVC
+#define MSTR_THREAD_LOCAL __declspec(thread)
+#else
+// 不支持线程局部存储 (比如裸机), 退化为全局变量
+#define MSTR_THREAD_LOCAL
+#endif // MSTR_THREAD_LOCAL
+
 #if _MSTR_RUNTIME_CTRLFLOW_MARKER
 #if defined(USE_FULL_ASSERT)
 #include "stm32_assert.h"
@@ -485,6 +574,24 @@
  */
 #define MSTRCFG_USE_ALLOCATOR      0x100
 
+/**
+ * @brief 标记是否使用了格式化串缓存 _MSTR_USE_FMT_CACHE
+ *
+ */
+#define MSTRCFG_USE_FMT_CACHE      0x200
+
+/**
+ * @brief 标记是否使用了SIMD指令 _MSTR_USE_SIMD
+ *
+ */
+#define MSTRCFG_USE_SIMD           0x400
+
+/**
+ * @brief 标记是否使用了日期时间前缀缓存 _MSTR_USE_CHRONO_CACHE
+ *
+ */
+#define MSTRCFG_USE_CHRONO_CACHE   0x800
+
 /**
  * @brief 取得库版本信息
  *
@@ -34,10 +34,38 @@ typedef struct tagMStrFmtFormatArgument
 typedef struct tagMStrFmtArgsContext
 {
     va_list* p_ap;
+    const MStrFmtFormatArgument* p_args;
     usize_t max_place;
     MStrFmtFormatArgument cache[MFMT_PLACE_MAX_NUM];
 } MStrFmtArgsContext;
 
+#if _MSTR_USE_FMT_CACHE
+/**
+ * @brief 格式化串缓存的统计信息
+ *
+ */
+typedef struct tagMStrFmtCacheStatistics
+{
+    //! 命中次数
+    usize_t hit;
+
+    //! 未命中次数
+    usize_t miss;
+
+    //! 因为缓存已满而清空缓存的次数
+    usize_t flush;
+
+    //! 缓存中的格式化串数目
+    usize_t entry_count;
+
+    //! 已经使用的缓存大小 (字节)
+    usize_t used_size;
+
+    //! 缓存的总大小 (字节)
+    usize_t capacity;
+} MStrFmtCacheStatistics;
+#endif // _MSTR_USE_FMT_CACHE
+
 /**
  * @brief 转换整数时采用的进制
  *
@@ -98,6 +126,28 @@ mstr_vformat(
     va_list* ap_ptr
 );
 
+/**
+ * @brief 使用参数数组格式化字符串
+ *
+ * @param[out] res_str: 格式化结果输出
+ * @param[in] fmt: 格式化串
+ * @param[in] args: 参数数组, 每个参数带有其类型
+ * @param[in] arg_cnt: 参数数组的长度
+ *
+ * @attention 参数可以按照任意顺序、任意次数地引用,
+ * 且数目不受MFMT_PLACE_MAX_NUM的限制.
+ * 数组参数的长度需要放在下一个参数中, 类型为MStrFmtArgType_Uint32
+ *
+ * @return minfmt_result_t: 格式化结果
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_format_argv(
+    MString* res_str,
+    const char* fmt,
+    const MStrFmtFormatArgument* args,
+    usize_t arg_cnt
+);
+
 /**
  * @brief 按照上下文进行格式化
  *
@@ -111,6 +161,56 @@ mstr_context_format(
     MString* res_str, const char* fmt, MStrFmtArgsContext* ctx
 );
 
+/**
+ * @brief 按照上下文格式化一个已经解析好的replacement field
+ *
+ * @param[out] res_str: 格式化结果
+ * @param[in] parser_result: mstr_fmt_parse_goal 的解析结果
+ * @param[in] ctx: 格式化context
+ *
+ * @note 用于跳过格式化串的解析过程, 例如预先解析好的格式化串
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_context_format_field(
+    MString* res_str,
+    const MStrFmtParseResult* parser_result,
+    MStrFmtArgsContext* ctx
+);
+
+#if _MSTR_USE_FMT_CACHE
+/**
+ * @brief 取得当前线程的格式化串缓存统计信息
+ *
+ * @param[out] stat: 统计信息
+ */
+MSTR_EXPORT_API(void)
+mstr_fmt_cache_statistics(MStrFmtCacheStatistics* stat);
+
+/**
+ * @brief 清空当前线程的格式化串缓存以及统计信息
+ *
+ * @note 格式化串所在的内存被修改或者释放之后,
+ * 需要调用该函数以避免使用过期的解析结果
+ */
+MSTR_EXPORT_API(void) mstr_fmt_cache_clear(void);
+#endif // _MSTR_USE_FMT_CACHE
+
+/**
+ * @brief 字节数组的十六进制转储方式
+ *
+ */
+typedef enum tagMStrFmtHexDumpStyle
+{
+    //! 每个字节为2个小写十六进制字符, 之间为分隔符
+    MStrFmtHexDumpStyle_Bytes,
+
+    //! 每个字节为2个大写十六进制字符, 之间为分隔符
+    MStrFmtHexDumpStyle_Bytes_UpperCase,
+
+    //! 每行16字节, 包括偏移量、十六进制值和ASCII
+    MStrFmtHexDumpStyle_Canonical,
+} MStrFmtHexDumpStyle;
+
 /**
  * @brief 将有符号整数转换为字符串
  *
@@ -139,6 +239,80 @@ mstr_fmt_itoa(
 MSTR_EXPORT_API(mstr_result_t)
 mstr_fmt_utoa(MString* res_str, uint32_t value, MStrFmtIntIndex index);
 
+/**
+ * @brief 将整数数组转换为字符串
+ *
+ * @param[out] res_str: 转换结果
+ * @param[in] array: 数组
+ * @param[in] array_len: 数组的长度
+ * @param[in] ele_type: 元素类型, 只能是8, 16, 32位的整数
+ * @param[in] index: Index
+ * @param[in] sign: 符号的显示方式, 对无符号数无效
+ * @param[in] split_beg: 分隔符的开始
+ * @param[in] split_end: 分隔符的结束
+ *
+ * @note 元素类型和进制只会在开始时判断一次,
+ * 结果直接写入预先分配好的空间中
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_fmt_arrtoa(
+    MString* res_str,
+    const void* array,
+    usize_t array_len,
+    MStrFmtArgType ele_type,
+    MStrFmtIntIndex index,
+    MStrFmtSignDisplay sign,
+    const char* split_beg,
+    const char* split_end
+);
+
+/**
+ * @brief 将字节数组转换为十六进制转储字符串
+ *
+ * @param[out] res_str: 转换结果
+ * @param[in] data: 字节数组
+ * @param[in] data_len: 字节数
+ * @param[in] style: 转储方式
+ * @param[in] split_beg: 分隔符的开始, 对Canonical方式无效
+ * @param[in] split_end: 分隔符的结束
+ *
+ * @note Canonical方式的格式和`hexdump -C`相同,
+ * 行之间用'\n'分隔, 偏移量为8个十六进制字符
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_fmt_hexdump(
+    MString* res_str,
+    const void* data,
+    usize_t data_len,
+    MStrFmtHexDumpStyle style,
+    const char* split_beg,
+    const char* split_end
+);
+
+/**
+ * @brief 将字节数组转换为Base64编码
+ *
+ * @param[out] res_str: 转换结果
+ * @param[in] data: 字节数组
+ * @param[in] data_len: 字节数
+ *
+ * @note 使用RFC 4648的标准字母表, 末尾使用'='补齐
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_fmt_base64(MString* res_str, const void* data, usize_t data_len);
+
+/**
+ * @brief 将字节数组转换为Base32编码
+ *
+ * @param[out] res_str: 转换结果
+ * @param[in] data: 字节数组
+ * @param[in] data_len: 字节数
+ *
+ * @note 使用RFC 4648的标准字母表, 末尾使用'='补齐
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_fmt_base32(MString* res_str, const void* data, usize_t data_len);
+
 /**
  * @brief 将有符号量化值转换为字符串
  *
@@ -167,6 +341,83 @@ mstr_fmt_iqtoa(
 MSTR_EXPORT_API(mstr_result_t)
 mstr_fmt_uqtoa(MString* res_str, uint32_t value, uint32_t quat);
 
+/**
+ * @brief 将有符号量化值转换为字符串, 可以指定小数位数
+ *
+ * @param[out] res_str: 转换结果
+ * @param[in] value: 需要转换的值
+ * @param[in] quat: 量化精度, 1 ~ 63
+ * @param[in] precision: 小数位数, -1表示输出全部的有效位数
+ * @param[in] sign: 符号的显示方式
+ *
+ * @note 指定precision时按照四舍六入五成双进行舍入
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_fmt_iq64toa(
+    MString* res_str,
+    int64_t value,
+    uint32_t quat,
+    int32_t precision,
+    MStrFmtSignDisplay sign
+);
+
+/**
+ * @brief 将无符号量化值转换为字符串, 可以指定小数位数
+ *
+ * @param[out] res_str: 转换结果
+ * @param[in] value: 需要转换的值
+ * @param[in] quat: 量化精度, 1 ~ 63
+ * @param[in] precision: 小数位数, -1表示输出全部的有效位数
+ *
+ * @note 指定precision时按照四舍六入五成双进行舍入
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_fmt_uq64toa(
+    MString* res_str, uint64_t value, uint32_t quat, int32_t precision
+);
+
+/**
+ * @brief 将有符号定点数转换为字符串
+ *
+ * @param[out] res_str: 转换结果
+ * @param[in] value: 需要转换的值, 只使用低ibits + fbits位
+ * @param[in] ibits: 整数部分的位数 (包括符号位)
+ * @param[in] fbits: 小数部分的位数
+ * @param[in] precision: 小数位数, -1表示输出全部的有效位数
+ * @param[in] sign: 符号的显示方式
+ *
+ * @note 指定precision时按照四舍六入五成双进行舍入
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_fmt_ifixtoa(
+    MString* res_str,
+    int32_t value,
+    uint32_t ibits,
+    uint32_t fbits,
+    int32_t precision,
+    MStrFmtSignDisplay sign
+);
+
+/**
+ * @brief 将无符号定点数转换为字符串
+ *
+ * @param[out] res_str: 转换结果
+ * @param[in] value: 需要转换的值, 使用低ibits + fbits位
+ * @param[in] ibits: 整数部分的位数
+ * @param[in] fbits: 小数部分的位数
+ * @param[in] precision: 小数位数, -1表示输出全部的有效位数
+ *
+ * @note 指定precision时按照四舍六入五成双进行舍入
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_fmt_ufixtoa(
+    MString* res_str,
+    uint32_t value,
+    uint32_t ibits,
+    uint32_t fbits,
+    int32_t precision
+);
+
 /**
  * @brief 将日期时间值转换为字符串
  *
@@ -181,4 +432,31 @@ mstr_fmt_ttoa(
     const MStrTime* tm,
     const MStrFmtChronoFormatSpec* spec
 );
+
+/**
+ * @brief 将Unix时间戳转换为字符串
+ *
+ * @param[out] res_str: 转换结果
+ * @param[in] ts: 时间戳
+ * @param[in] spec: 格式化信息
+ *
+ * @note 亚秒值按照MStrTime的单位(0.1ms)截断
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_fmt_tstoa(
+    MString* res_str,
+    const MStrTimestamp* ts,
+    const MStrFmtChronoFormatSpec* spec
+);
+
+/**
+ * @brief 将Unix时间戳转换为日期时间值(UTC)
+ *
+ * @param[out] tm: 日期时间值
+ * @param[in] ts: 时间戳, 需要在0000-01-01 ~ 9999-12-31之间
+ *
+ * @return mstr_result_t: 超出范围时返回 MStr_Err_TimestampOutOfRange
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_time_from_timestamp(MStrTime* tm, const MStrTimestamp* ts);
 #endif // !_INCLUDE_MM_FMT_H_
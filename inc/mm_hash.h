@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    mm_hash.h
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   字符串的哈希
+ * @version 1.0
+ * @date    2023-08-31
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ * @note 64位的非加密哈希 (wyhash), 用于哈希表等场合,
+ * 不能用于需要抵抗攻击的场合. 哈希值和CPU的字节序有关
+ */
+#if !defined(_INCLUDE_MM_HASH_H_)
+#define _INCLUDE_MM_HASH_H_ 1
+#include "mm_cfg.h"
+#include "mm_string.h"
+#include "mm_type.h"
+
+//! 增量计算时一次处理的字节数
+#define MSTR_HASH_BLOCK_SIZE 48
+
+/**
+ * @brief 增量计算哈希的状态
+ *
+ */
+typedef struct tagMStrHashState
+{
+    /**
+     * @brief 3个独立的累加值
+     *
+     */
+    uint64_t lane[3];
+
+    /**
+     * @brief 已经输入的字节数
+     *
+     */
+    uint64_t total;
+
+    /**
+     * @brief 缓冲区中还没有处理的字节数
+     *
+     */
+    usize_t pending;
+
+    /**
+     * @brief 缓冲区, 前16个字节是上一次处理的数据的末尾,
+     * 计算最后一部分时会用到
+     *
+     */
+    uint8_t buff[16 + MSTR_HASH_BLOCK_SIZE];
+} MStrHashState;
+
+/**
+ * @brief 计算一段内存的哈希值
+ *
+ * @param[in] data: 数据
+ * @param[in] len: 数据的字节数
+ * @param[in] seed: 种子
+ */
+MSTR_EXPORT_API(uint64_t)
+mstr_hash_bytes(const void* data, usize_t len, uint64_t seed);
+
+/**
+ * @brief 计算字符串的哈希值, 种子为0
+ *
+ */
+MSTR_EXPORT_API(uint64_t) mstr_hash(const MString* str);
+
+/**
+ * @brief 计算视图的哈希值, 种子为0
+ *
+ */
+MSTR_EXPORT_API(uint64_t) mstr_hash_view(const MStringView* view);
+
+/**
+ * @brief 初始化增量计算的状态
+ *
+ * @param[out] state: 状态
+ * @param[in] seed: 种子
+ */
+MSTR_EXPORT_API(void)
+mstr_hash_init(MStrHashState* state, uint64_t seed);
+
+/**
+ * @brief 输入数据
+ *
+ * @param[inout] state: 状态
+ * @param[in] data: 数据
+ * @param[in] len: 数据的字节数
+ */
+MSTR_EXPORT_API(void)
+mstr_hash_update(MStrHashState* state, const void* data, usize_t len);
+
+/**
+ * @brief 取得哈希值
+ *
+ * @param[in] state: 状态
+ *
+ * @note 结果和把全部数据一次传给 mstr_hash_bytes 相同,
+ * 之后还可以继续输入数据
+ */
+MSTR_EXPORT_API(uint64_t) mstr_hash_final(const MStrHashState* state);
+
+#endif // _INCLUDE_MM_HASH_H_
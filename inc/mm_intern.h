@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    mm_intern.h
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   字符串驻留表
+ * @version 1.0
+ * @date    2023-08-30
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ * @note 相同内容的字符串只保存一份, 放在表自己的arena中.
+ * 驻留之后返回的指针在表释放之前一直有效,
+ * 同一个表返回的两个指针相等当且仅当内容相等
+ */
+#if !defined(_INCLUDE_MM_INTERN_H_)
+#define _INCLUDE_MM_INTERN_H_ 1
+#include "mm_cfg.h"
+#include "mm_result.h"
+#include "mm_string.h"
+#include "mm_type.h"
+
+//! 默认的arena块大小 (字节)
+#define MSTR_INTERN_ARENA_SIZE 4096
+
+//! 哈希表每一组的槽数目, 查找时一次比较一组的控制字节
+#define MSTR_INTERN_GROUP_SIZE 16
+
+/**
+ * @brief 驻留的字符串
+ *
+ */
+typedef struct tagMStrInterned
+{
+    /**
+     * @brief 内容, buff以'\0'结束
+     *
+     */
+    MStringView view;
+
+    /**
+     * @brief 内容的哈希值
+     *
+     */
+    uint64_t hash;
+} MStrInterned;
+
+/**
+ * @brief arena块
+ *
+ */
+typedef struct tagMStrInternArena MStrInternArena;
+
+/**
+ * @brief 字符串驻留表
+ *
+ * @attention 和MString一样, 初始化之后不能直接复制结构体
+ */
+typedef struct tagMStrInternTable
+{
+    /**
+     * @brief 控制字节, 最高位为1表示空槽, 否则是哈希值的低7位
+     *
+     */
+    uint8_t* ctrl;
+
+    /**
+     * @brief 槽
+     *
+     */
+    const MStrInterned** slots;
+
+    /**
+     * @brief 槽的数目, 为0或者 MSTR_INTERN_GROUP_SIZE 的2^n倍
+     *
+     */
+    usize_t capacity;
+
+    /**
+     * @brief 驻留的字符串数目
+     *
+     */
+    usize_t count;
+
+    /**
+     * @brief arena块的链表, 第一个块是正在使用的块
+     *
+     */
+    MStrInternArena* arena;
+
+    /**
+     * @brief arena块的大小
+     *
+     */
+    usize_t arena_size;
+} MStrInternTable;
+
+/**
+ * @brief 驻留表的内存使用
+ *
+ */
+typedef struct tagMStrInternStatistics
+{
+    //! 驻留的字符串数目
+    usize_t entry_count;
+
+    //! 字符串内容的字节数 (不含'\0')
+    usize_t string_size;
+
+    //! arena中已经使用的字节数 (含头部和对齐)
+    usize_t arena_used;
+
+    //! arena块的总大小
+    usize_t arena_capacity;
+
+    //! 哈希表的大小 (控制字节和槽)
+    usize_t table_size;
+} MStrInternStatistics;
+
+/**
+ * @brief 初始化驻留表
+ *
+ * @param[out] tab: 驻留表
+ * @param[in] arena_size: arena块的大小, 为0表示使用
+ * MSTR_INTERN_ARENA_SIZE
+ *
+ * @note 初始化不会分配内存
+ */
+MSTR_EXPORT_API(void)
+mstr_intern_init(MStrInternTable* tab, usize_t arena_size);
+
+/**
+ * @brief 驻留视图的内容
+ *
+ * @param[inout] tab: 驻留表
+ * @param[in] view: 内容
+ * @param[out] interned: 驻留的字符串
+ *
+ * @return mstr_result_t: 分配失败时返回MStr_Err_HeapTooSmall,
+ * 此时表中的内容不变
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_intern_view(
+    MStrInternTable* tab,
+    const MStringView* view,
+    const MStrInterned** interned
+);
+
+/**
+ * @brief 驻留字符串
+ *
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_intern(
+    MStrInternTable* tab,
+    const MString* str,
+    const MStrInterned** interned
+);
+
+/**
+ * @brief 驻留C字符串
+ *
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_intern_cstr(
+    MStrInternTable* tab, const char* str, const MStrInterned** interned
+);
+
+/**
+ * @brief 查找已经驻留的字符串
+ *
+ * @param[in] tab: 驻留表
+ * @param[in] view: 内容
+ *
+ * @return const MStrInterned*: 驻留的字符串, 没有时返回NULL
+ */
+MSTR_EXPORT_API(const MStrInterned*)
+mstr_intern_lookup(const MStrInternTable* tab, const MStringView* view);
+
+/**
+ * @brief 取得驻留表的内存使用
+ *
+ * @param[in] tab: 驻留表
+ * @param[out] stat: 统计信息
+ */
+MSTR_EXPORT_API(void)
+mstr_intern_statistics(
+    const MStrInternTable* tab, MStrInternStatistics* stat
+);
+
+/**
+ * @brief 释放驻留表, 之前返回的指针全部失效
+ *
+ */
+MSTR_EXPORT_API(void) mstr_intern_free(MStrInternTable* tab);
+
+#endif // _INCLUDE_MM_INTERN_H_
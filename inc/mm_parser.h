@@ -25,6 +25,9 @@
 //! 格式化最多支持的WIDTH
 #define MFMT_PLACE_MAX_WIDTH      32
 
+//! 格式化最多支持的小数位数
+#define MFMT_PLACE_MAX_PRECISION  32
+
 //! 日期和时间最多支持的placement数目
 #define MFMT_CHRONO_PLACE_MAX_NUM 8
 
@@ -94,6 +97,21 @@ typedef enum tagMStrFmtArgType
     //! 无符号量化值
     MStrFmtArgType_QuantizedUnsignedValue,
 
+    //! 定点数
+    MStrFmtArgType_FixedValue,
+
+    //! 无符号定点数
+    MStrFmtArgType_FixedUnsignedValue,
+
+    //! 64位量化值(`const int64_t*`), 量化精度大于31时使用
+    MStrFmtArgType_QuantizedValue64,
+
+    //! 无符号64位量化值(`const uint64_t*`)
+    MStrFmtArgType_QuantizedUnsignedValue64,
+
+    //! Unix时间戳(`const MStrTimestamp*`)
+    MStrFmtArgType_Timestamp,
+
     //! Array type, 要和上面的值顺序一致
     MStrFmtArgType_Array_Bit = 0x1000,
 
@@ -126,6 +144,21 @@ typedef enum tagMStrFmtArgType
 
     //! 无符号量化值数组
     MStrFmtArgType_Array_QuantizedUnsignedValue,
+
+    //! 定点数数组
+    MStrFmtArgType_Array_FixedValue,
+
+    //! 无符号定点数数组
+    MStrFmtArgType_Array_FixedUnsignedValue,
+
+    //! 64位量化值数组(`const int64_t*`)
+    MStrFmtArgType_Array_QuantizedValue64,
+
+    //! 无符号64位量化值数组(`const uint64_t*`)
+    MStrFmtArgType_Array_QuantizedUnsignedValue64,
+
+    //! Unix时间戳数组(`const MStrTimestamp*`)
+    MStrFmtArgType_Array_Timestamp,
 } MStrFmtArgType;
 
 /**
@@ -189,6 +222,21 @@ typedef enum tagMStrFmtFormatType
 
     //! 大写十六进制值, 带"0X"前缀
     MStrFmtFormatType_Hex_UpperCase_WithPrefix,
+
+    //! [字节数组] 每个字节为2个小写十六进制字符
+    MStrFmtFormatType_HexBytes,
+
+    //! [字节数组] 每个字节为2个大写十六进制字符
+    MStrFmtFormatType_HexBytes_UpperCase,
+
+    //! [字节数组] 偏移量, 十六进制值和ASCII的转储
+    MStrFmtFormatType_HexDump,
+
+    //! [字节数组] Base64编码
+    MStrFmtFormatType_Base64,
+
+    //! [字节数组] Base32编码
+    MStrFmtFormatType_Base32,
 } MStrFmtFormatType;
 
 /**
@@ -323,6 +371,9 @@ typedef struct tagMStrFmtFormatDescript
     //! 格式化宽度, -1表示使用默认值
     int32_t width;
 
+    //! 小数部分的位数, -1表示使用默认值
+    int32_t precision;
+
     //! 格式化标记
     MStrFmtFormatSpec fmt_spec;
 } MStrFmtFormatDescript;
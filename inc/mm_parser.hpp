@@ -11,12 +11,1342 @@
  */
 #if !defined(_INCLUDE_MM_PARSER_HPP_)
 #define _INCLUDE_MM_PARSER_HPP_ 1
+#include "mm_fmt.h"
+#include "mm_parser.h"
 #include "mm_result.hpp"
+#include <cstddef>
+
+#if !defined(_MSTR_USE_CONSTEXPR_PARSER)
+/**
+ * @brief 是否可以在编译期解析格式化串 (需要C++14的constexpr)
+ *
+ */
+#if __cplusplus >= 201402L || \
+    (defined(_MSVC_LANG) && _MSVC_LANG >= 201402L)
+#define _MSTR_USE_CONSTEXPR_PARSER 1
+#else
+#define _MSTR_USE_CONSTEXPR_PARSER 0
+#endif
+#endif // _MSTR_USE_CONSTEXPR_PARSER
 
 namespace mtfmt
 {
 namespace details
 {
+#if _MSTR_USE_CONSTEXPR_PARSER
+//
+// 这里是 mm_parser.c 的constexpr版本, 规则和它保持一致,
+// 在编译期把格式化串处理为字面量和replacement field组成的表
+//
+
+/**
+ * @brief Token的类型, 和 mm_parser.c 中的 TokenType 对应
+ *
+ */
+enum class fmt_token_type : uint8_t
+{
+    eof,
+    gt,
+    lt,
+    equ,
+    colon,
+    vline_colon,
+    type_int8,
+    type_int16,
+    type_int32,
+    type_uint8,
+    type_uint16,
+    type_uint32,
+    type_ifixed,
+    type_ufixed,
+    type_iquant,
+    type_uquant,
+    type_floating,
+    type_cstring,
+    type_time,
+    type_timestamp,
+    left_brace,
+    right_brace,
+    left_brace_bracket,
+    right_bracket_brace,
+    left_brace_brace,
+    right_brace_brace,
+    digits,
+    // chrono begin
+    chrono_predef_f,
+    chrono_predef_g,
+    // chrono userdef begin
+    chrono_year_1,
+    chrono_year_fixed2,
+    chrono_year_3,
+    chrono_year_fixed4,
+    chrono_month_1,
+    chrono_month_fixed2,
+    chrono_day_1,
+    chrono_day_fixed2,
+    chrono_hour_1,
+    chrono_hour_fixed2,
+    chrono_hour24_1,
+    chrono_hour24_fixed2,
+    chrono_minute_1,
+    chrono_minute_fixed2,
+    chrono_second_1,
+    chrono_second_fixed2,
+    chrono_subsecond_fixed1,
+    chrono_subsecond_fixed2,
+    chrono_subsecond_fixed3,
+    chrono_subsecond_fixed4,
+    chrono_week_name,
+    // chrono end
+    other_char,
+    error,
+};
+
+/**
+ * @brief parser期望一个End的结束符号
+ *
+ */
+constexpr unsigned FMT_STAGE_NEED_END = 0x01;
+
+/**
+ * @brief parser期望对chrono的格式化内容进行解析
+ *
+ */
+constexpr unsigned FMT_STAGE_MATCH_CHRONO = 0x02;
+
+/**
+ * @brief Token
+ *
+ */
+struct fmt_token
+{
+    //! token类型
+    fmt_token_type type = fmt_token_type::eof;
+
+    //! token的起始位置
+    std::size_t beg = 0;
+
+    //! token长度
+    std::size_t len = 0;
+};
+
+/**
+ * @brief 日期时间的格式化项
+ *
+ */
+struct compiled_fmt_chrono_item
+{
+    MStrFmtChronoValueType value_type = MStrFmtChronoValueType_Year;
+    bool fixed_length = false;
+    uint8_t format_length = 0;
+    const char* split_beg = nullptr;
+    const char* split_end = nullptr;
+};
+
+/**
+ * @brief 日期时间的格式化描述
+ *
+ */
+struct compiled_fmt_chrono
+{
+    compiled_fmt_chrono_item items[MFMT_CHRONO_PLACE_MAX_NUM] = {};
+    std::size_t item_cnt = 0;
+};
+
+/**
+ * @brief 解析好的replacement field
+ *
+ */
+struct compiled_fmt_field
+{
+    MStrFmtArgClass arg_class = MStrFmtArgClass_Value;
+    char escape_char = '\0';
+    uint32_t id = 0;
+    MStrFmtArgType typ = MStrFmtArgType_Unknown;
+    uint32_t prop_a = 0;
+    uint32_t prop_b = 0;
+    char fill_char = ' ';
+    MStrFmtAlign fmt_align = MStrFmtAlign_Right;
+    MStrFmtSignDisplay sign_display = MStrFmtSignDisplay_NegOnly;
+    int32_t width = -1;
+    int32_t precision = -1;
+    MStrFmtFormatType fmt_type = MStrFmtFormatType_UnSpec;
+    //! [Array] split chars
+    const char* split_beg = nullptr;
+    const char* split_end = nullptr;
+    //! 是否有日期时间的格式化描述
+    bool has_chrono = false;
+    //! 日期时间的格式化描述在表中的位置
+    std::size_t chrono_index = 0;
+};
+
+/**
+ * @brief 格式化串中的一段: 字面量 [beg, end) 或者replacement field
+ *
+ */
+struct compiled_fmt_segment
+{
+    const char* beg = nullptr;
+    const char* end = nullptr;
+    bool is_field = false;
+    std::size_t field_index = 0;
+};
+
+/**
+ * @brief 编译期解析好的格式化串
+ *
+ * @tparam S: 段数
+ * @tparam F: replacement field数
+ * @tparam C: 日期时间描述数
+ */
+template <std::size_t S, std::size_t F, std::size_t C>
+struct compiled_format
+{
+    compiled_fmt_segment segments[S == 0 ? 1 : S] = {};
+    compiled_fmt_field fields[F == 0 ? 1 : F] = {};
+    compiled_fmt_chrono chronos[C == 0 ? 1 : C] = {};
+};
+
+/**
+ * @brief 解析好的格式化串的大小
+ *
+ */
+struct compiled_format_size
+{
+    std::size_t segment_cnt;
+    std::size_t field_cnt;
+    std::size_t chrono_cnt;
+};
+
+/**
+ * @brief 格式化串不正确
+ *
+ * @note 非constexpr函数, 在编译期求值时调用它就会得到编译错误
+ */
+inline void invalid_format_string(mstr_result_t code)
+{
+    (void)code;
+}
+
+constexpr bool fmt_is_digit(char ch)
+{
+    return ch >= '0' && ch <= '9';
+}
+
+constexpr bool fmt_is_chrono_token(fmt_token_type type)
+{
+    return type >= fmt_token_type::chrono_predef_f &&
+           type <= fmt_token_type::chrono_week_name;
+}
+
+constexpr bool fmt_is_chrono_userdef_token(fmt_token_type type)
+{
+    return type >= fmt_token_type::chrono_year_1 &&
+           type <= fmt_token_type::chrono_week_name;
+}
+
+constexpr fmt_token fmt_make_token(
+    fmt_token_type type, std::size_t beg, std::size_t len
+)
+{
+    fmt_token token{};
+    token.type = type;
+    token.beg = beg;
+    token.len = len;
+    return token;
+}
+
+/**
+ * @brief lex: `:` 以及后面跟着的值类型
+ *
+ */
+constexpr fmt_token fmt_lex_colon(const char* s, std::size_t beg)
+{
+    using tt = fmt_token_type;
+    std::size_t p = beg + 1;
+    switch (s[p]) {
+    case 'i':
+    case 'u':
+    {
+        bool is_signed = s[p] == 'i';
+        if (s[p + 1] == '8') {
+            return fmt_make_token(
+                is_signed ? tt::type_int8 : tt::type_uint8, beg, 3
+            );
+        }
+        else if (s[p + 1] == '1' && s[p + 2] == '6') {
+            return fmt_make_token(
+                is_signed ? tt::type_int16 : tt::type_uint16, beg, 4
+            );
+        }
+        else if (s[p + 1] == '3' && s[p + 2] == '2') {
+            return fmt_make_token(
+                is_signed ? tt::type_int32 : tt::type_uint32, beg, 4
+            );
+        }
+        else {
+            // (roll back)
+            return fmt_make_token(tt::colon, beg, 1);
+        }
+    }
+    case 'q':
+        if (!fmt_is_digit(s[p + 1])) {
+            return fmt_make_token(tt::colon, beg, 1);
+        }
+        p += 1;
+        while (fmt_is_digit(s[p])) {
+            p += 1;
+        }
+        if (s[p] == 'u') {
+            return fmt_make_token(tt::type_uquant, beg, p + 1 - beg);
+        }
+        else {
+            return fmt_make_token(tt::type_iquant, beg, p - beg);
+        }
+    case 'F':
+        if (!fmt_is_digit(s[p + 1])) {
+            return fmt_make_token(tt::colon, beg, 1);
+        }
+        p += 1;
+        while (fmt_is_digit(s[p])) {
+            p += 1;
+        }
+        if (s[p] == '.') {
+            p += 1;
+            if (!fmt_is_digit(s[p])) {
+                return fmt_make_token(tt::error, beg, 0);
+            }
+            while (fmt_is_digit(s[p])) {
+                p += 1;
+            }
+        }
+        if (s[p] == 'u') {
+            return fmt_make_token(tt::type_ufixed, beg, p + 1 - beg);
+        }
+        else {
+            return fmt_make_token(tt::type_ifixed, beg, p - beg);
+        }
+#if _MSTR_USE_FP
+    case 'f': return fmt_make_token(tt::type_floating, beg, 2);
+#endif // _MSTR_USE_FP
+    case 's': return fmt_make_token(tt::type_cstring, beg, 2);
+    case 't': return fmt_make_token(tt::type_time, beg, 2);
+    case 'T': return fmt_make_token(tt::type_timestamp, beg, 2);
+    default: return fmt_make_token(tt::colon, beg, 1);
+    }
+}
+
+/**
+ * @brief lex: 重复n次的字符, 最多max次
+ *
+ */
+constexpr std::size_t fmt_lex_repeat(
+    const char* s, std::size_t p, char ch, std::size_t max
+)
+{
+    std::size_t n = 0;
+    while (n < max && s[p + n] == ch) {
+        n += 1;
+    }
+    return n;
+}
+
+/**
+ * @brief lex: `%` 开头的日期时间格式化描述
+ *
+ */
+constexpr fmt_token fmt_lex_chrono(const char* s, std::size_t beg)
+{
+    using tt = fmt_token_type;
+    const std::size_t p = beg + 1;
+    const char ch = s[p];
+    switch (ch) {
+    case '%': return fmt_make_token(tt::other_char, beg, 2);
+    case 'f': return fmt_make_token(tt::chrono_predef_f, beg, 2);
+    case 'g': return fmt_make_token(tt::chrono_predef_g, beg, 2);
+    case 'y':
+    {
+        const tt types[] = {
+            tt::chrono_year_1,
+            tt::chrono_year_fixed2,
+            tt::chrono_year_3,
+            tt::chrono_year_fixed4,
+        };
+        std::size_t n = fmt_lex_repeat(s, p, ch, 4);
+        return fmt_make_token(types[n - 1], beg, n + 1);
+    }
+    case 'x':
+    {
+        const tt types[] = {
+            tt::chrono_subsecond_fixed1,
+            tt::chrono_subsecond_fixed2,
+            tt::chrono_subsecond_fixed3,
+            tt::chrono_subsecond_fixed4,
+        };
+        std::size_t n = fmt_lex_repeat(s, p, ch, 4);
+        return fmt_make_token(types[n - 1], beg, n + 1);
+    }
+    case 'M':
+    case 'd':
+    case 'h':
+    case 'H':
+    case 'm':
+    case 's':
+    {
+        tt type = tt::error;
+        std::size_t n = fmt_lex_repeat(s, p, ch, 2);
+        switch (ch) {
+        case 'M': type = tt::chrono_month_1; break;
+        case 'd': type = tt::chrono_day_1; break;
+        case 'h': type = tt::chrono_hour_1; break;
+        case 'H': type = tt::chrono_hour24_1; break;
+        case 'm': type = tt::chrono_minute_1; break;
+        default: type = tt::chrono_second_1; break;
+        }
+        // XXX_1的下一个就是XXX_Fixed2
+        return fmt_make_token(
+            static_cast<tt>(static_cast<uint8_t>(type) + (n - 1)),
+            beg,
+            n + 1
+        );
+    }
+    case 'w': return fmt_make_token(tt::chrono_week_name, beg, 2);
+    case '>':
+    case '<':
+    case '=':
+        // 此类情况认为是fill align的部份, 识别成单个字符
+        return fmt_make_token(tt::other_char, beg, 1);
+    default: return fmt_make_token(tt::error, beg, 0);
+    }
+}
+
+/**
+ * @brief lex: 取得s[p]开始的token
+ *
+ */
+constexpr fmt_token fmt_lex(const char* s, std::size_t p, unsigned stage)
+{
+    using tt = fmt_token_type;
+    const char ch = s[p];
+    switch (ch) {
+    case '=': return fmt_make_token(tt::equ, p, 1);
+    case '>': return fmt_make_token(tt::gt, p, 1);
+    case '<': return fmt_make_token(tt::lt, p, 1);
+    case ':': return fmt_lex_colon(s, p);
+    case '{':
+        if (s[p + 1] == '[') {
+            return fmt_make_token(tt::left_brace_bracket, p, 2);
+        }
+        else if (s[p + 1] == '{') {
+            return fmt_make_token(tt::left_brace_brace, p, 2);
+        }
+        else {
+            return fmt_make_token(tt::left_brace, p, 1);
+        }
+    case '}':
+        // 如果parser想结束了, 那么优先匹配`}`
+        if ((stage & FMT_STAGE_NEED_END) == 0 && s[p + 1] == '}') {
+            return fmt_make_token(tt::right_brace_brace, p, 2);
+        }
+        else {
+            return fmt_make_token(tt::right_brace, p, 1);
+        }
+    case ']':
+        if (s[p + 1] == '}') {
+            return fmt_make_token(tt::right_bracket_brace, p, 2);
+        }
+        else {
+            return fmt_make_token(tt::other_char, p, 1);
+        }
+    case '|':
+        if (s[p + 1] == ':') {
+            return fmt_make_token(tt::vline_colon, p, 2);
+        }
+        else {
+            return fmt_make_token(tt::other_char, p, 1);
+        }
+    case '\0': return fmt_make_token(tt::eof, p, 1);
+    case '%':
+        if ((stage & FMT_STAGE_MATCH_CHRONO) != 0) {
+            return fmt_lex_chrono(s, p);
+        }
+        else {
+            return fmt_make_token(tt::other_char, p, 1);
+        }
+    default:
+        if (fmt_is_digit(ch)) {
+            std::size_t end = p + 1;
+            while (fmt_is_digit(s[end])) {
+                end += 1;
+            }
+            return fmt_make_token(tt::digits, p, end - p);
+        }
+        else {
+            return fmt_make_token(tt::other_char, p, 1);
+        }
+    }
+}
+
+/**
+ * @brief 编译期的parser, 对应 mm_parser.c 中的各个parse_XXX
+ *
+ */
+class fmt_constexpr_parser
+{
+    using tt = fmt_token_type;
+
+public:
+    //! 格式化串
+    const char* fmt;
+
+    //! 当前读取位置
+    std::size_t current;
+
+    //! parser进行的stage, 指示lex应该怎么做
+    unsigned stage;
+
+    //! 当前Token
+    fmt_token token;
+
+    constexpr fmt_constexpr_parser(const char* fmt_str, std::size_t pos)
+        : fmt(fmt_str), current(pos), stage(0), token()
+    {
+    }
+
+    /**
+     * @brief 解析 replacement field
+     *
+     */
+    constexpr mstr_result_t parse_goal(
+        compiled_fmt_field& field, compiled_fmt_chrono& chrono
+    )
+    {
+        mstr_result_t result = next_token();
+        if (result != MStr_Ok) {
+            return result;
+        }
+        if (token.type == tt::left_brace_brace) {
+            field.arg_class = MStrFmtArgClass_EscapeChar;
+            field.escape_char = '{';
+        }
+        else if (token.type == tt::right_brace_brace) {
+            field.arg_class = MStrFmtArgClass_EscapeChar;
+            field.escape_char = '}';
+        }
+        else {
+            result = parse_replacement_field(field, chrono);
+        }
+        return result;
+    }
+
+private:
+    constexpr mstr_result_t next_token()
+    {
+        token = fmt_lex(fmt, current, stage);
+        if (token.type == tt::error) {
+            return MStr_Err_UnrecognizedToken;
+        }
+        current += token.len;
+        return MStr_Ok;
+    }
+
+    constexpr mstr_result_t parse_one_token(
+        tt type, mstr_result_t or_else
+    )
+    {
+        return token.type != type ? or_else : next_token();
+    }
+
+    constexpr mstr_result_t parse_replacement_field(
+        compiled_fmt_field& field, compiled_fmt_chrono& chrono
+    )
+    {
+        mstr_result_t result = MStr_Ok;
+        tt end_token = tt::right_brace;
+        if (token.type == tt::left_brace) {
+            field.arg_class = MStrFmtArgClass_Value;
+            result = parse_one_token(
+                tt::left_brace, MStr_Err_MissingReplacement
+            );
+            if (result == MStr_Ok) {
+                // simple_field
+                stage |= FMT_STAGE_NEED_END;
+                result = parse_field(field, chrono);
+                stage &= ~FMT_STAGE_NEED_END;
+            }
+        }
+        else if (token.type == tt::left_brace_bracket) {
+            field.arg_class = MStrFmtArgClass_Array;
+            end_token = tt::right_bracket_brace;
+            result = parse_one_token(
+                tt::left_brace_bracket, MStr_Err_MissingReplacement
+            );
+            if (result == MStr_Ok) {
+                // array_field
+                result = parse_field(field, chrono);
+            }
+        }
+        else {
+            return MStr_Err_MissingReplacement;
+        }
+        // 闭合: `}` 或者 `]}`, 它已经是读过的token了
+        if (result == MStr_Ok && token.type != end_token) {
+            result = MStr_Err_MissingRightBrace;
+        }
+        return result;
+    }
+
+    constexpr mstr_result_t parse_field(
+        compiled_fmt_field& field, compiled_fmt_chrono& chrono
+    )
+    {
+        mstr_result_t result = parse_arg_id(field);
+        if (result == MStr_Ok) {
+            result = parse_arg_type(field);
+        }
+        if (result == MStr_Ok &&
+            field.arg_class == MStrFmtArgClass_Array) {
+            result = parse_opt_split_chars(field);
+        }
+        if (result == MStr_Ok) {
+            stage |= FMT_STAGE_MATCH_CHRONO;
+            result = parse_opt_formatfield_spec(field, chrono);
+            stage &= ~FMT_STAGE_MATCH_CHRONO;
+        }
+        return result;
+    }
+
+    constexpr mstr_result_t parse_arg_id(compiled_fmt_field& field)
+    {
+        if (token.type != tt::digits) {
+            return MStr_Err_MissingArgumentID;
+        }
+        field.id = atou(token.beg, token.len);
+        return next_token();
+    }
+
+    constexpr mstr_result_t parse_arg_type(compiled_fmt_field& field)
+    {
+        MStrFmtArgType type = MStrFmtArgType_Unknown;
+        switch (token.type) {
+        case tt::type_int8: type = MStrFmtArgType_Int8; break;
+        case tt::type_int16: type = MStrFmtArgType_Int16; break;
+        case tt::type_int32: type = MStrFmtArgType_Int32; break;
+        case tt::type_uint8: type = MStrFmtArgType_Uint8; break;
+        case tt::type_uint16: type = MStrFmtArgType_Uint16; break;
+        case tt::type_uint32: type = MStrFmtArgType_Uint32; break;
+        case tt::type_cstring: type = MStrFmtArgType_CString; break;
+        case tt::type_time: type = MStrFmtArgType_Time; break;
+        case tt::type_timestamp: type = MStrFmtArgType_Timestamp; break;
+        case tt::type_iquant:
+            parse_arg_get_fixed_props(field);
+            // 超过31位的量化值需要64位的值
+            type = field.prop_a > 31 ? MStrFmtArgType_QuantizedValue64
+                                     : MStrFmtArgType_QuantizedValue;
+            break;
+        case tt::type_uquant:
+            parse_arg_get_fixed_props(field);
+            type = field.prop_a > 31
+                       ? MStrFmtArgType_QuantizedUnsignedValue64
+                       : MStrFmtArgType_QuantizedUnsignedValue;
+            break;
+        case tt::type_ifixed:
+            type = MStrFmtArgType_FixedValue;
+            parse_arg_get_fixed_props(field);
+            break;
+        case tt::type_ufixed:
+            type = MStrFmtArgType_FixedUnsignedValue;
+            parse_arg_get_fixed_props(field);
+            break;
+        default: return MStr_Err_MissingArgumentType;
+        }
+        field.typ = type;
+        return next_token();
+    }
+
+    constexpr void parse_arg_get_fixed_props(compiled_fmt_field& field)
+    {
+        // 跳过 `:` `q` 或者 `:` `F`
+        const std::size_t beg = token.beg + 2;
+        const std::size_t end = token.beg + token.len;
+        std::size_t p = beg;
+        while (p < end && fmt_is_digit(fmt[p])) {
+            p += 1;
+        }
+        field.prop_a = atou(beg, p - beg);
+        field.prop_b = 0;
+        if (p < end && fmt[p] == '.') {
+            // 定点数的小数部分位数
+            const std::size_t dbeg = p + 1;
+            p = dbeg;
+            while (p < end && fmt_is_digit(fmt[p])) {
+                p += 1;
+            }
+            field.prop_b = atou(dbeg, p - dbeg);
+        }
+    }
+
+    constexpr mstr_result_t parse_opt_split_chars(
+        compiled_fmt_field& field
+    )
+    {
+        mstr_result_t result = MStr_Ok;
+        if (token.type != tt::vline_colon) {
+            // 给定默认值
+            const char* default_split = ", ";
+            field.split_beg = default_split;
+            field.split_end = default_split + 2;
+            return MStr_Ok;
+        }
+        result = next_token();
+        field.split_beg = fmt + token.beg;
+        while (result == MStr_Ok && token.type != tt::colon &&
+               token.type != tt::right_brace &&
+               token.type != tt::right_bracket_brace) {
+            if (token.type == tt::eof) {
+                return MStr_Err_MissingRightBrace;
+            }
+            result = next_token();
+        }
+        field.split_end = fmt + token.beg;
+        return result;
+    }
+
+    constexpr mstr_result_t parse_opt_formatfield_spec(
+        compiled_fmt_field& field, compiled_fmt_chrono& chrono
+    )
+    {
+        mstr_result_t result = MStr_Ok;
+        if (token.type != tt::colon) {
+            return MStr_Ok;
+        }
+        result = next_token();
+        // 可选的: fill char, align, fmt type, sign
+        if (result == MStr_Ok) {
+            result = parse_opt_items(field, chrono);
+        }
+        if (result == MStr_Ok &&
+            field.fmt_type == MStrFmtFormatType_UnSpec) {
+            result = parse_opt_sign(field);
+            if (result == MStr_Ok) {
+                result = parse_opt_width(field);
+            }
+            if (result == MStr_Ok) {
+                result = parse_opt_precision(field);
+            }
+            if (result == MStr_Ok) {
+                result = parse_opt_format_chrono_spec(field, chrono);
+            }
+        }
+        return result;
+    }
+
+    constexpr mstr_result_t parse_opt_items(
+        compiled_fmt_field& field, compiled_fmt_chrono& chrono
+    )
+    {
+        switch (token.type) {
+        case tt::lt:
+        case tt::gt:
+        case tt::equ: return parse_align(field);
+        case tt::colon:
+        case tt::digits:
+        case tt::left_brace:
+        case tt::other_char:
+        {
+            // 这里存在着非LL(1)的情况:
+            // 必须知道next token才能得到当前到底是fill char还是format_type
+            fmt_token next = fmt_lex(fmt, current, stage);
+            const char ch = fmt[token.beg];
+            if (next.type == tt::error) {
+                return MStr_Err_UnrecognizedToken;
+            }
+            else if (next.type == tt::lt || next.type == tt::gt ||
+                     next.type == tt::equ) {
+                mstr_result_t result = MStr_Ok;
+                field.fill_char = ch;
+                result = next_token();
+                return result == MStr_Ok ? parse_align(field) : result;
+            }
+            else if (token.type == tt::other_char && ch == '.') {
+                // precision, 后面再解析
+                return MStr_Ok;
+            }
+            else if (token.type == tt::other_char &&
+                     (ch == ' ' || ch == '+' || ch == '-')) {
+                // 优先匹配sign
+                return parse_opt_sign(field);
+            }
+            else {
+                return parse_opt_format_chrono_spec(field, chrono);
+            }
+        }
+        default:
+            field.fill_char = ' ';
+            field.fmt_align = MStrFmtAlign_Left;
+            return MStr_Ok;
+        }
+    }
+
+    constexpr mstr_result_t parse_align(compiled_fmt_field& field)
+    {
+        switch (token.type) {
+        case tt::lt: field.fmt_align = MStrFmtAlign_Left; break;
+        case tt::gt: field.fmt_align = MStrFmtAlign_Right; break;
+        case tt::equ: field.fmt_align = MStrFmtAlign_Center; break;
+        default: return MStr_Err_MissingAlignAfterFillChar;
+        }
+        return next_token();
+    }
+
+    constexpr mstr_result_t parse_opt_sign(compiled_fmt_field& field)
+    {
+        if (token.type != tt::other_char) {
+            return MStr_Ok;
+        }
+        switch (fmt[token.beg]) {
+        case '+': field.sign_display = MStrFmtSignDisplay_Always; break;
+        case '-': field.sign_display = MStrFmtSignDisplay_NegOnly; break;
+        case ' ':
+            field.sign_display = MStrFmtSignDisplay_Neg_Or_Space;
+            break;
+        default: return MStr_Ok;
+        }
+        return next_token();
+    }
+
+    constexpr mstr_result_t parse_opt_width(compiled_fmt_field& field)
+    {
+        if (token.type != tt::digits) {
+            return MStr_Ok;
+        }
+        uint32_t width = atou(token.beg, token.len);
+        if (width >= MFMT_PLACE_MAX_WIDTH) {
+            return MStr_Err_WidthTooLarge;
+        }
+        field.width = static_cast<int32_t>(width);
+        return next_token();
+    }
+
+    constexpr mstr_result_t parse_opt_precision(
+        compiled_fmt_field& field
+    )
+    {
+        if (token.type != tt::other_char || fmt[token.beg] != '.') {
+            return MStr_Ok;
+        }
+        mstr_result_t result = next_token();
+        if (result != MStr_Ok) {
+            return result;
+        }
+        if (token.type != tt::digits) {
+            return MStr_Err_UnsupportFormatType;
+        }
+        uint32_t precision = atou(token.beg, token.len);
+        if (precision >= MFMT_PLACE_MAX_PRECISION) {
+            return MStr_Err_PrecisionTooLarge;
+        }
+        field.precision = static_cast<int32_t>(precision);
+        return next_token();
+    }
+
+    constexpr mstr_result_t parse_opt_format_chrono_spec(
+        compiled_fmt_field& field, compiled_fmt_chrono& chrono
+    )
+    {
+        if (token.type == tt::other_char) {
+            return parse_format_spec(field);
+        }
+        else if (fmt_is_chrono_token(token.type)) {
+            field.has_chrono = true;
+            return parse_chrono_spec(chrono);
+        }
+        else {
+            return MStr_Ok;
+        }
+    }
+
+    constexpr mstr_result_t parse_format_spec(compiled_fmt_field& field)
+    {
+        switch (fmt[token.beg]) {
+        case 'b': field.fmt_type = MStrFmtFormatType_Binary; break;
+        case 'd': field.fmt_type = MStrFmtFormatType_Deciaml; break;
+        case 'o': field.fmt_type = MStrFmtFormatType_Oct; break;
+        case 'h': field.fmt_type = MStrFmtFormatType_Hex; break;
+        case 'H': field.fmt_type = MStrFmtFormatType_Hex_UpperCase; break;
+        case 'x': field.fmt_type = MStrFmtFormatType_Hex_WithPrefix; break;
+        case 'X':
+            field.fmt_type = MStrFmtFormatType_Hex_UpperCase_WithPrefix;
+            break;
+        case 'y': field.fmt_type = MStrFmtFormatType_HexBytes; break;
+        case 'Y':
+            field.fmt_type = MStrFmtFormatType_HexBytes_UpperCase;
+            break;
+        case 'D': field.fmt_type = MStrFmtFormatType_HexDump; break;
+        default: return MStr_Err_UnsupportFormatType;
+        }
+        mstr_result_t result = next_token();
+        if (result == MStr_Ok &&
+            field.fmt_type == MStrFmtFormatType_Binary &&
+            token.type == tt::digits) {
+            // `b64`, `b32`
+            switch (atou(token.beg, token.len)) {
+            case 64: field.fmt_type = MStrFmtFormatType_Base64; break;
+            case 32: field.fmt_type = MStrFmtFormatType_Base32; break;
+            default: return MStr_Err_UnsupportFormatType;
+            }
+            result = next_token();
+        }
+        return result;
+    }
+
+    constexpr mstr_result_t parse_chrono_spec(compiled_fmt_chrono& chrono)
+    {
+        mstr_result_t result = MStr_Ok;
+        std::size_t index = 0;
+        if (token.type == tt::chrono_predef_f ||
+            token.type == tt::chrono_predef_g) {
+            const char* date_split = "-";
+            const char* time_split = ":";
+            const char* item_split = " ";
+            const char* subsec_split = ".";
+            set_chrono_item(
+                chrono.items[0],
+                MStrFmtChronoValueType_Year,
+                4,
+                date_split
+            );
+            set_chrono_item(
+                chrono.items[1],
+                MStrFmtChronoValueType_Month,
+                2,
+                date_split
+            );
+            set_chrono_item(
+                chrono.items[2], MStrFmtChronoValueType_Day, 2, item_split
+            );
+            set_chrono_item(
+                chrono.items[3],
+                MStrFmtChronoValueType_Hour24,
+                2,
+                time_split
+            );
+            set_chrono_item(
+                chrono.items[4],
+                MStrFmtChronoValueType_Minute,
+                2,
+                time_split
+            );
+            set_chrono_item(
+                chrono.items[5],
+                MStrFmtChronoValueType_Second,
+                2,
+                subsec_split
+            );
+            if (token.type == tt::chrono_predef_f) {
+                // 携带星期
+                set_chrono_item(
+                    chrono.items[6],
+                    MStrFmtChronoValueType_SubSecond,
+                    4,
+                    item_split
+                );
+                set_chrono_item(
+                    chrono.items[7],
+                    MStrFmtChronoValueType_Week,
+                    0,
+                    nullptr
+                );
+                chrono.items[7].fixed_length = false;
+                chrono.item_cnt = 8;
+            }
+            else {
+                set_chrono_item(
+                    chrono.items[6],
+                    MStrFmtChronoValueType_SubSecond,
+                    4,
+                    nullptr
+                );
+                chrono.item_cnt = 7;
+            }
+            return next_token();
+        }
+        // 其余情况当成用户自定义的格式化内容
+        while (result == MStr_Ok) {
+            if (index >= MFMT_CHRONO_PLACE_MAX_NUM) {
+                result = MStr_Err_TooMoreChronoItem;
+                break;
+            }
+            result = parse_chrono_spec_item(chrono.items[index]);
+            index += 1;
+            if (result == MStr_Ok && !fmt_is_chrono_token(token.type)) {
+                break;
+            }
+        }
+        chrono.item_cnt = index;
+        return result;
+    }
+
+    constexpr void set_chrono_item(
+        compiled_fmt_chrono_item& item,
+        MStrFmtChronoValueType type,
+        uint8_t length,
+        const char* split
+    )
+    {
+        item.value_type = type;
+        item.fixed_length = true;
+        item.format_length = length;
+        item.split_beg = split;
+        item.split_end = split == nullptr ? nullptr : split + 1;
+    }
+
+    constexpr mstr_result_t parse_chrono_spec_item(
+        compiled_fmt_chrono_item& item
+    )
+    {
+        mstr_result_t result = MStr_Ok;
+        if (!fmt_is_chrono_userdef_token(token.type)) {
+            return MStr_Err_MissingChronoItemType;
+        }
+        switch (token.type) {
+        case tt::chrono_year_1:
+        case tt::chrono_year_fixed2:
+        case tt::chrono_year_3:
+        case tt::chrono_year_fixed4:
+        {
+            uint8_t length = static_cast<uint8_t>(
+                static_cast<uint8_t>(token.type) -
+                static_cast<uint8_t>(tt::chrono_year_1) + 1
+            );
+            item.value_type = MStrFmtChronoValueType_Year;
+            item.fixed_length = length == 2 || length == 4;
+            item.format_length = length;
+            break;
+        }
+        case tt::chrono_subsecond_fixed1:
+        case tt::chrono_subsecond_fixed2:
+        case tt::chrono_subsecond_fixed3:
+        case tt::chrono_subsecond_fixed4:
+            item.value_type = MStrFmtChronoValueType_SubSecond;
+            item.fixed_length = true;
+            item.format_length = static_cast<uint8_t>(
+                static_cast<uint8_t>(token.type) -
+                static_cast<uint8_t>(tt::chrono_subsecond_fixed1) + 1
+            );
+            break;
+        case tt::chrono_week_name:
+            item.value_type = MStrFmtChronoValueType_Week;
+            item.fixed_length = false;
+            item.format_length = 0;
+            break;
+        default:
+        {
+            // XXX_1, XXX_Fixed2
+            const MStrFmtChronoValueType types[] = {
+                MStrFmtChronoValueType_Month,
+                MStrFmtChronoValueType_Day,
+                MStrFmtChronoValueType_Hour,
+                MStrFmtChronoValueType_Hour24,
+                MStrFmtChronoValueType_Minute,
+                MStrFmtChronoValueType_Second,
+            };
+            std::size_t offset = static_cast<std::size_t>(
+                static_cast<uint8_t>(token.type) -
+                static_cast<uint8_t>(tt::chrono_month_1)
+            );
+            item.value_type = types[offset / 2];
+            item.fixed_length = offset % 2 == 1;
+            item.format_length = static_cast<uint8_t>(offset % 2 + 1);
+            break;
+        }
+        }
+        result = next_token();
+        // 解析可选的分隔符
+        item.split_beg = fmt + token.beg;
+        item.split_end = item.split_beg;
+        while (result == MStr_Ok && !fmt_is_chrono_token(token.type) &&
+               token.type != tt::right_bracket_brace &&
+               token.type != tt::right_brace &&
+               token.type != tt::eof) {
+            result = next_token();
+            item.split_end = fmt + token.beg;
+        }
+        return result;
+    }
+
+    constexpr uint32_t atou(std::size_t beg, std::size_t len) const
+    {
+        uint32_t r = 0;
+        for (std::size_t i = 0; i < len; i += 1) {
+            r = r * 10 + static_cast<uint32_t>(fmt[beg + i] - '0');
+        }
+        return r;
+    }
+};
+
+/**
+ * @brief 遍历格式化串, 把字面量和replacement field交给sink
+ *
+ */
+template <typename Sink>
+constexpr mstr_result_t fmt_compile_walk(const char* fmt, Sink& sink)
+{
+    mstr_result_t result = MStr_Ok;
+    std::size_t pos = 0;
+    while (fmt[pos] != '\0' && result == MStr_Ok) {
+        if (fmt[pos] != '{' && fmt[pos] != '}') {
+            // 非格式化内容, 整段copy走
+            const std::size_t beg = pos;
+            while (fmt[pos] != '\0' && fmt[pos] != '{' &&
+                   fmt[pos] != '}') {
+                pos += 1;
+            }
+            sink.literal(fmt + beg, fmt + pos);
+        }
+        else {
+            compiled_fmt_field field{};
+            compiled_fmt_chrono chrono{};
+            fmt_constexpr_parser parser(fmt, pos);
+            result = parser.parse_goal(field, chrono);
+            if (result == MStr_Ok) {
+                if (field.arg_class == MStrFmtArgClass_EscapeChar) {
+                    // `{{` 或者 `}}` 取第一个字符就好
+                    sink.literal(fmt + pos, fmt + pos + 1);
+                }
+                else {
+                    sink.field(field, chrono);
+                }
+                pos = parser.current;
+            }
+        }
+    }
+    return result;
 }
+
+/**
+ * @brief 计算段数的sink
+ *
+ */
+struct fmt_compile_counter
+{
+    compiled_format_size size = {0, 0, 0};
+    const char* last_literal_end = nullptr;
+
+    constexpr void literal(const char* beg, const char* end)
+    {
+        // 相邻的字面量合并成一段
+        if (last_literal_end == nullptr || last_literal_end != beg) {
+            size.segment_cnt += 1;
+        }
+        last_literal_end = end;
+    }
+
+    constexpr void field(
+        const compiled_fmt_field& field, const compiled_fmt_chrono&
+    )
+    {
+        size.segment_cnt += 1;
+        size.field_cnt += 1;
+        size.chrono_cnt += field.has_chrono ? 1 : 0;
+        last_literal_end = nullptr;
+    }
+};
+
+/**
+ * @brief 填充compiled_format的sink
+ *
+ */
+template <std::size_t S, std::size_t F, std::size_t C>
+struct fmt_compile_builder
+{
+    compiled_format<S, F, C>& out;
+    compiled_format_size size;
+    const char* last_literal_end;
+
+    constexpr explicit fmt_compile_builder(compiled_format<S, F, C>& o)
+        : out(o), size{0, 0, 0}, last_literal_end(nullptr)
+    {
+    }
+
+    constexpr void literal(const char* beg, const char* end)
+    {
+        if (last_literal_end != nullptr && last_literal_end == beg) {
+            out.segments[size.segment_cnt - 1].end = end;
+        }
+        else {
+            out.segments[size.segment_cnt].beg = beg;
+            out.segments[size.segment_cnt].end = end;
+            out.segments[size.segment_cnt].is_field = false;
+            size.segment_cnt += 1;
+        }
+        last_literal_end = end;
+    }
+
+    constexpr void field(
+        const compiled_fmt_field& field, const compiled_fmt_chrono& chrono
+    )
+    {
+        out.fields[size.field_cnt] = field;
+        if (field.has_chrono) {
+            out.chronos[size.chrono_cnt] = chrono;
+            out.fields[size.field_cnt].chrono_index = size.chrono_cnt;
+            size.chrono_cnt += 1;
+        }
+        out.segments[size.segment_cnt].is_field = true;
+        out.segments[size.segment_cnt].field_index = size.field_cnt;
+        size.segment_cnt += 1;
+        size.field_cnt += 1;
+        last_literal_end = nullptr;
+    }
+};
+
+/**
+ * @brief 计算格式化串解析后的大小
+ *
+ */
+template <std::size_t N>
+constexpr compiled_format_size compiled_format_size_of(
+    const char (&fmt)[N]
+)
+{
+    fmt_compile_counter counter{};
+    mstr_result_t result = fmt_compile_walk(fmt, counter);
+    if (result != MStr_Ok) {
+        invalid_format_string(result);
+    }
+    return counter.size;
+}
+
+/**
+ * @brief 解析格式化串
+ *
+ * @attention 应该在constexpr的上下文中使用, 参考 MSTR_COMPILE_FORMAT
+ */
+template <std::size_t S, std::size_t F, std::size_t C, std::size_t N>
+constexpr compiled_format<S, F, C> compile_format(const char (&fmt)[N])
+{
+    compiled_format<S, F, C> compiled{};
+    fmt_compile_builder<S, F, C> builder(compiled);
+    mstr_result_t result = fmt_compile_walk(fmt, builder);
+    if (result != MStr_Ok) {
+        invalid_format_string(result);
+    }
+    return compiled;
+}
+
+/**
+ * @brief 转换为 mm_fmt.c 使用的解析结果
+ *
+ */
+inline void fmt_compiled_parse_result(
+    MStrFmtParseResult* parser_result,
+    const compiled_fmt_field& field,
+    const compiled_fmt_chrono* chronos
+)
+{
+    MStrFmtFormatDescript* spec = nullptr;
+    parser_result->arg_class = field.arg_class;
+    if (field.arg_class == MStrFmtArgClass_Array) {
+        MStrFmtParseResultArrayResult* arr = &parser_result->val.arr;
+        arr->id = field.id;
+        arr->ele_typ = field.typ;
+        arr->ele_prop.a = field.prop_a;
+        arr->ele_prop.b = field.prop_b;
+        arr->split_beg = field.split_beg;
+        arr->split_end = field.split_end;
+        spec = &arr->spec;
+    }
+    else {
+        MStrFmtParseResultValueResult* val = &parser_result->val.val;
+        val->id = field.id;
+        val->typ = field.typ;
+        val->prop.a = field.prop_a;
+        val->prop.b = field.prop_b;
+        spec = &val->spec;
+    }
+    spec->fill_char = field.fill_char;
+    spec->fmt_align = field.fmt_align;
+    spec->sign_display = field.sign_display;
+    spec->width = field.width;
+    spec->precision = field.precision;
+    spec->fmt_spec.fmt_type = field.fmt_type;
+    if (field.has_chrono) {
+        const compiled_fmt_chrono& chrono = chronos[field.chrono_index];
+        MStrFmtChronoFormatSpec* chrono_spec = &spec->fmt_spec.spec.chrono;
+        for (std::size_t i = 0; i < chrono.item_cnt; i += 1) {
+            const compiled_fmt_chrono_item& src = chrono.items[i];
+            MStrFmtChronoItemFormatSpec* dst = &chrono_spec->items[i];
+            dst->value_type = src.value_type;
+            dst->chrono_spec.fixed_length = src.fixed_length ? True : False;
+            dst->chrono_spec.format_length = src.format_length;
+            dst->split_beg = src.split_beg;
+            dst->split_end = src.split_end;
+        }
+        chrono_spec->item_cnt = chrono.item_cnt;
+    }
+    else {
+        spec->fmt_spec.spec.chrono.item_cnt = 0;
+    }
+}
+
+/**
+ * @brief 按照解析好的格式化串进行格式化
+ *
+ * @note 字面量整段copy, replacement field直接交给
+ * mstr_context_format_field, 不再经过parser
+ */
+template <std::size_t S, std::size_t F, std::size_t C>
+mstr_result_t fmt_compiled_format(
+    MString* res_str,
+    const compiled_format<S, F, C>& fmt,
+    const MStrFmtFormatArgument* args,
+    usize_t arg_cnt
+)
+{
+    mstr_result_t result = MStr_Ok;
+    MStrFmtArgsContext ctx = {};
+    ctx.p_args = args;
+    ctx.max_place = arg_cnt;
+    for (std::size_t i = 0; i < S && MSTR_SUCC(result); i += 1) {
+        const compiled_fmt_segment& seg = fmt.segments[i];
+        if (seg.is_field) {
+            MStrFmtParseResult parser_result;
+            fmt_compiled_parse_result(
+                &parser_result, fmt.fields[seg.field_index], fmt.chronos
+            );
+            result =
+                mstr_context_format_field(res_str, &parser_result, &ctx);
+        }
+        else {
+            result = mstr_concat_cstr_slice(res_str, seg.beg, seg.end);
+        }
+    }
+    return result;
+}
+#endif // _MSTR_USE_CONSTEXPR_PARSER
+} // namespace details
 } // namespace mtfmt
+
+#if _MSTR_USE_CONSTEXPR_PARSER
+/**
+ * @brief 在编译期解析格式化串, 得到一个静态的表
+ *
+ * @note 格式化串不正确的时候会得到编译错误
+ * (call to non-constexpr function invalid_format_string)
+ *
+ */
+#define MSTR_COMPILE_FORMAT(fmt_str)                                 \
+    ([]() -> const auto& {                                           \
+        static constexpr auto compiled_fmt =                         \
+            ::mtfmt::details::compile_format<                        \
+                ::mtfmt::details::compiled_format_size_of(fmt_str)   \
+                    .segment_cnt,                                    \
+                ::mtfmt::details::compiled_format_size_of(fmt_str)   \
+                    .field_cnt,                                      \
+                ::mtfmt::details::compiled_format_size_of(fmt_str)   \
+                    .chrono_cnt>(fmt_str);                           \
+        return compiled_fmt;                                         \
+    }())
+#endif // _MSTR_USE_CONSTEXPR_PARSER
 #endif // _INCLUDE_MM_PARSER_HPP_
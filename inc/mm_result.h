@@ -75,6 +75,16 @@ typedef enum tagMStrResult
     MStr_Err_UnsupportType,
     // ERR: 格式化: 不支持的量化精度
     MStr_Err_UnsupportQuantBits,
+    // ERR: 格式化: Parser错误: 请求的小数位数太多
+    MStr_Err_PrecisionTooLarge,
+    // ERR: 格式化: 时间戳超出可以表示的范围
+    MStr_Err_TimestampOutOfRange,
+    // ERR: 解析: 不是有效的数值
+    MStr_Err_InvalidNumber,
+    // ERR: 解析: 数值超出范围
+    MStr_Err_NumberOutOfRange,
+    // ERR: 解析: 输入和模板不一致
+    MStr_Err_InputMismatch,
     // ERR: 最后一个的flag
     MStr_Err_Flag_LastOne,
 } mstr_result_t;
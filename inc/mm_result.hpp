@@ -104,6 +104,16 @@ public:
         unsafe_set_succ_value(succ_val);
     }
 
+    /**
+     * @brief 从succ value构造(移动)
+     *
+     */
+    result_non_trivial_base(T&& succ_val)
+        : dtor(dtor_succ_type), type_tag(TypeTag::SuccTag)
+    {
+        unsafe_move_succ_value(std::move(succ_val));
+    }
+
     /**
      * @brief 从err value构造
      *
@@ -118,20 +128,36 @@ public:
         : type_tag(rhs.type_tag)
     {
         if (type_tag == TypeTag::SuccTag) {
-            const T& value = *reinterpret_cast<const T*>(&storager);
+            const T& value = *reinterpret_cast<const T*>(&rhs.storager);
             unsafe_set_succ_value(value);
             // 更新析构
             dtor = dtor_succ_type;
         }
         else {
             mstr_assert(type_tag == TypeTag::ErrorTag);
-            const E& value = *reinterpret_cast<const E*>(&storager);
+            const E& value = *reinterpret_cast<const E*>(&rhs.storager);
             unsafe_set_err_value(value);
             // 更新析构
             dtor = dtor_err_type;
         }
     }
 
+    result_non_trivial_base(result_non_trivial_base&& rhs)
+        : type_tag(rhs.type_tag)
+    {
+        if (type_tag == TypeTag::SuccTag) {
+            T& value = *reinterpret_cast<T*>(&rhs.storager);
+            unsafe_move_succ_value(std::move(value));
+            dtor = dtor_succ_type;
+        }
+        else {
+            mstr_assert(type_tag == TypeTag::ErrorTag);
+            const E& value = *reinterpret_cast<const E*>(&rhs.storager);
+            unsafe_set_err_value(value);
+            dtor = dtor_err_type;
+        }
+    }
+
     result_non_trivial_base& operator=(
         const result_non_trivial_base& rhs
     )
@@ -153,6 +179,26 @@ public:
         return *this;
     }
 
+    result_non_trivial_base& operator=(result_non_trivial_base&& rhs)
+    {
+        if (this == &rhs) {
+            return *this;
+        }
+        this->~result_non_trivial_base();
+        if (rhs.type_tag == TypeTag::SuccTag) {
+            T& value = *reinterpret_cast<T*>(&rhs.storager);
+            unsafe_move_succ_value(std::move(value));
+            dtor = dtor_succ_type;
+        }
+        else {
+            mstr_assert(rhs.type_tag == TypeTag::ErrorTag);
+            const E& value = *reinterpret_cast<const E*>(&rhs.storager);
+            unsafe_set_err_value(value);
+            dtor = dtor_err_type;
+        }
+        return *this;
+    }
+
     ~result_non_trivial_base()
     {
         mstr_assert(dtor != nullptr);
@@ -223,6 +269,13 @@ private:
         new (ptr) T(value);
     }
 
+    void unsafe_move_succ_value(T&& value) noexcept
+    {
+        type_tag = TypeTag::SuccTag;
+        void* ptr = reinterpret_cast<void*>(&storager);
+        new (ptr) T(std::move(value));
+    }
+
     enable_if_t<std::is_copy_constructible<E>::value, void>
         unsafe_set_err_value(const E& value) noexcept
     {
@@ -0,0 +1,394 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    mm_scan.h
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   字符串到数值的转换
+ * @version 1.0
+ * @date    2023-08-20
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ * @note 所有的函数都不依赖locale, 也不会跳过空白字符.
+ * 字符串使用[beg, end)表示, 不需要以'\0'结尾.
+ *
+ * 如果stop不为NULL, 则转换字符串中最长的有效前缀,
+ * 成功时把stop设置为转换结束的位置;
+ * 如果stop为NULL, 则要求整个字符串都是有效的数值.
+ *
+ * 转换失败时不会修改value和stop
+ */
+#if !defined(_INCLUDE_MM_SCAN_H_)
+#define _INCLUDE_MM_SCAN_H_ 1
+#include "mm_cfg.h"
+#include "mm_fmt.h"
+#include "mm_result.h"
+#include "mm_type.h"
+
+//! 扫描模板最多支持的项数
+#define MFMT_SCAN_ITEM_MAX_NUM 32
+
+/**
+ * @brief 扫描模板的一个项
+ *
+ * @note 一个项是一段字面量或者一个replacement field
+ */
+typedef struct tagMStrScanItem
+{
+    //! 需要匹配的字面量, 引用自fmt, [beg, end)
+    const char* literal_beg;
+
+    //! 字面量的结束位置
+    const char* literal_end;
+
+    //! 参数类型, MStrFmtArgType_Unknown表示没有值
+    MStrFmtArgType typ;
+
+    //! 参数位置
+    uint32_t id;
+
+    //! 附带参数
+    MStrFmtArgProperty prop;
+
+    //! [整数] 进制
+    MStrFmtIntIndex index;
+
+    //! 项宽度, -1表示不限制
+    int32_t width;
+
+    //! 填充字符
+    char fill_char;
+
+    //! 对齐方式, 决定从哪一侧去掉填充字符
+    MStrFmtAlign align;
+
+    //! [字符串] 结束的字符, 为'\0'表示读取到输入的末尾
+    char until;
+} MStrScanItem;
+
+/**
+ * @brief 已经解析过的扫描模板
+ *
+ * @note 模板中的字面量引用自fmt, fmt需要比模板活得更久
+ */
+typedef struct tagMStrScanTemplate
+{
+    //! 模板的项
+    MStrScanItem items[MFMT_SCAN_ITEM_MAX_NUM];
+
+    //! 项数
+    usize_t item_cnt;
+} MStrScanTemplate;
+
+/**
+ * @brief 将字符串转换为有符号整数
+ *
+ * @param[out] value: 转换结果
+ * @param[in] beg: 字符串的开始
+ * @param[in] end: 字符串的结束
+ * @param[in] index: Index, 十六进制不区分大小写,
+ * 带前缀的Index要求有"0x"或者"0X"前缀
+ * @param[out] stop: 转换结束的位置, 可以为NULL
+ *
+ * @return mstr_result_t: 不是有效的数值时返回
+ * MStr_Err_InvalidNumber, 超出范围时返回MStr_Err_NumberOutOfRange
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_i32(
+    int32_t* value,
+    const char* beg,
+    const char* end,
+    MStrFmtIntIndex index,
+    const char** stop
+);
+
+/**
+ * @brief 将字符串转换为无符号整数
+ *
+ * @param[out] value: 转换结果
+ * @param[in] beg: 字符串的开始
+ * @param[in] end: 字符串的结束
+ * @param[in] index: Index
+ * @param[out] stop: 转换结束的位置, 可以为NULL
+ *
+ * @note 允许'+'号, 不允许'-'号
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_u32(
+    uint32_t* value,
+    const char* beg,
+    const char* end,
+    MStrFmtIntIndex index,
+    const char** stop
+);
+
+/**
+ * @brief 将字符串转换为64位有符号整数
+ *
+ * @param[out] value: 转换结果
+ * @param[in] beg: 字符串的开始
+ * @param[in] end: 字符串的结束
+ * @param[in] index: Index
+ * @param[out] stop: 转换结束的位置, 可以为NULL
+ *
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_i64(
+    int64_t* value,
+    const char* beg,
+    const char* end,
+    MStrFmtIntIndex index,
+    const char** stop
+);
+
+/**
+ * @brief 将字符串转换为64位无符号整数
+ *
+ * @param[out] value: 转换结果
+ * @param[in] beg: 字符串的开始
+ * @param[in] end: 字符串的结束
+ * @param[in] index: Index
+ * @param[out] stop: 转换结束的位置, 可以为NULL
+ *
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_u64(
+    uint64_t* value,
+    const char* beg,
+    const char* end,
+    MStrFmtIntIndex index,
+    const char** stop
+);
+
+/**
+ * @brief 将十进制小数转换为有符号量化值
+ *
+ * @param[out] value: 转换结果
+ * @param[in] beg: 字符串的开始
+ * @param[in] end: 字符串的结束
+ * @param[in] quat: 量化精度, 1 ~ 31
+ * @param[out] stop: 转换结束的位置, 可以为NULL
+ *
+ * @note 按照四舍六入五成双进行舍入, 可以转换 mstr_fmt_iqtoa 的结果
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_iq(
+    int32_t* value,
+    const char* beg,
+    const char* end,
+    uint32_t quat,
+    const char** stop
+);
+
+/**
+ * @brief 将十进制小数转换为无符号量化值
+ *
+ * @param[out] value: 转换结果
+ * @param[in] beg: 字符串的开始
+ * @param[in] end: 字符串的结束
+ * @param[in] quat: 量化精度, 1 ~ 31
+ * @param[out] stop: 转换结束的位置, 可以为NULL
+ *
+ * @note 按照四舍六入五成双进行舍入, 可以转换 mstr_fmt_uqtoa 的结果
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_uq(
+    uint32_t* value,
+    const char* beg,
+    const char* end,
+    uint32_t quat,
+    const char** stop
+);
+
+/**
+ * @brief 将十进制小数转换为64位有符号量化值
+ *
+ * @param[out] value: 转换结果
+ * @param[in] beg: 字符串的开始
+ * @param[in] end: 字符串的结束
+ * @param[in] quat: 量化精度, 1 ~ 63
+ * @param[out] stop: 转换结束的位置, 可以为NULL
+ *
+ * @note 按照四舍六入五成双进行舍入
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_iq64(
+    int64_t* value,
+    const char* beg,
+    const char* end,
+    uint32_t quat,
+    const char** stop
+);
+
+/**
+ * @brief 将十进制小数转换为64位无符号量化值
+ *
+ * @param[out] value: 转换结果
+ * @param[in] beg: 字符串的开始
+ * @param[in] end: 字符串的结束
+ * @param[in] quat: 量化精度, 1 ~ 63
+ * @param[out] stop: 转换结束的位置, 可以为NULL
+ *
+ * @note 按照四舍六入五成双进行舍入
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_uq64(
+    uint64_t* value,
+    const char* beg,
+    const char* end,
+    uint32_t quat,
+    const char** stop
+);
+
+/**
+ * @brief 将十进制小数转换为有符号定点数
+ *
+ * @param[out] value: 转换结果, 符号扩展到32位
+ * @param[in] beg: 字符串的开始
+ * @param[in] end: 字符串的结束
+ * @param[in] ibits: 整数部分的位数 (包括符号位)
+ * @param[in] fbits: 小数部分的位数
+ * @param[out] stop: 转换结束的位置, 可以为NULL
+ *
+ * @note 按照四舍六入五成双进行舍入, 可以转换 mstr_fmt_ifixtoa 的结果
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_ifix(
+    int32_t* value,
+    const char* beg,
+    const char* end,
+    uint32_t ibits,
+    uint32_t fbits,
+    const char** stop
+);
+
+/**
+ * @brief 将十进制小数转换为无符号定点数
+ *
+ * @param[out] value: 转换结果
+ * @param[in] beg: 字符串的开始
+ * @param[in] end: 字符串的结束
+ * @param[in] ibits: 整数部分的位数
+ * @param[in] fbits: 小数部分的位数
+ * @param[out] stop: 转换结束的位置, 可以为NULL
+ *
+ * @note 按照四舍六入五成双进行舍入, 可以转换 mstr_fmt_ufixtoa 的结果
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_ufix(
+    uint32_t* value,
+    const char* beg,
+    const char* end,
+    uint32_t ibits,
+    uint32_t fbits,
+    const char** stop
+);
+
+#if _MSTR_USE_FP_FLOAT32
+/**
+ * @brief 将十进制字符串转换为float
+ *
+ * @param[out] value: 转换结果
+ * @param[in] beg: 字符串的开始
+ * @param[in] end: 字符串的结束
+ * @param[out] stop: 转换结束的位置, 可以为NULL
+ *
+ * @return mstr_result_t: 不是有效的数值时返回
+ * MStr_Err_InvalidNumber, 超出float的范围时返回
+ * MStr_Err_NumberOutOfRange
+ *
+ * @note 接受 `[+|-]digits[.digits][e[+|-]digits]` 以及inf、nan,
+ * 结果按照四舍六入五成双正确舍入, 太小的值转换为0
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_f32(
+    float* value, const char* beg, const char* end, const char** stop
+);
+#endif // _MSTR_USE_FP_FLOAT32
+
+#if _MSTR_USE_FP_FLOAT64
+/**
+ * @brief 将十进制字符串转换为double
+ *
+ * @param[out] value: 转换结果
+ * @param[in] beg: 字符串的开始
+ * @param[in] end: 字符串的结束
+ * @param[out] stop: 转换结束的位置, 可以为NULL
+ *
+ * @note 和 mstr_parse_f32 相同, 可以用来代替strtod
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_f64(
+    double* value, const char* beg, const char* end, const char** stop
+);
+#endif // _MSTR_USE_FP_FLOAT64
+
+/**
+ * @brief 按照格式化串从字符串中读取值
+ *
+ * @param[in] input: 输入
+ * @param[in] fmt: 格式化串, 语法和 mstr_format 相同
+ * @param[in] fmt_place: 参数数目, 最大不超过16(MFMT_PLACE_MAX_NUM)
+ *
+ * @return mstr_result_t: 输入和字面量不一致, 有多余的输入,
+ * 或者同一个参数读取到不同的值时返回 MStr_Err_InputMismatch
+ *
+ * @note 参数是指向结果的指针: 整数、量化值和定点数的类型和fmt中的类型
+ * 一致, 比如i16对应int16_t*, q63对应int64_t*; 字符串对应MString*,
+ * 读取到下一个字面量字符为止.
+ * 指定宽度时读取宽度个字符, 并且按照对齐方式去掉填充的一侧
+ * (右对齐去掉开头, 左对齐去掉结尾, 居中去掉两侧) 的填充字符,
+ * 至少保留一个字符. 数值左侧的'0'交给转换函数处理.
+ * 返回错误时, 错误之前的参数已经被写入
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_scan(
+    const MString* input, const char* fmt, usize_t fmt_place, ...
+);
+
+/**
+ * @brief 按照格式化串从字符串中读取值
+ *
+ * @param[in] input: 输入
+ * @param[in] fmt: 格式化串
+ * @param[in] fmt_place: 参数数目
+ * @param[in] ap_ptr: 参数
+ *
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_vscan(
+    const MString* input,
+    const char* fmt,
+    usize_t fmt_place,
+    va_list* ap_ptr
+);
+
+/**
+ * @brief 解析扫描模板
+ *
+ * @param[out] tpl: 模板
+ * @param[in] fmt: 格式化串
+ *
+ * @return mstr_result_t: 项数超过MFMT_SCAN_ITEM_MAX_NUM时返回
+ * MStr_Err_InternalBufferTooSmall
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_scan_compile(MStrScanTemplate* tpl, const char* fmt);
+
+/**
+ * @brief 按照已经解析过的模板从字符串中读取值
+ *
+ * @param[in] input: 输入
+ * @param[in] tpl: 模板
+ * @param[in] fmt_place: 参数数目
+ *
+ * @note 和 mstr_scan 相同, 但是跳过格式化串的解析
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_scan_compiled(
+    const MString* input,
+    const MStrScanTemplate* tpl,
+    usize_t fmt_place,
+    ...
+);
+
+#endif // _INCLUDE_MM_SCAN_H_
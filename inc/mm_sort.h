@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    mm_sort.h
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   字符串数组的排序
+ * @version 1.0
+ * @date    2023-09-02
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ * @note 按字节的字典序排序 (和 mstr_compare 相同), 内容相等的字符串
+ * 之间的顺序不确定. 使用多关键字快速排序, 每个元素缓存当前位置开始的
+ * 8个字节, 大部分比较不需要访问字符串的内容
+ */
+#if !defined(_INCLUDE_MM_SORT_H_)
+#define _INCLUDE_MM_SORT_H_ 1
+#include "mm_cfg.h"
+#include "mm_result.h"
+#include "mm_string.h"
+#include "mm_type.h"
+
+/**
+ * @brief 排序任务
+ *
+ */
+typedef void (*MStrSortTask)(void* arg);
+
+/**
+ * @brief 提交任务到线程池
+ *
+ * @return mstr_bool_t: 返回False表示没有提交, 此时在当前线程执行
+ */
+typedef mstr_bool_t (*MStrSortSubmit)(
+    void* ctx, MStrSortTask task, void* arg
+);
+
+/**
+ * @brief 等待所有提交的任务完成
+ *
+ */
+typedef void (*MStrSortWait)(void* ctx);
+
+/**
+ * @brief 调用者提供的线程池
+ *
+ */
+typedef struct tagMStrSortPool
+{
+    /**
+     * @brief 上下文
+     *
+     */
+    void* capture;
+
+    /**
+     * @brief 提交任务callback
+     *
+     */
+    MStrSortSubmit submit;
+
+    /**
+     * @brief 等待任务callback
+     *
+     */
+    MStrSortWait wait;
+
+    /**
+     * @brief 元素数目超过它时才使用线程池
+     *
+     */
+    usize_t threshold;
+
+    /**
+     * @brief 元素数目少于它的部分在当前线程排序, 不提交
+     *
+     */
+    usize_t task_size;
+} MStrSortPool;
+
+/**
+ * @brief 对字符串数组排序
+ *
+ * @param[inout] arr: 数组
+ * @param[in] cnt: 元素数目
+ * @param[in] pool: 线程池, 可以为NULL
+ *
+ * @return mstr_result_t: 分配失败时返回MStr_Err_HeapTooSmall,
+ * 此时数组不变
+ *
+ * @note 需要分配 cnt 个排序项的内存 (64位下每个32字节).
+ * 使用线程池时先按照首字节分桶, 再把每个桶作为一个任务,
+ * 此时需要约 257 * 2 * sizeof(void*) 字节的栈空间.
+ * 所有任务在返回之前完成
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_sort(MString* arr, usize_t cnt, const MStrSortPool* pool);
+
+/**
+ * @brief 对视图数组排序
+ *
+ * @see mstr_sort
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_sort_view(MStringView* arr, usize_t cnt, const MStrSortPool* pool);
+
+#endif // _INCLUDE_MM_SORT_H_
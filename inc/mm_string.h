@@ -129,6 +129,83 @@ typedef struct tagMStringIter
     usize_t rem_length;
 } MStringIter;
 
+/**
+ * @brief 字符串视图, 引用一段不需要以'\0'结尾的UTF-8字符串
+ *
+ * @attention 视图不拥有内存, 被引用的字符串修改或者释放之后,
+ * 视图就失效了
+ */
+typedef struct tagMStringView
+{
+    /**
+     * @brief 开始位置
+     *
+     */
+    const char* buff;
+
+    /**
+     * @brief 字节长度
+     *
+     */
+    usize_t count;
+
+    /**
+     * @brief 字符长度
+     *
+     */
+    usize_t length;
+} MStringView;
+
+/**
+ * @brief 分割迭代器, 每次取出一个使用分隔符分开的字段
+ *
+ * @note 迭代器引用原字符串, 不会分配内存
+ */
+typedef struct tagMStringSplit
+{
+    /**
+     * @brief 剩余部分的开始, NULL表示已经结束
+     *
+     */
+    const char* it;
+
+    /**
+     * @brief 结束位置
+     *
+     */
+    const char* it_end;
+
+    /**
+     * @brief 剩余部分的字符长度
+     *
+     */
+    usize_t rem_length;
+
+    /**
+     * @brief 分隔符串, 按照字符集合分割时为空
+     *
+     */
+    MStringView sep;
+
+    /**
+     * @brief 分隔字符集合的字符数
+     *
+     */
+    usize_t delim_cnt;
+
+    /**
+     * @brief 分隔字符, 最多4个, 不足4个时用第一个补齐
+     *
+     */
+    char delim[4];
+
+    /**
+     * @brief 分隔字符集合的位图
+     *
+     */
+    uint8_t delim_set[32];
+} MStringSplit;
+
 /**
  * @brief 初始化一个空的字符串
  *
@@ -177,8 +254,12 @@ mstr_move_from(MString* str, MString* other);
  * @param[out] str: 目标字符串
  * @param[in] other: 需要移动的字符串
  *
- * @attention 该函数会清空释放原有的字符串并创建一个新的,
- * other需要再次释放, 且会释放掉原有的str
+ * @attention 该函数会清空原有的字符串,
+ * other需要再次释放, str原有的内容会被覆盖
+ *
+ * @note 启用 _MSTR_USE_SHARED_BUFFER 时,
+ * 如果other的内容在堆上, str会和other共享同一块内存,
+ * 直到其中一个被修改
  */
 MSTR_EXPORT_API(mstr_result_t)
 mstr_copy_from(MString* str, const MString* other);
@@ -189,10 +270,24 @@ mstr_copy_from(MString* str, const MString* other);
  * @param[inout] str: 字符串
  * @param[in] new_size: 需要保留的大小
  *
+ * @note 返回之后str的内存区不会和其它字符串共享
  */
 MSTR_EXPORT_API(mstr_result_t)
 mstr_reserve(MString* str, usize_t new_size);
 
+/**
+ * @brief 如果str和其它字符串共享内存, 复制一份自己的内存
+ *
+ * @param[inout] str: 字符串
+ *
+ * @return mstr_result_t: 分配失败时返回MStr_Err_HeapTooSmall,
+ * 此时str不会被修改
+ *
+ * @note 所有修改字符串的函数都会先调用它,
+ * 没有启用 _MSTR_USE_SHARED_BUFFER 时什么也不做
+ */
+MSTR_EXPORT_API(mstr_result_t) mstr_detach(MString* str);
+
 /**
  * @brief 拼接字符串
  *
@@ -307,6 +402,42 @@ mstr_equal(const MString* a, const MString* b);
 MSTR_EXPORT_API(mstr_bool_t)
 mstr_equal_cstr(const MString* a, const mstr_char_t* b, usize_t b_cnt);
 
+/**
+ * @brief 按照字节的字典序比较两个字符串
+ *
+ * @param[in] a: 字符串a
+ * @param[in] b: 字符串b
+ *
+ * @return int: a < b时小于0, 相等时为0, a > b时大于0
+ *
+ * @note 字节按照无符号数比较, 对于UTF-8编码的字符串,
+ * 结果和按照代码点比较相同
+ */
+MSTR_EXPORT_API(int) mstr_compare(const MString* a, const MString* b);
+
+/**
+ * @brief 按照字节的字典序比较两个视图, 参考 mstr_compare
+ *
+ */
+MSTR_EXPORT_API(int)
+mstr_compare_view(const MStringView* a, const MStringView* b);
+
+/**
+ * @brief 判断两个字符串是否相等, 比较的时间只和长度有关
+ *
+ * @param[in] a: 字符串a
+ * @param[in] b: 字符串b
+ * @param[in] b_cnt: 字符串b的字节数
+ *
+ * @attention 用于比较口令、MAC等需要避免时序攻击的场合,
+ * 长度不同时直接返回False, 所以不能隐藏长度.
+ * 其它场合应该使用 mstr_equal, 它在遇到不同的内容时就会返回
+ */
+MSTR_EXPORT_API(mstr_bool_t)
+mstr_equal_constant_time(
+    const MString* a, const mstr_char_t* b, usize_t b_cnt
+);
+
 /**
  * @brief 判断字符串是否以某个字串开始
  *
@@ -520,6 +651,186 @@ mstr_codepoint_of(
 MSTR_EXPORT_API(usize_t)
 mstr_char_offset_at(const MString* str, usize_t idx);
 
+/**
+ * @brief 取得整个字符串的视图
+ *
+ * @param[out] view: 视图
+ * @param[in] str: 字符串
+ */
+MSTR_EXPORT_API(void)
+mstr_view_of(MStringView* view, const MString* str);
+
+/**
+ * @brief 取得C字符串的视图
+ *
+ * @param[out] view: 视图
+ * @param[in] beg: 字符串的开始
+ * @param[in] end: 字符串的结束, 为NULL表示到'\0'为止
+ *
+ * @return mstr_result_t: 最后一个字符不完整时返回
+ * MStr_Err_EncodingNotCompleted
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_view_from_cstr(
+    MStringView* view, const char* beg, const char* end
+);
+
+/**
+ * @brief 取得字符索引[beg, end)的子视图
+ *
+ * @param[out] out: 子视图, 可以和view相同
+ * @param[in] view: 视图
+ * @param[in] beg: 开始的字符索引
+ * @param[in] end: 结束的字符索引
+ *
+ * @return mstr_result_t: 索引超出范围时返回MStr_Err_IndexOutOfBound
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_view_slice(
+    MStringView* out, const MStringView* view, usize_t beg, usize_t end
+);
+
+/**
+ * @brief 取得字节偏移[beg, end)的子视图
+ *
+ * @param[out] out: 子视图, 可以和view相同
+ * @param[in] view: 视图
+ * @param[in] beg: 开始的字节偏移
+ * @param[in] end: 结束的字节偏移
+ *
+ * @return mstr_result_t: 偏移超出范围时返回MStr_Err_IndexOutOfBound,
+ * 偏移不在字符的边界上时返回MStr_Err_UnicodeEncodingError
+ *
+ * @note 配合 mstr_view_find 返回的 begin_offset 使用,
+ * 可以跳过按照字符索引查找偏移的过程
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_view_slice_bytes(
+    MStringView* out, const MStringView* view, usize_t beg, usize_t end
+);
+
+/**
+ * @brief 查找子串第一次出现的位置
+ *
+ * @param[in] view: 视图
+ * @param[out] f_res: 查找结果, 位置都相对于视图的开始
+ * @param[in] begin_pos: 开始查找的字符索引
+ * @param[in] pattern: 需要查找的子串
+ *
+ * @return mstr_result_t: begin_pos超出范围时返回
+ * MStr_Err_IndexOutOfBound
+ *
+ * @note 不会分配内存
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_view_find(
+    const MStringView* view,
+    MStringMatchResult* f_res,
+    usize_t begin_pos,
+    const MStringView* pattern
+);
+
+/**
+ * @brief 在第一个sep处把视图分成两部分
+ *
+ * @param[out] head: sep之前的部分
+ * @param[out] rest: sep之后的部分, 可以和view相同
+ * @param[in] view: 视图
+ * @param[in] sep: 分隔符
+ *
+ * @return mstr_bool_t: 是否找到了sep. 没有找到或者sep为空时,
+ * head为整个视图, rest为空
+ */
+MSTR_EXPORT_API(mstr_bool_t)
+mstr_view_split(
+    MStringView* head,
+    MStringView* rest,
+    const MStringView* view,
+    const MStringView* sep
+);
+
+/**
+ * @brief 判断两个视图的内容是否相等
+ *
+ */
+MSTR_EXPORT_API(mstr_bool_t)
+mstr_view_equal(const MStringView* a, const MStringView* b);
+
+/**
+ * @brief 判断视图是否以prefix开始
+ *
+ */
+MSTR_EXPORT_API(mstr_bool_t)
+mstr_view_start_with(
+    const MStringView* view, const MStringView* prefix
+);
+
+/**
+ * @brief 判断视图是否以suffix结束
+ *
+ */
+MSTR_EXPORT_API(mstr_bool_t)
+mstr_view_end_with(const MStringView* view, const MStringView* suffix);
+
+/**
+ * @brief 使用字符集合分割视图
+ *
+ * @param[out] sp: 分割迭代器
+ * @param[in] view: 视图
+ * @param[in] delims: 分隔字符, 任意一个都是分隔符
+ * @param[in] delim_cnt: 分隔字符的数目, 为0表示不分割
+ *
+ * @return mstr_result_t: 分隔字符不是ASCII字符时返回
+ * MStr_Err_UnicodeEncodingError
+ *
+ * @note 分隔字符不多于4个时一次比较多个字节
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_split_by_chars(
+    MStringSplit* sp,
+    const MStringView* view,
+    const char* delims,
+    usize_t delim_cnt
+);
+
+/**
+ * @brief 使用分隔符串分割视图
+ *
+ * @param[out] sp: 分割迭代器
+ * @param[in] view: 视图
+ * @param[in] sep: 分隔符串, 为空表示不分割
+ *
+ */
+MSTR_EXPORT_API(void)
+mstr_split_by_str(
+    MStringSplit* sp, const MStringView* view, const MStringView* sep
+);
+
+/**
+ * @brief 取出下一个字段
+ *
+ * @param[inout] sp: 分割迭代器
+ * @param[out] field: 字段
+ *
+ * @return mstr_bool_t: 没有字段时返回False
+ *
+ * @note n个分隔符分出n + 1个字段, 字段可以为空, 比如"a,,b,"会得到
+ * "a"、""、"b"、""
+ */
+MSTR_EXPORT_API(mstr_bool_t)
+mstr_split_next(MStringSplit* sp, MStringView* field);
+
+/**
+ * @brief 拼接视图的内容
+ *
+ * @param[out] str: 目标字符串
+ * @param[in] view: 视图, 不能引用str自己
+ *
+ * @note 使用视图中保存的字符长度, 不会再扫描一次UTF-8编码
+ */
+MSTR_EXPORT_API(mstr_result_t)
+mstr_concat_view(MString* str, const MStringView* view);
+
 /**
  * @brief 释放一个字符串所占的内存
  *
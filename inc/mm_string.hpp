@@ -13,6 +13,8 @@
 #define _INCLUDE_MM_STRING_HPP_ 1
 #include "mm_cfg.h"
 #include "mm_fmt.h"
+#include "mm_hash.h"
+#include "mm_parser.hpp"
 #include "mm_result.hpp"
 #include "mm_string.h"
 #include <array>
@@ -22,6 +24,8 @@
 #include <limits>
 #include <string.h>
 #include <string>
+#include <type_traits>
+#include <utility>
 namespace mtfmt
 {
 /**
@@ -236,8 +240,657 @@ template <typename T> struct fixed_wrapper
  */
 template <typename T> using wrapper_t = typename T::value_t;
 
+/**
+ * @brief 格式化参数的类型信息, 不支持的类型在编译期报错
+ *
+ */
+template <typename T, typename = void> struct fmt_argument_traits
+{
+    static_assert(
+        !std::is_same<T, T>::value, "unsupported format argument type"
+    );
+};
+
+/**
+ * @brief 按照整数的宽度和符号取得参数类型
+ *
+ */
+template <typename T> constexpr MStrFmtArgType fmt_integer_type()
+{
+    return std::is_signed<T>::value
+               ? (sizeof(T) == 1   ? MStrFmtArgType_Int8
+                  : sizeof(T) == 2 ? MStrFmtArgType_Int16
+                                   : MStrFmtArgType_Int32)
+               : (sizeof(T) == 1   ? MStrFmtArgType_Uint8
+                  : sizeof(T) == 2 ? MStrFmtArgType_Uint16
+                                   : MStrFmtArgType_Uint32);
+}
+
+/**
+ * @brief 整数: i8 ~ i32, u8 ~ u32
+ *
+ */
+template <typename T>
+struct fmt_argument_traits<
+    T,
+    enable_if_t<
+        std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+        sizeof(T) <= sizeof(int32_t),
+        void>>
+{
+    static constexpr MStrFmtArgType type()
+    {
+        return fmt_integer_type<T>();
+    }
+
+    static iptr_t value(const T& v)
+    {
+        return static_cast<iptr_t>(v);
+    }
+};
+
+/**
+ * @brief 数组: 指向整数的指针
+ *
+ * @note char* 是字符串, 不是数组
+ *
+ */
+template <typename T>
+struct fmt_argument_traits<
+    const T*,
+    enable_if_t<
+        std::is_integral<T>::value && !std::is_same<T, bool>::value &&
+        !std::is_same<T, char>::value && sizeof(T) <= sizeof(int32_t),
+        void>>
+{
+    static constexpr MStrFmtArgType type()
+    {
+        return static_cast<MStrFmtArgType>(
+            fmt_integer_type<T>() | MStrFmtArgType_Array_Bit
+        );
+    }
+
+    static iptr_t value(const T* v)
+    {
+        return reinterpret_cast<iptr_t>(v);
+    }
+};
+
+/**
+ * @brief 字符串: s
+ *
+ */
+template <> struct fmt_argument_traits<const char*>
+{
+    static constexpr MStrFmtArgType type()
+    {
+        return MStrFmtArgType_CString;
+    }
+
+    static iptr_t value(const char* v)
+    {
+        return reinterpret_cast<iptr_t>(v);
+    }
+};
+
+/**
+ * @brief 字符串数组: [s]
+ *
+ */
+template <> struct fmt_argument_traits<const char* const*>
+{
+    static constexpr MStrFmtArgType type()
+    {
+        return MStrFmtArgType_Array_CString;
+    }
+
+    static iptr_t value(const char* const* v)
+    {
+        return reinterpret_cast<iptr_t>(v);
+    }
+};
+
+/**
+ * @brief 日期时间: t
+ *
+ */
+template <> struct fmt_argument_traits<const MStrTime*>
+{
+    static constexpr MStrFmtArgType type()
+    {
+        return MStrFmtArgType_Time;
+    }
+
+    static iptr_t value(const MStrTime* v)
+    {
+        return reinterpret_cast<iptr_t>(v);
+    }
+};
+
+/**
+ * @brief Unix时间戳: T
+ *
+ */
+template <> struct fmt_argument_traits<const MStrTimestamp*>
+{
+    static constexpr MStrFmtArgType type()
+    {
+        return MStrFmtArgType_Timestamp;
+    }
+
+    static iptr_t value(const MStrTimestamp* v)
+    {
+        return reinterpret_cast<iptr_t>(v);
+    }
+};
+
+/**
+ * @brief 量化值: qXX
+ *
+ */
+template <typename T>
+struct fmt_argument_traits<
+    fixed_wrapper<T>,
+    enable_if_t<
+        std::is_integral<T>::value && sizeof(T) <= sizeof(int32_t),
+        void>>
+{
+    static constexpr MStrFmtArgType type()
+    {
+        return std::is_signed<T>::value
+                   ? MStrFmtArgType_QuantizedValue
+                   : MStrFmtArgType_QuantizedUnsignedValue;
+    }
+
+    static iptr_t value(const fixed_wrapper<T>& v)
+    {
+        return static_cast<iptr_t>(v.value);
+    }
+};
+
+/**
+ * @brief 64位量化值: qXX, XX大于31, 传递指向值的指针
+ *
+ */
+template <typename T>
+struct fmt_argument_traits<
+    fixed_wrapper<T>,
+    enable_if_t<
+        std::is_integral<T>::value && sizeof(T) == sizeof(int64_t),
+        void>>
+{
+    static constexpr MStrFmtArgType type()
+    {
+        return std::is_signed<T>::value
+                   ? MStrFmtArgType_QuantizedValue64
+                   : MStrFmtArgType_QuantizedUnsignedValue64;
+    }
+
+    static iptr_t value(const fixed_wrapper<T>& v)
+    {
+        return reinterpret_cast<iptr_t>(&v.value);
+    }
+};
+
+/**
+ * @brief 参数的类型 (去掉引用, cv, 并且把指针统一为指向const)
+ *
+ */
+template <typename T>
+using fmt_argument_t = typename std::conditional<
+    std::is_pointer<typename std::decay<T>::type>::value,
+    const typename std::remove_cv<typename std::remove_pointer<
+        typename std::decay<T>::type>::type>::type*,
+    typename std::decay<T>::type>::type;
+
+/**
+ * @brief 构造一个带有类型的格式化参数
+ *
+ */
+template <typename T> MStrFmtFormatArgument fmt_argument(const T& value)
+{
+    using traits_t = fmt_argument_traits<fmt_argument_t<T>>;
+    MStrFmtFormatArgument arg;
+    arg.value = traits_t::value(value);
+    arg.type = traits_t::type();
+    return arg;
+}
+
 } // namespace details
 
+/**
+ * @brief 分割字符串得到的字段
+ *
+ */
+class split_range;
+
+/**
+ * @brief 字符串视图
+ *
+ * @attention 视图不拥有内存, 被引用的字符串需要比视图活得更久
+ *
+ */
+class string_view final
+{
+    /**
+     * @brief c对象
+     *
+     */
+    MStringView this_view;
+
+public:
+    using value_t = mstr_char_t;
+    using const_iterator = details::string_iterator;
+    using const_reverse_iterator =
+        std::reverse_iterator<const_iterator>;
+
+    /**
+     * @brief 创建空的视图
+     *
+     */
+    string_view() noexcept
+    {
+        this_view.buff = "";
+        this_view.count = 0;
+        this_view.length = 0;
+    }
+
+    /**
+     * @brief 从C字符串创建
+     *
+     * @attention 最后一个字符不完整时得到空的视图
+     */
+    string_view(const value_t* c_str) noexcept : string_view()
+    {
+        mstr_view_from_cstr(&this_view, c_str, nullptr);
+    }
+
+    /**
+     * @brief 从C字符串的前cnt个字节创建
+     *
+     */
+    string_view(const value_t* buff, usize_t cnt) noexcept
+        : string_view()
+    {
+        mstr_view_from_cstr(&this_view, buff, buff + cnt);
+    }
+
+    /**
+     * @brief 从c对象创建
+     *
+     */
+    string_view(const MStringView& view) noexcept : this_view(view)
+    {
+    }
+
+    /**
+     * @brief 取得字符串长度
+     *
+     */
+    usize_t length() const noexcept
+    {
+        return this_view.length;
+    }
+
+    /**
+     * @brief 取得字符串占用的字节数
+     *
+     */
+    usize_t byte_count() const noexcept
+    {
+        return this_view.count;
+    }
+
+    /**
+     * @brief 取得数据的开始位置, 不以'\0'结尾
+     *
+     */
+    const value_t* data() const noexcept
+    {
+        return this_view.buff;
+    }
+
+    /**
+     * @brief 相等
+     *
+     */
+    bool operator==(const string_view& rhs) const noexcept
+    {
+        return !!mstr_view_equal(&this_view, &rhs.this_view);
+    }
+
+    /**
+     * @brief 不等
+     *
+     */
+    bool operator!=(const string_view& rhs) const noexcept
+    {
+        return !(*this == rhs);
+    }
+
+    /**
+     * @brief 按字节比较大小
+     *
+     * @return int: 小于0, 等于0, 大于0分别表示小于, 等于, 大于rhs
+     */
+    int compare(const string_view& rhs) const noexcept
+    {
+        return mstr_compare_view(&this_view, &rhs.this_view);
+    }
+
+    bool operator<(const string_view& rhs) const noexcept
+    {
+        return compare(rhs) < 0;
+    }
+
+    bool operator>(const string_view& rhs) const noexcept
+    {
+        return compare(rhs) > 0;
+    }
+
+    bool operator<=(const string_view& rhs) const noexcept
+    {
+        return compare(rhs) <= 0;
+    }
+
+    bool operator>=(const string_view& rhs) const noexcept
+    {
+        return compare(rhs) >= 0;
+    }
+
+    /**
+     * @brief 判断是否以另一个字串开始
+     *
+     */
+    bool start_with(const string_view& prefix) const noexcept
+    {
+        return !!mstr_view_start_with(&this_view, &prefix.this_view);
+    }
+
+    /**
+     * @brief 判断是否以另一个字串结束
+     *
+     */
+    bool end_with(const string_view& suffix) const noexcept
+    {
+        return !!mstr_view_end_with(&this_view, &suffix.this_view);
+    }
+
+    /**
+     * @brief 取得字符索引[beg, end)的子视图
+     *
+     */
+    result<string_view, error_code_t> slice(
+        usize_t beg, usize_t end
+    ) const noexcept
+    {
+        MStringView sub;
+        error_code_t res = mstr_view_slice(&sub, &this_view, beg, end);
+        if (MSTR_SUCC(res)) {
+            return string_view(sub);
+        }
+        else {
+            return res;
+        }
+    }
+
+    /**
+     * @brief 查找字符串
+     *
+     * @note 该函数会在找不到的时候返回succ, 但是index是-1
+     */
+    result<isize_t, error_code_t> find(
+        const string_view& patt, usize_t begin_pos = 0
+    ) const noexcept
+    {
+        MStringMatchResult find_result;
+        error_code_t res = mstr_view_find(
+            &this_view, &find_result, begin_pos, &patt.this_view
+        );
+        if (MSTR_FAILED(res)) {
+            return res;
+        }
+        else if (find_result.is_matched) {
+            return static_cast<isize_t>(find_result.begin_pos);
+        }
+        else {
+            return static_cast<isize_t>(-1);
+        }
+    }
+
+    /**
+     * @brief 在第一个sep处分成两部分
+     *
+     * @note 找不到sep时返回MStr_Err_NoSubstrFound
+     */
+    result<std::pair<string_view, string_view>, error_code_t> split(
+        const string_view& sep
+    ) const noexcept
+    {
+        MStringView head, rest;
+        if (mstr_view_split(&head, &rest, &this_view, &sep.this_view)) {
+            return std::make_pair(string_view(head), string_view(rest));
+        }
+        else {
+            return MStr_Err_NoSubstrFound;
+        }
+    }
+
+    /**
+     * @brief 使用字符集合分割, 任意一个字符都是分隔符
+     *
+     * @note 分隔字符不是ASCII字符时返回MStr_Err_UnicodeEncodingError
+     */
+    result<split_range, error_code_t> split_any(const value_t* delims
+    ) const noexcept;
+
+    /**
+     * @brief 使用分隔符串分割
+     *
+     */
+    split_range split_by(const string_view& sep) const noexcept;
+
+    /**
+     * @brief 取得迭代器起始
+     *
+     */
+    const_iterator begin() const noexcept
+    {
+        return const_iterator(
+            this_view.buff, this_view.buff, this_view.length
+        );
+    }
+
+    /**
+     * @brief 取得迭代器结束
+     *
+     */
+    const_iterator end() const noexcept
+    {
+        return const_iterator(
+            this_view.buff, this_view.buff + this_view.count, 0
+        );
+    }
+
+    /**
+     * @brief 取得反向迭代器起始
+     *
+     */
+    const_reverse_iterator rbegin() const noexcept
+    {
+        return const_reverse_iterator(end());
+    }
+
+    /**
+     * @brief 取得反向迭代器结束
+     *
+     */
+    const_reverse_iterator rend() const noexcept
+    {
+        return const_reverse_iterator(begin());
+    }
+
+    /**
+     * @brief 返回raw object
+     *
+     */
+    const MStringView& raw_view() const noexcept
+    {
+        return this_view;
+    }
+};
+
+/**
+ * @brief 分割字符串得到的字段, 用于range-for
+ *
+ * @note 不会分配内存, 每个字段都是原字符串的视图
+ *
+ */
+class split_range final
+{
+    /**
+     * @brief 分割迭代器
+     *
+     */
+    MStringSplit this_split;
+
+public:
+    /**
+     * @brief 字段迭代器
+     *
+     */
+    class iterator
+    {
+        /**
+         * @brief 分割迭代器
+         *
+         */
+        MStringSplit state;
+
+        /**
+         * @brief 当前的字段
+         *
+         */
+        MStringView field;
+
+        /**
+         * @brief 是否已经结束
+         *
+         */
+        bool is_end;
+
+    public:
+        using value_type = string_view;
+        using pointer = const string_view*;
+        using reference = string_view;
+        using difference_type = iptr_t;
+        using iterator_category = std::input_iterator_tag;
+
+        iterator() noexcept : state(), field(), is_end(true)
+        {
+        }
+
+        iterator(const MStringSplit& sp) noexcept
+            : state(sp), field(), is_end(false)
+        {
+            ++*this;
+        }
+
+        reference operator*() const noexcept
+        {
+            return string_view(field);
+        }
+
+        iterator& operator++() noexcept
+        {
+            is_end = !mstr_split_next(&state, &field);
+            return *this;
+        }
+
+        iterator operator++(int) noexcept
+        {
+            iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        bool operator==(const iterator& rhs) const noexcept
+        {
+            if (is_end || rhs.is_end) {
+                return is_end == rhs.is_end;
+            }
+            else {
+                return field.buff == rhs.field.buff &&
+                       state.it == rhs.state.it;
+            }
+        }
+
+        bool operator!=(const iterator& rhs) const noexcept
+        {
+            return !(*this == rhs);
+        }
+    };
+
+    /**
+     * @brief 空字符串, 只有一个空的字段
+     *
+     */
+    split_range() noexcept
+    {
+        MStringView empty{"", 0, 0};
+        mstr_split_by_str(&this_split, &empty, &empty);
+    }
+
+    /**
+     * @brief 从c对象创建
+     *
+     */
+    split_range(const MStringSplit& sp) noexcept : this_split(sp)
+    {
+    }
+
+    /**
+     * @brief 取得第一个字段
+     *
+     */
+    iterator begin() const noexcept
+    {
+        return iterator(this_split);
+    }
+
+    /**
+     * @brief 取得结束位置
+     *
+     */
+    iterator end() const noexcept
+    {
+        return iterator();
+    }
+};
+
+inline result<split_range, error_code_t> string_view::split_any(
+    const value_t* delims
+) const noexcept
+{
+    MStringSplit sp;
+    error_code_t res =
+        mstr_split_by_chars(&sp, &this_view, delims, strlen(delims));
+    if (MSTR_SUCC(res)) {
+        return split_range(sp);
+    }
+    else {
+        return res;
+    }
+}
+
+inline split_range string_view::split_by(const string_view& sep
+) const noexcept
+{
+    MStringSplit sp;
+    mstr_split_by_str(&sp, &this_view, &sep.this_view);
+    return split_range(sp);
+}
+
 /**
  * @brief 字符串类
  *
@@ -304,6 +957,29 @@ public:
         mstr_copy_from(&this_obj, &str.this_obj);
     }
 
+    /**
+     * @brief 移动, 堆上的内存区直接交给this
+     *
+     * @param str: str, 移动之后为空字符串
+     */
+    string(string&& str) noexcept
+    {
+        mstr_init(&this_obj);
+        mstr_move_from(&this_obj, &str.this_obj);
+        mstr_init(&str.this_obj);
+    }
+
+    /**
+     * @brief 从视图创建
+     *
+     * @param view: 视图
+     */
+    explicit string(const string_view& view)
+    {
+        mstr_init(&this_obj);
+        mstr_concat_view(&this_obj, &view.raw_view());
+    }
+
     ~string()
     {
         mstr_free(&this_obj);
@@ -314,8 +990,19 @@ public:
      */
     string& operator=(const string& str) noexcept
     {
-        mstr_clear(&this_obj);
-        mstr_concat(&this_obj, &str.this_obj);
+        mstr_copy_from(&this_obj, &str.this_obj);
+        return *this;
+    }
+
+    /**
+     * @brief move
+     */
+    string& operator=(string&& str) noexcept
+    {
+        if (this != &str) {
+            mstr_move_from(&this_obj, &str.this_obj);
+            mstr_init(&str.this_obj);
+        }
         return *this;
     }
 
@@ -399,6 +1086,36 @@ public:
         return !(pthis == str);
     }
 
+    /**
+     * @brief 按字节比较大小
+     *
+     * @return int: 小于0, 等于0, 大于0分别表示小于, 等于, 大于rhs
+     */
+    int compare(const string& rhs) const noexcept
+    {
+        return mstr_compare(&this_obj, &rhs.this_obj);
+    }
+
+    bool operator<(const string& rhs) const noexcept
+    {
+        return compare(rhs) < 0;
+    }
+
+    bool operator>(const string& rhs) const noexcept
+    {
+        return compare(rhs) > 0;
+    }
+
+    bool operator<=(const string& rhs) const noexcept
+    {
+        return compare(rhs) <= 0;
+    }
+
+    bool operator>=(const string& rhs) const noexcept
+    {
+        return compare(rhs) >= 0;
+    }
+
     /**
      * @brief 保留足够的内存
      *
@@ -539,6 +1256,23 @@ public:
         }
     }
 
+    /**
+     * @brief 放入一个字符串 (视图)
+     *
+     */
+    result<unit_t, mstr_result_t> concat(const string_view& rhs
+    ) noexcept
+    {
+        mstr_result_t code =
+            mstr_concat_view(&this_obj, &rhs.raw_view());
+        if (MSTR_SUCC(code)) {
+            return unit_t();
+        }
+        else {
+            return code;
+        }
+    }
+
     /**
      * @brief 字符串拼接 (self)
      *
@@ -567,6 +1301,20 @@ public:
         return *this;
     }
 
+    /**
+     * @brief 字符串拼接 (视图)
+     *
+     * @attention 无法完成操作会抛出异常
+     *
+     */
+    string& operator+=(const string_view& rhs)
+    {
+        concat(rhs).or_exception([](error_code_t e) {
+            return mtfmt_error(e);
+        });
+        return *this;
+    }
+
     /**
      * @brief 字符串拼接 (字符)
      *
@@ -878,6 +1626,18 @@ public:
         return std::string(this_obj.buff, this_obj.count);
     }
 
+    /**
+     * @brief 取得整个字符串的视图
+     *
+     * @attention 修改或者释放字符串之后视图就失效了
+     */
+    string_view view() const noexcept
+    {
+        MStringView v;
+        mstr_view_of(&v, &this_obj);
+        return string_view(v);
+    }
+
     /**
      * @brief 取得迭代器起始 (const)
      *
@@ -1015,8 +1775,8 @@ public:
             MStrFmtSignDisplay sign = MStrFmtSignDisplay_NegOnly
         ) noexcept
     {
-        error_code_t res = mstr_fmt_iqtoa(
-            &this_obj, static_cast<int32_t>(value.value), p, sign
+        error_code_t res = mstr_fmt_iq64toa(
+            &this_obj, static_cast<int64_t>(value.value), p, -1, sign
         );
         if (MSTR_SUCC(res)) {
             return unit_t{};
@@ -1042,8 +1802,8 @@ public:
         result<unit_t, error_code_t>>
         append_from(const T& value, uint32_t p) noexcept
     {
-        error_code_t res = mstr_fmt_uqtoa(
-            &this_obj, static_cast<uint32_t>(value.value), p
+        error_code_t res = mstr_fmt_uq64toa(
+            &this_obj, static_cast<uint64_t>(value.value), p, -1
         );
         if (MSTR_SUCC(res)) {
             return unit_t{};
@@ -1134,10 +1894,11 @@ public:
         ) noexcept
     {
         string ret_str;
-        error_code_t res = mstr_fmt_iqtoa(
+        error_code_t res = mstr_fmt_iq64toa(
             &ret_str.this_obj,
-            static_cast<int32_t>(value.value),
+            static_cast<int64_t>(value.value),
             p,
+            -1,
             sign
         );
         if (MSTR_SUCC(res)) {
@@ -1165,8 +1926,8 @@ public:
         from(const T& value, uint32_t p) noexcept
     {
         string ret_str;
-        error_code_t res = mstr_fmt_uqtoa(
-            &ret_str.this_obj, static_cast<uint32_t>(value.value), p
+        error_code_t res = mstr_fmt_uq64toa(
+            &ret_str.this_obj, static_cast<uint64_t>(value.value), p, -1
         );
         if (MSTR_SUCC(res)) {
             return ret_str;
@@ -1213,6 +1974,13 @@ public:
     /**
      * @brief 进行格式化(动态的格式化串)
      *
+     * @attention 参数按照其C++类型在栈上构造为带类型的参数表,
+     * 类型需要和格式化串中标注的类型一致(例如 int32_t 对应 i32,
+     * const char* 对应 s, const MStrTime* 对应 t,
+     * const MStrTimestamp* 对应 T),
+     * 数组的长度需要以 uint32_t 传入.
+     * 不支持的参数类型会在编译时报错
+     *
      * @tparam Args: 参数类型
      *
      * @param fmt_str: 格式化串
@@ -1226,19 +1994,115 @@ public:
     )
     {
         string str;
-        error_code_t code = mstr_format(
-            &str.raw_object_mut(),
-            fmt_str,
-            sizeof...(args),
-            std::forward<Args&&>(args)...
+        error_code_t code = str.format_append_impl(
+            fmt_str, std::forward<Args>(args)...
         );
         if (MSTR_SUCC(code)) {
-            return str;
+            return std::move(str);
+        }
+        else {
+            return code;
+        }
+    }
+
+    /**
+     * @brief 格式化到已有的字符串, 原来的内容会被清空
+     *
+     * @note 已经分配的内存会被保留, 重复使用同一个out时,
+     * 容量足够就不会再分配内存
+     *
+     * @param out: 输出
+     * @param fmt_str: 格式化串
+     * @param args: 格式化参数, 参考 format_variable
+     */
+    template <typename Fmt, typename... Args>
+    static result<unit_t, error_code_t> format_to(
+        string& out, const Fmt& fmt_str, Args&&... args
+    )
+    {
+        out.clear();
+        return out.format_append(fmt_str, std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief 格式化并追加到this的末尾
+     *
+     * @param fmt_str: 格式化串, 参考 format_variable
+     * @param args: 格式化参数
+     */
+    template <typename... Args>
+    result<unit_t, error_code_t> format_append(
+        const string::value_t* fmt_str, Args&&... args
+    )
+    {
+        error_code_t code =
+            format_append_impl(fmt_str, std::forward<Args>(args)...);
+        if (MSTR_SUCC(code)) {
+            return unit_t{};
+        }
+        else {
+            return code;
+        }
+    }
+
+#if _MSTR_USE_CONSTEXPR_PARSER
+    /**
+     * @brief 进行格式化(编译期解析的格式化串)
+     *
+     * @note 格式化串由 MSTR_COMPILE_FORMAT 在编译期解析,
+     * 运行时不再经过parser, 例如:
+     * `string::format(MSTR_COMPILE_FORMAT("{0:i32}"), 1)`
+     *
+     * @tparam Args: 参数类型, 参考 format_variable
+     *
+     * @param fmt: 解析好的格式化串
+     * @param args: 格式化参数
+     *
+     * @return result<string, error_code_t>: 结果
+     */
+    template <
+        std::size_t S,
+        std::size_t F,
+        std::size_t C,
+        typename... Args>
+    static result<string, error_code_t> format(
+        const details::compiled_format<S, F, C>& fmt, Args&&... args
+    )
+    {
+        string str;
+        error_code_t code =
+            str.format_append_impl(fmt, std::forward<Args>(args)...);
+        if (MSTR_SUCC(code)) {
+            return std::move(str);
+        }
+        else {
+            return code;
+        }
+    }
+
+    /**
+     * @brief 格式化并追加到this的末尾(编译期解析的格式化串)
+     *
+     */
+    template <
+        std::size_t S,
+        std::size_t F,
+        std::size_t C,
+        typename... Args>
+    result<unit_t, error_code_t> format_append(
+        const details::compiled_format<S, F, C>& fmt, Args&&... args
+    )
+    {
+        error_code_t code =
+            format_append_impl(fmt, std::forward<Args>(args)...);
+        if (MSTR_SUCC(code)) {
+            return unit_t{};
         }
         else {
             return code;
         }
     }
+#endif // _MSTR_USE_CONSTEXPR_PARSER
 
 protected:
     /**
@@ -1258,6 +2122,48 @@ protected:
     {
         return this_obj;
     }
+
+private:
+    /**
+     * @brief 把格式化结果追加到this
+     *
+     */
+    template <typename... Args>
+    error_code_t format_append_impl(
+        const string::value_t* fmt_str, Args&&... args
+    )
+    {
+        // 末尾多放一个空的元素, 避免出现长度为0的数组
+        const MStrFmtFormatArgument argv[sizeof...(args) + 1] = {
+            details::fmt_argument(args)..., MStrFmtFormatArgument{}
+        };
+        return mstr_format_argv(
+            &this_obj, fmt_str, argv, sizeof...(args)
+        );
+    }
+
+#if _MSTR_USE_CONSTEXPR_PARSER
+    /**
+     * @brief 把格式化结果追加到this(编译期解析的格式化串)
+     *
+     */
+    template <
+        std::size_t S,
+        std::size_t F,
+        std::size_t C,
+        typename... Args>
+    error_code_t format_append_impl(
+        const details::compiled_format<S, F, C>& fmt, Args&&... args
+    )
+    {
+        const MStrFmtFormatArgument argv[sizeof...(args) + 1] = {
+            details::fmt_argument(args)..., MStrFmtFormatArgument{}
+        };
+        return details::fmt_compiled_format(
+            &this_obj, fmt, argv, sizeof...(args)
+        );
+    }
+#endif // _MSTR_USE_CONSTEXPR_PARSER
 };
 
 /**
@@ -1286,4 +2192,35 @@ inline string operator""_ms(const char* str)
 } // namespace literals
 
 } // namespace mtfmt
+
+namespace std {
+/**
+ * @brief 字符串的哈希, 使用 mstr_hash_view
+ *
+ */
+template <> struct hash<mtfmt::string>
+{
+    std::size_t operator()(const mtfmt::string& str) const noexcept
+    {
+        return static_cast<std::size_t>(
+            mstr_hash_view(&str.view().raw_view())
+        );
+    }
+};
+
+/**
+ * @brief 视图的哈希, 和内容相同的字符串的哈希值相等
+ *
+ */
+template <> struct hash<mtfmt::string_view>
+{
+    std::size_t operator()(const mtfmt::string_view& view
+    ) const noexcept
+    {
+        return static_cast<std::size_t>(
+            mstr_hash_view(&view.raw_view())
+        );
+    }
+};
+} // namespace std
 #endif // _INCLUDE_MM_STRING_HPP_
@@ -103,4 +103,17 @@ typedef struct tagMStrTime
     //! (BCD) 亚秒值, 单位: x0.1ms
     uint32_t sub_second;
 } MStrTime;
+
+/**
+ * @brief Unix时间戳 (UTC)
+ *
+ */
+typedef struct tagMStrTimestamp
+{
+    //! 从1970-01-01 00:00:00开始的秒数
+    int64_t second;
+
+    //! 纳秒, 0 ~ 999999999
+    uint32_t nanosecond;
+} MStrTimestamp;
 #endif // __INCLUDE_MM_TYPE_H__
@@ -13,9 +13,14 @@
 #define _INCLUDE_MTFMT_H_
 #include "mm_cfg.h"
 #include "mm_fmt.h"
+#include "mm_hash.h"
 #include "mm_heap.h"
+#include "mm_intern.h"
 #include "mm_io.h"
 #include "mm_result.h"
+#include "mm_rope.h"
+#include "mm_scan.h"
+#include "mm_sort.h"
 #include "mm_string.h"
 #include "mm_type.h"
 #endif // _INCLUDE_MTFMT_H_
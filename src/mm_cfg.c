@@ -45,6 +45,15 @@ MSTR_EXPORT_API(uint32_t) mstr_configure(void)
 #if _MSTR_USE_ALLOC
     configure |= MSTRCFG_USE_ALLOCATOR;
 #endif // _MSTR_USE_ALLOC
+#if _MSTR_USE_FMT_CACHE
+    configure |= MSTRCFG_USE_FMT_CACHE;
+#endif // _MSTR_USE_FMT_CACHE
+#if _MSTR_USE_SIMD_SSE2
+    configure |= MSTRCFG_USE_SIMD;
+#endif // _MSTR_USE_SIMD_SSE2
+#if _MSTR_USE_CHRONO_CACHE
+    configure |= MSTRCFG_USE_CHRONO_CACHE;
+#endif // _MSTR_USE_CHRONO_CACHE
     // 使用的编译器信息
     configure |= MSTR_BUILD_CC << 12;
     // ret
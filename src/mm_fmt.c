@@ -14,6 +14,8 @@
 
 #include "mm_fmt.h"
 #include "mm_type.h"
+#include <stddef.h>
+#include <string.h>
 
 /**
  * @brief 将元素类型T转换为对应的数组类型值
@@ -22,6 +24,136 @@
 #define AS_ARRAY_TYPE(t) \
     ((MStrFmtArgType)((uint32_t)(t) | MStrFmtArgType_Array_Bit))
 
+/**
+ * @brief 判断值类型是否使用chrono_spec (Time和Timestamp)
+ *
+ */
+#define IS_CHRONO_ARG_TYPE(t) \
+    ((t) == MStrFmtArgType_Time || (t) == MStrFmtArgType_Timestamp)
+
+#if _MSTR_USE_FMT_CACHE
+#if (_MSTR_FMT_CACHE_SLOTS & (_MSTR_FMT_CACHE_SLOTS - 1)) != 0
+#error "_MSTR_FMT_CACHE_SLOTS must be a power of 2"
+#endif
+
+/**
+ * @brief 非Time的值的解析结果需要保存的部分的长度
+ *
+ */
+#define FMT_CACHE_VALUE_SIZE                                     \
+    (offsetof(MStrFmtParseResult, val.val.spec.fmt_spec.spec) + \
+     sizeof(MStrFmtValueFormatSpec))
+
+/**
+ * @brief 非Time的数组的解析结果的保存长度 (不含split)
+ *
+ */
+#define FMT_CACHE_ARRAY_SIZE                                     \
+    (offsetof(MStrFmtParseResult, val.arr.spec.fmt_spec.spec) + \
+     sizeof(MStrFmtValueFormatSpec))
+
+/**
+ * @brief Time的值的解析结果中chrono items的offset
+ *
+ */
+#define FMT_CACHE_CHRONO_OFFSET \
+    offsetof(                   \
+        MStrFmtParseResult, val.val.spec.fmt_spec.spec.chrono.items \
+    )
+
+/**
+ * @brief 缓存的一条记录: 字面量 + 一个replacement field
+ *
+ * @note 字面量直接从格式化串中取, 记录中只保存长度.
+ * result_size为0表示格式化串结束
+ */
+typedef struct tagFmtCacheRecord
+{
+    //! 字面量的长度
+    uint16_t literal_len;
+
+    //! replacement field在格式化串中的长度
+    uint16_t source_len;
+
+    //! 记录后面附带的解析结果的长度
+    uint16_t result_size;
+} FmtCacheRecord;
+
+/**
+ * @brief 缓存的hash表的项
+ *
+ */
+typedef struct tagFmtCacheSlot
+{
+    //! 格式化串, 为NULL表示空项
+    const char* fmt;
+
+    //! 记录在arena中的位置
+    usize_t offset;
+} FmtCacheSlot;
+
+/**
+ * @brief 格式化串缓存
+ *
+ */
+typedef struct tagFmtCacheState
+{
+    //! hash表 (open addressing, 线性探测)
+    FmtCacheSlot slots[_MSTR_FMT_CACHE_SLOTS];
+
+    //! 保存记录的内存
+    byte_t arena[_MSTR_FMT_CACHE_SIZE];
+
+    //! arena已经使用的大小
+    usize_t used_size;
+
+    //! 缓存中的格式化串数目
+    usize_t entry_count;
+
+    //! 统计信息
+    usize_t hit, miss, flush;
+} FmtCacheState;
+
+/**
+ * @brief 在格式化的同时生成缓存记录
+ *
+ */
+typedef struct tagFmtCacheBuilder
+{
+    //! 格式化串
+    const char* fmt;
+
+    //! 需要的arena大小
+    usize_t need_size;
+
+    //! 当前的字面量长度
+    usize_t literal_len;
+
+    //! 是否能够放进缓存
+    mstr_bool_t cacheable;
+} FmtCacheBuilder;
+
+/**
+ * @brief 格式化串缓存 (每个线程一份)
+ *
+ */
+static MSTR_THREAD_LOCAL FmtCacheState fmt_cache;
+
+static usize_t fmt_cache_index(const char*);
+static const byte_t* fmt_cache_lookup(const char*);
+static mstr_result_t fmt_cache_replay(
+    MString*, const char*, const byte_t*, MStrFmtArgsContext*
+);
+static void fmt_cache_begin(FmtCacheBuilder*, const char*);
+static void fmt_cache_push(
+    FmtCacheBuilder*, usize_t, const MStrFmtParseResult*
+);
+static void fmt_cache_commit(FmtCacheBuilder*);
+static usize_t fmt_cache_pack(byte_t*, const MStrFmtParseResult*);
+static void
+    fmt_cache_unpack(MStrFmtParseResult*, const byte_t*, usize_t);
+#endif // _MSTR_USE_FMT_CACHE
+
 //
 // private:
 //
@@ -44,6 +176,8 @@ static mstr_result_t
     convert_string(MString*, iptr_t, const MStrFmtFormatSpec*);
 static mstr_result_t
     convert_time(MString*, iptr_t, const MStrFmtFormatSpec*);
+static mstr_result_t
+    convert_timestamp(MString*, iptr_t, const MStrFmtFormatSpec*);
 static mstr_result_t convert_int(
     MString*, int32_t, MStrFmtSignDisplay, MStrFmtFormatType
 );
@@ -51,12 +185,27 @@ static mstr_result_t convert_uint(
     MString*, uint32_t, MStrFmtFormatType
 );
 static mstr_result_t convert_quat(
-    MString*, int32_t, uint32_t, MStrFmtSignDisplay
+    MString*, int64_t, uint32_t, int32_t, MStrFmtSignDisplay
+);
+static mstr_result_t
+    convert_uquat(MString*, uint64_t, uint32_t, int32_t);
+static mstr_result_t convert_fixed(
+    MString*,
+    int32_t,
+    const MStrFmtArgProperty*,
+    int32_t,
+    MStrFmtSignDisplay
+);
+static mstr_result_t convert_ufixed(
+    MString*, uint32_t, const MStrFmtArgProperty*, int32_t
 );
-static mstr_result_t convert_uquat(MString*, uint32_t, uint32_t);
 static mstr_result_t fmt_type_as_integer_index(
     MStrFmtIntIndex*, MStrFmtFormatType
 );
+static mstr_bool_t fmt_type_is_bytes(MStrFmtFormatType);
+static mstr_result_t convert_bytes(
+    MString*, const MStrFmtParseResultArrayResult*, iptr_t, usize_t
+);
 
 //
 // public:
@@ -87,16 +236,43 @@ mstr_vformat(
     return mstr_context_format(res_str, fmt, &context);
 }
 
+MSTR_EXPORT_API(mstr_result_t)
+mstr_format_argv(
+    MString* res_str,
+    const char* fmt,
+    const MStrFmtFormatArgument* args,
+    usize_t arg_cnt
+)
+{
+    MStrFmtArgsContext context = {0};
+    context.max_place = arg_cnt;
+    context.p_args = args;
+    return mstr_context_format(res_str, fmt, &context);
+}
+
 MSTR_EXPORT_API(mstr_result_t)
 mstr_context_format(
     MString* res_str, const char* fmt, MStrFmtArgsContext* ctx
 )
 {
     mstr_result_t result = MStr_Ok;
+#if _MSTR_USE_FMT_CACHE
+    FmtCacheBuilder builder;
+    const byte_t* cache_entry;
+#endif // _MSTR_USE_FMT_CACHE
     // 处理格式化串
-    if (ctx->max_place > MFMT_PLACE_MAX_NUM) {
+    // (参数数组可以随机访问, 不需要cache, 也就没有数目限制)
+    if (ctx->p_args == NULL && ctx->max_place > MFMT_PLACE_MAX_NUM) {
         return MStr_Err_IndexTooLarge;
     }
+#if _MSTR_USE_FMT_CACHE
+    // 已经解析过的格式化串, 跳过解析
+    cache_entry = fmt_cache_lookup(fmt);
+    if (cache_entry != NULL) {
+        return fmt_cache_replay(res_str, fmt, cache_entry, ctx);
+    }
+    fmt_cache_begin(&builder, fmt);
+#endif // _MSTR_USE_FMT_CACHE
     // else:
     while (!!*fmt && MSTR_SUCC(result)) {
         if (*fmt != '{' && *fmt != '}') {
@@ -104,76 +280,362 @@ mstr_context_format(
             char ch = *fmt;
             fmt += 1;
             result = mstr_append(res_str, ch);
+#if _MSTR_USE_FMT_CACHE
+            builder.literal_len += 1;
+#endif // _MSTR_USE_FMT_CACHE
         }
         else {
             // 解析格式化串
-            uint32_t arg_id;
-            MStrFmtArgClass arg_class;
-            MStrFmtFormatArgument arg = {0};
-            MStrFmtFormatArgument arg_attach = {0};
             MStrFmtParseResult parser_result;
+#if _MSTR_USE_FMT_CACHE
+            const char* field_beg = fmt;
+#endif // _MSTR_USE_FMT_CACHE
             MSTR_AND_THEN(
                 result, process_replacement_field(&fmt, &parser_result)
             );
-            // 处理结果
-            arg_id = parser_result.val.val.id;
-            arg_class = parser_result.arg_class;
-            switch (arg_class) {
-            case MStrFmtArgClass_EscapeChar:
-                // 转义字符, 直接append
-                MSTR_AND_THEN(
-                    result,
-                    mstr_append(res_str, parser_result.val.escape_char)
-                );
-                break;
-            case MStrFmtArgClass_Value:
-                // 载入参数
-                MSTR_AND_THEN(
-                    result,
-                    load_value(
-                        &arg, ctx, arg_id, parser_result.val.val.typ
-                    )
-                );
-                // 进行格式化
-                MSTR_AND_THEN(
-                    result, format_value(res_str, &parser_result, &arg)
-                );
-                break;
-            case MStrFmtArgClass_Array:
-                // 载入参数
-                MSTR_AND_THEN(
-                    result,
-                    load_value(
-                        &arg,
-                        ctx,
-                        arg_id,
-                        AS_ARRAY_TYPE(parser_result.val.arr.ele_typ)
-                    )
-                );
-                // (数组长度)
-                MSTR_AND_THEN(
-                    result,
-                    load_value(
-                        &arg_attach,
-                        ctx,
-                        arg_id + 1,
-                        MStrFmtArgType_Uint32
-                    )
-                );
-                // 格式化数组
-                MSTR_AND_THEN(
-                    result,
-                    format_array(
-                        res_str, &parser_result, &arg, &arg_attach
-                    )
+#if _MSTR_USE_FMT_CACHE
+            if (MSTR_SUCC(result)) {
+                fmt_cache_push(
+                    &builder, (usize_t)(fmt - field_beg), &parser_result
                 );
-                break;
             }
+#endif // _MSTR_USE_FMT_CACHE
+            // 处理结果
+            MSTR_AND_THEN(
+                result,
+                mstr_context_format_field(res_str, &parser_result, ctx)
+            );
+        }
+    }
+#if _MSTR_USE_FMT_CACHE
+    if (MSTR_SUCC(result)) {
+        fmt_cache_commit(&builder);
+    }
+#endif // _MSTR_USE_FMT_CACHE
+    return result;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_context_format_field(
+    MString* res_str,
+    const MStrFmtParseResult* parser_result,
+    MStrFmtArgsContext* ctx
+)
+{
+    mstr_result_t result = MStr_Ok;
+    uint32_t arg_id = parser_result->val.val.id;
+    MStrFmtFormatArgument arg = {0};
+    MStrFmtFormatArgument arg_attach = {0};
+    switch (parser_result->arg_class) {
+    case MStrFmtArgClass_EscapeChar:
+        // 转义字符, 直接append
+        result = mstr_append(res_str, parser_result->val.escape_char);
+        break;
+    case MStrFmtArgClass_Value:
+        // 载入参数
+        result = load_value(
+            &arg, ctx, arg_id, parser_result->val.val.typ
+        );
+        // 进行格式化
+        MSTR_AND_THEN(
+            result, format_value(res_str, parser_result, &arg)
+        );
+        break;
+    case MStrFmtArgClass_Array:
+        // 载入参数
+        result = load_value(
+            &arg,
+            ctx,
+            arg_id,
+            AS_ARRAY_TYPE(parser_result->val.arr.ele_typ)
+        );
+        // (数组长度)
+        MSTR_AND_THEN(
+            result,
+            load_value(
+                &arg_attach, ctx, arg_id + 1, MStrFmtArgType_Uint32
+            )
+        );
+        // 格式化数组
+        MSTR_AND_THEN(
+            result,
+            format_array(res_str, parser_result, &arg, &arg_attach)
+        );
+        break;
+    }
+    return result;
+}
+
+#if _MSTR_USE_FMT_CACHE
+MSTR_EXPORT_API(void)
+mstr_fmt_cache_statistics(MStrFmtCacheStatistics* stat)
+{
+    stat->hit = fmt_cache.hit;
+    stat->miss = fmt_cache.miss;
+    stat->flush = fmt_cache.flush;
+    stat->entry_count = fmt_cache.entry_count;
+    stat->used_size = fmt_cache.used_size;
+    stat->capacity = _MSTR_FMT_CACHE_SIZE;
+}
+
+MSTR_EXPORT_API(void) mstr_fmt_cache_clear(void)
+{
+    memset(&fmt_cache, 0, sizeof(fmt_cache));
+}
+
+/**
+ * @brief 计算格式化串在hash表中的位置
+ *
+ */
+static usize_t fmt_cache_index(const char* fmt)
+{
+    uint32_t hash = (uint32_t)(uptr_t)fmt * 0x9e3779b1u;
+    return (hash ^ (hash >> 16)) & (_MSTR_FMT_CACHE_SLOTS - 1);
+}
+
+/**
+ * @brief 查找格式化串的缓存记录
+ *
+ * @param[in] fmt: 格式化串
+ *
+ * @return const byte_t*: 缓存记录, 未命中时为NULL
+ */
+static const byte_t* fmt_cache_lookup(const char* fmt)
+{
+    usize_t index = fmt_cache_index(fmt);
+    usize_t i;
+    for (i = 0; i < _MSTR_FMT_CACHE_SLOTS; i += 1) {
+        const FmtCacheSlot* slot = &fmt_cache.slots[index];
+        if (slot->fmt == fmt) {
+            fmt_cache.hit += 1;
+            return fmt_cache.arena + slot->offset;
+        }
+        else if (slot->fmt == NULL) {
+            break;
         }
+        index = (index + 1) & (_MSTR_FMT_CACHE_SLOTS - 1);
     }
+    fmt_cache.miss += 1;
+    return NULL;
+}
+
+/**
+ * @brief 按照缓存记录进行格式化
+ *
+ * @param[out] res_str: 格式化结果
+ * @param[in] fmt: 格式化串
+ * @param[in] entry: 缓存记录
+ * @param[in] ctx: 格式化context
+ *
+ */
+static mstr_result_t fmt_cache_replay(
+    MString* res_str,
+    const char* fmt,
+    const byte_t* entry,
+    MStrFmtArgsContext* ctx
+)
+{
+    mstr_result_t result = MStr_Ok;
+    FmtCacheRecord record;
+    do {
+        usize_t i;
+        memcpy(&record, entry, sizeof(FmtCacheRecord));
+        entry += sizeof(FmtCacheRecord);
+        // 和未缓存时一样逐个字符地copy字面量
+        for (i = 0; i < record.literal_len; i += 1) {
+            MSTR_AND_THEN(result, mstr_append(res_str, fmt[i]));
+        }
+        fmt += record.literal_len + record.source_len;
+        // replacement field
+        if (MSTR_SUCC(result) && record.result_size != 0) {
+            MStrFmtParseResult parser_result;
+            fmt_cache_unpack(&parser_result, entry, record.result_size);
+            result =
+                mstr_context_format_field(res_str, &parser_result, ctx);
+        }
+        entry += record.result_size;
+    } while (MSTR_SUCC(result) && record.result_size != 0);
     return result;
 }
 
+/**
+ * @brief 开始生成缓存记录
+ *
+ * @param[out] builder: builder
+ * @param[in] fmt: 格式化串
+ */
+static void fmt_cache_begin(FmtCacheBuilder* builder, const char* fmt)
+{
+    builder->fmt = fmt;
+    builder->need_size = 0;
+    builder->literal_len = 0;
+    builder->cacheable = True;
+}
+
+/**
+ * @brief 放入一条记录
+ *
+ * @param[inout] builder: builder
+ * @param[in] source_len: replacement field在格式化串中的长度
+ * @param[in] parser_result: 解析结果, NULL表示结束
+ */
+static void fmt_cache_push(
+    FmtCacheBuilder* builder,
+    usize_t source_len,
+    const MStrFmtParseResult* parser_result
+)
+{
+    FmtCacheRecord record;
+    usize_t result_size = 0;
+    usize_t offset = fmt_cache.used_size + builder->need_size;
+    if (parser_result != NULL) {
+        result_size = fmt_cache_pack(NULL, parser_result);
+    }
+    if (builder->literal_len > 0xffff || source_len > 0xffff) {
+        builder->cacheable = False;
+    }
+    record.literal_len = (uint16_t)builder->literal_len;
+    record.source_len = (uint16_t)source_len;
+    record.result_size = (uint16_t)result_size;
+    builder->literal_len = 0;
+    builder->need_size += sizeof(FmtCacheRecord) + result_size;
+    // 空间不足时只记录需要的大小
+    if (fmt_cache.used_size + builder->need_size <=
+        _MSTR_FMT_CACHE_SIZE) {
+        byte_t* ptr = fmt_cache.arena + offset;
+        memcpy(ptr, &record, sizeof(FmtCacheRecord));
+        if (parser_result != NULL) {
+            fmt_cache_pack(ptr + sizeof(FmtCacheRecord), parser_result);
+        }
+    }
+}
+
+/**
+ * @brief 完成缓存记录, 并放入缓存
+ *
+ * @param[inout] builder: builder
+ */
+static void fmt_cache_commit(FmtCacheBuilder* builder)
+{
+    usize_t index, total_size;
+    fmt_cache_push(builder, 0, NULL);
+    if (!builder->cacheable ||
+        builder->need_size > _MSTR_FMT_CACHE_SIZE) {
+        // 放不进缓存的格式化串
+        return;
+    }
+    total_size = fmt_cache.used_size + builder->need_size;
+    if (total_size > _MSTR_FMT_CACHE_SIZE ||
+        fmt_cache.entry_count >= _MSTR_FMT_CACHE_SLOTS) {
+        // 缓存满了, 清空缓存, 下一次再放入
+        memset(fmt_cache.slots, 0, sizeof(fmt_cache.slots));
+        fmt_cache.used_size = 0;
+        fmt_cache.entry_count = 0;
+        fmt_cache.flush += 1;
+        return;
+    }
+    // 放入hash表
+    index = fmt_cache_index(builder->fmt);
+    while (fmt_cache.slots[index].fmt != NULL) {
+        index = (index + 1) & (_MSTR_FMT_CACHE_SLOTS - 1);
+    }
+    fmt_cache.slots[index].fmt = builder->fmt;
+    fmt_cache.slots[index].offset = fmt_cache.used_size;
+    fmt_cache.used_size += builder->need_size;
+    fmt_cache.entry_count += 1;
+}
+
+/**
+ * @brief 保存解析结果中格式化时需要的部分
+ *
+ * @param[out] dst: 输出, 为NULL时仅计算长度
+ * @param[in] parser_result: 解析结果
+ *
+ * @return usize_t: 保存需要的长度
+ */
+static usize_t
+    fmt_cache_pack(byte_t* dst, const MStrFmtParseResult* parser_result)
+{
+    const MStrFmtParseResultValueResult* val = &parser_result->val.val;
+    const MStrFmtParseResultArrayResult* arr = &parser_result->val.arr;
+    usize_t size = sizeof(MStrFmtParseResult);
+    switch (parser_result->arg_class) {
+    case MStrFmtArgClass_EscapeChar:
+        size = offsetof(MStrFmtParseResult, val) + sizeof(char);
+        break;
+    case MStrFmtArgClass_Value:
+        if (IS_CHRONO_ARG_TYPE(val->typ)) {
+            // 只需要用到的chrono items
+            size = FMT_CACHE_CHRONO_OFFSET +
+                   val->spec.fmt_spec.spec.chrono.item_cnt *
+                       sizeof(MStrFmtChronoItemFormatSpec);
+        }
+        else {
+            size = FMT_CACHE_VALUE_SIZE;
+        }
+        break;
+    case MStrFmtArgClass_Array:
+        if (!IS_CHRONO_ARG_TYPE(arr->ele_typ)) {
+            // split chars跟在后面
+            size = FMT_CACHE_ARRAY_SIZE + 2 * sizeof(const char*);
+            if (dst != NULL) {
+                byte_t* split = dst + FMT_CACHE_ARRAY_SIZE;
+                memcpy(dst, parser_result, FMT_CACHE_ARRAY_SIZE);
+                memcpy(split, &arr->split_beg, sizeof(const char*));
+                split += sizeof(const char*);
+                memcpy(split, &arr->split_end, sizeof(const char*));
+            }
+            return size;
+        }
+        break;
+    }
+    if (dst != NULL) {
+        memcpy(dst, parser_result, size);
+    }
+    return size;
+}
+
+/**
+ * @brief 从缓存中恢复解析结果
+ *
+ * @param[out] parser_result: 解析结果
+ * @param[in] src: fmt_cache_pack 保存的内容
+ * @param[in] size: 内容的长度
+ */
+static void fmt_cache_unpack(
+    MStrFmtParseResult* parser_result, const byte_t* src, usize_t size
+)
+{
+    MStrFmtParseResultValueResult* val = &parser_result->val.val;
+    MStrFmtParseResultArrayResult* arr = &parser_result->val.arr;
+    if (size == sizeof(MStrFmtParseResult)) {
+        memcpy(parser_result, src, size);
+        return;
+    }
+    memcpy(
+        &parser_result->arg_class,
+        src + offsetof(MStrFmtParseResult, arg_class),
+        sizeof(MStrFmtArgClass)
+    );
+    if (parser_result->arg_class == MStrFmtArgClass_Array) {
+        const byte_t* split = src + FMT_CACHE_ARRAY_SIZE;
+        memcpy(parser_result, src, FMT_CACHE_ARRAY_SIZE);
+        memcpy(&arr->split_beg, split, sizeof(const char*));
+        split += sizeof(const char*);
+        memcpy(&arr->split_end, split, sizeof(const char*));
+    }
+    else {
+        memcpy(parser_result, src, size);
+        if (parser_result->arg_class == MStrFmtArgClass_Value &&
+            IS_CHRONO_ARG_TYPE(val->typ)) {
+            val->spec.fmt_spec.spec.chrono.item_cnt =
+                (size - FMT_CACHE_CHRONO_OFFSET) /
+                sizeof(MStrFmtChronoItemFormatSpec);
+        }
+    }
+}
+#endif // _MSTR_USE_FMT_CACHE
+
 /**
  * @brief 解析replacement field
  *
@@ -202,7 +664,7 @@ static mstr_result_t process_replacement_field(
 }
 
 /**
- * @brief 从可变参数里面载入值
+ * @brief 从参数数组或者可变参数里面载入值
  *
  * @param[out] arg: 返回值
  * @param[inout] ctx: Context
@@ -222,6 +684,12 @@ static mstr_result_t load_value(
     if (arg_id >= max_place) {
         return MStr_Err_InvaildArgumentID;
     }
+    if (ctx->p_args != NULL) {
+        // 参数数组可以直接按下标取, 类型在格式化时检查
+        *arg = ctx->p_args[arg_id];
+        return result;
+    }
+    // else:
     if (arg_id > 0 &&
         cache[arg_id - 1].type == MStrFmtArgType_Unknown) {
         // 上一个参数为NULL(MStrFmtArgType_Unknown),
@@ -262,8 +730,9 @@ static mstr_result_t format_array(
     MString buff;
     mstr_result_t result;
     usize_t array_len, array_index;
-    if (arg->type !=
-        (parser_result->val.arr.ele_typ | MStrFmtArgType_Array_Bit)) {
+    MStrFmtIntIndex index = MStrFmtIntIndex_Dec;
+    const MStrFmtParseResultArrayResult* arr = &parser_result->val.arr;
+    if (arg->type != (arr->ele_typ | MStrFmtArgType_Array_Bit)) {
         return MStr_Err_InvaildArgumentType;
     }
     else if (sz_arg->type != MStrFmtArgType_Uint32) {
@@ -272,24 +741,69 @@ static mstr_result_t format_array(
     // else:
     // 数组长度
     array_len = (usize_t)sz_arg->value;
-    // 格式化数组中的每一个元素
-    array_index = 0;
+    if (fmt_type_is_bytes(arr->spec.fmt_spec.fmt_type) &&
+        arr->spec.width == -1) {
+        // 不需要对齐, 直接写到输出
+        return convert_bytes(res_str, arr, arg->value, array_len);
+    }
     result = mstr_create_empty(&buff);
-    while (MSTR_SUCC(result) && array_index < array_len) {
-        MStrFmtFormatArgument element;
-        element.type = parser_result->val.arr.ele_typ;
-        element.value = array_get_item(arg, array_index);
-        // 格式化元素的值到 internal_buff
-        MSTR_AND_THEN(result, convert(&buff, parser_result, &element));
-        // 增加分隔符
-        if (MSTR_SUCC(result) && array_index + 1 < array_len) {
-            const char* split_beg = parser_result->val.arr.split_beg;
-            const char* split_end = parser_result->val.arr.split_end;
-            result =
-                mstr_concat_cstr_slice(&buff, split_beg, split_end);
+    if (fmt_type_is_bytes(arr->spec.fmt_spec.fmt_type)) {
+        // 按字节转换
+        MSTR_AND_THEN(
+            result, convert_bytes(&buff, arr, arg->value, array_len)
+        );
+    }
+    else {
+        switch (arr->ele_typ) {
+        case MStrFmtArgType_Int8:
+        case MStrFmtArgType_Int16:
+        case MStrFmtArgType_Int32:
+        case MStrFmtArgType_Uint8:
+        case MStrFmtArgType_Uint16:
+        case MStrFmtArgType_Uint32:
+            // 整数数组, 使用按类型特化的实现
+            MSTR_AND_THEN(
+                result,
+                fmt_type_as_integer_index(
+                    &index, arr->spec.fmt_spec.fmt_type
+                )
+            );
+            MSTR_AND_THEN(
+                result,
+                mstr_fmt_arrtoa(
+                    &buff,
+                    (const void*)arg->value,
+                    array_len,
+                    arr->ele_typ,
+                    index,
+                    arr->spec.sign_display,
+                    arr->split_beg,
+                    arr->split_end
+                )
+            );
+            break;
+        default:
+            // 格式化数组中的每一个元素
+            array_index = 0;
+            while (MSTR_SUCC(result) && array_index < array_len) {
+                MStrFmtFormatArgument element;
+                element.type = arr->ele_typ;
+                element.value = array_get_item(arg, array_index);
+                // 格式化元素的值到 internal_buff
+                MSTR_AND_THEN(
+                    result, convert(&buff, parser_result, &element)
+                );
+                // 增加分隔符
+                if (MSTR_SUCC(result) && array_index + 1 < array_len) {
+                    result = mstr_concat_cstr_slice(
+                        &buff, arr->split_beg, arr->split_end
+                    );
+                }
+                // 失败的break在下次循环开始时
+                array_index += 1;
+            }
+            break;
         }
-        // 失败的break在下次循环开始时
-        array_index += 1;
     }
     // 处理对齐和填充
     MSTR_AND_THEN(
@@ -333,6 +847,19 @@ static iptr_t array_get_item(
     case MStrFmtArgType_QuantizedUnsignedValue:
         ele_size = sizeof(uint32_t);
         break;
+    case MStrFmtArgType_FixedValue: ele_size = sizeof(int32_t); break;
+    case MStrFmtArgType_FixedUnsignedValue:
+        ele_size = sizeof(uint32_t);
+        break;
+    case MStrFmtArgType_QuantizedValue64:
+        ele_size = sizeof(int64_t);
+        break;
+    case MStrFmtArgType_QuantizedUnsignedValue64:
+        ele_size = sizeof(uint64_t);
+        break;
+    case MStrFmtArgType_Timestamp:
+        ele_size = sizeof(MStrTimestamp);
+        break;
     default: mstr_unreachable(); break;
     }
     // 取得值
@@ -368,6 +895,18 @@ static iptr_t array_get_item(
     case MStrFmtArgType_QuantizedUnsignedValue:
         element_ptr = (iptr_t)(*(const int32_t*)ptr);
         break;
+    case MStrFmtArgType_FixedValue:
+        element_ptr = (iptr_t)(*(const int32_t*)ptr);
+        break;
+    case MStrFmtArgType_FixedUnsignedValue:
+        element_ptr = (iptr_t)(*(const uint32_t*)ptr);
+        break;
+    case MStrFmtArgType_QuantizedValue64:
+    case MStrFmtArgType_QuantizedUnsignedValue64:
+    case MStrFmtArgType_Timestamp:
+        // 和单个的值一样, 使用指向元素的指针
+        element_ptr = (iptr_t)ptr;
+        break;
     default: mstr_unreachable(); break;
     }
     return element_ptr;
@@ -530,17 +1069,60 @@ static mstr_result_t convert(
             str, value, &parser_result->val.val.spec.fmt_spec
         );
         break;
+    case MStrFmtArgType_Timestamp:
+        result = convert_timestamp(
+            str, value, &parser_result->val.val.spec.fmt_spec
+        );
+        break;
     case MStrFmtArgType_QuantizedValue:
         result = convert_quat(
             str,
             (int32_t)value,
             parser_result->val.val.prop.a,
+            parser_result->val.val.spec.precision,
             parser_result->val.val.spec.sign_display
         );
         break;
     case MStrFmtArgType_QuantizedUnsignedValue:
         result = convert_uquat(
-            str, (uint32_t)value, parser_result->val.val.prop.a
+            str,
+            (uint32_t)value,
+            parser_result->val.val.prop.a,
+            parser_result->val.val.spec.precision
+        );
+        break;
+    case MStrFmtArgType_QuantizedValue64:
+        result = convert_quat(
+            str,
+            *(const int64_t*)value,
+            parser_result->val.val.prop.a,
+            parser_result->val.val.spec.precision,
+            parser_result->val.val.spec.sign_display
+        );
+        break;
+    case MStrFmtArgType_QuantizedUnsignedValue64:
+        result = convert_uquat(
+            str,
+            *(const uint64_t*)value,
+            parser_result->val.val.prop.a,
+            parser_result->val.val.spec.precision
+        );
+        break;
+    case MStrFmtArgType_FixedValue:
+        result = convert_fixed(
+            str,
+            (int32_t)value,
+            &parser_result->val.val.prop,
+            parser_result->val.val.spec.precision,
+            parser_result->val.val.spec.sign_display
+        );
+        break;
+    case MStrFmtArgType_FixedUnsignedValue:
+        result = convert_ufixed(
+            str,
+            (uint32_t)value,
+            &parser_result->val.val.prop,
+            parser_result->val.val.spec.precision
         );
         break;
     default: result = MStr_Err_UnsupportType; break;
@@ -582,15 +1164,36 @@ static mstr_result_t convert_time(
     }
 }
 
+/**
+ * @brief 对Unix时间戳格式化
+ *
+ */
+static mstr_result_t convert_timestamp(
+    MString* str, iptr_t value, const MStrFmtFormatSpec* spec
+)
+{
+    if (spec->fmt_type != MStrFmtFormatType_UnSpec) {
+        return MStr_Err_UnsupportFormatType;
+    }
+    else {
+        const MStrTimestamp* ts = (const MStrTimestamp*)value;
+        return mstr_fmt_tstoa(str, ts, &spec->spec.chrono);
+    }
+}
+
 /**
  * @brief 对有符号量化值进行格式化
  *
  */
 static mstr_result_t convert_quat(
-    MString* str, int32_t value, uint32_t qbits, MStrFmtSignDisplay sign
+    MString* str,
+    int64_t value,
+    uint32_t qbits,
+    int32_t precision,
+    MStrFmtSignDisplay sign
 )
 {
-    return mstr_fmt_iqtoa(str, value, qbits, sign);
+    return mstr_fmt_iq64toa(str, value, qbits, precision, sign);
 }
 
 /**
@@ -598,10 +1201,41 @@ static mstr_result_t convert_quat(
  *
  */
 static mstr_result_t convert_uquat(
-    MString* str, uint32_t value, uint32_t qbits
+    MString* str, uint64_t value, uint32_t qbits, int32_t precision
+)
+{
+    return mstr_fmt_uq64toa(str, value, qbits, precision);
+}
+
+/**
+ * @brief 对有符号定点数进行格式化
+ *
+ */
+static mstr_result_t convert_fixed(
+    MString* str,
+    int32_t value,
+    const MStrFmtArgProperty* prop,
+    int32_t precision,
+    MStrFmtSignDisplay sign
+)
+{
+    return mstr_fmt_ifixtoa(
+        str, value, prop->a, prop->b, precision, sign
+    );
+}
+
+/**
+ * @brief 对无符号定点数进行格式化
+ *
+ */
+static mstr_result_t convert_ufixed(
+    MString* str,
+    uint32_t value,
+    const MStrFmtArgProperty* prop,
+    int32_t precision
 )
 {
-    return mstr_fmt_uqtoa(str, value, qbits);
+    return mstr_fmt_ufixtoa(str, value, prop->a, prop->b, precision);
 }
 
 /**
@@ -679,7 +1313,89 @@ static mstr_result_t fmt_type_as_integer_index(
         // 默认是十进制
         index_map_result = MStrFmtIntIndex_Dec;
         break;
+    case MStrFmtFormatType_HexBytes:
+    case MStrFmtFormatType_HexBytes_UpperCase:
+    case MStrFmtFormatType_HexDump:
+    case MStrFmtFormatType_Base64:
+    case MStrFmtFormatType_Base32:
+        // 只能用于字节数组
+        result = MStr_Err_UnsupportFormatType;
+        break;
     }
     *index = index_map_result;
     return result;
 }
+
+/**
+ * @brief 判断 MStrFmtFormatType 是否只能用于字节数组
+ *
+ */
+static mstr_bool_t fmt_type_is_bytes(MStrFmtFormatType typ)
+{
+    switch (typ) {
+    case MStrFmtFormatType_HexBytes:
+    case MStrFmtFormatType_HexBytes_UpperCase:
+    case MStrFmtFormatType_HexDump:
+    case MStrFmtFormatType_Base64:
+    case MStrFmtFormatType_Base32: return True;
+    default: return False;
+    }
+}
+
+/**
+ * @brief 按字节对数组进行转换 (十六进制转储, Base64等)
+ *
+ * @param[out] str: 输出
+ * @param[in] arr: 数组的格式化描述
+ * @param[in] value: 数组
+ * @param[in] array_len: 数组长度
+ */
+static mstr_result_t convert_bytes(
+    MString* str,
+    const MStrFmtParseResultArrayResult* arr,
+    iptr_t value,
+    usize_t array_len
+)
+{
+    const void* data = (const void*)value;
+    const char* split_beg = arr->split_beg;
+    const char* split_end = arr->split_end;
+    if (arr->ele_typ != MStrFmtArgType_Int8 &&
+        arr->ele_typ != MStrFmtArgType_Uint8) {
+        return MStr_Err_UnsupportFormatType;
+    }
+    switch (arr->spec.fmt_spec.fmt_type) {
+    case MStrFmtFormatType_HexBytes:
+        return mstr_fmt_hexdump(
+            str,
+            data,
+            array_len,
+            MStrFmtHexDumpStyle_Bytes,
+            split_beg,
+            split_end
+        );
+    case MStrFmtFormatType_HexBytes_UpperCase:
+        return mstr_fmt_hexdump(
+            str,
+            data,
+            array_len,
+            MStrFmtHexDumpStyle_Bytes_UpperCase,
+            split_beg,
+            split_end
+        );
+    case MStrFmtFormatType_HexDump:
+        return mstr_fmt_hexdump(
+            str,
+            data,
+            array_len,
+            MStrFmtHexDumpStyle_Canonical,
+            split_beg,
+            split_end
+        );
+    case MStrFmtFormatType_Base64:
+        return mstr_fmt_base64(str, data, array_len);
+    case MStrFmtFormatType_Base32:
+        return mstr_fmt_base32(str, data, array_len);
+    default: return MStr_Err_UnsupportFormatType;
+    }
+}
@@ -0,0 +1,272 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    mm_hash.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   字符串的哈希
+ * @version 1.0
+ * @date    2023-08-31
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+
+#define MSTR_IMP_SOURCES 1
+
+#include "mm_hash.h"
+#include <stddef.h>
+#include <string.h>
+#if MSTR_BUILD_CC == MSTR_BUILD_CC_MSVC && defined(_M_X64)
+#include <intrin.h>
+#endif // MSTR_BUILD_CC
+
+/**
+ * @brief 混合用的常数
+ *
+ */
+static const uint64_t hash_secret[4] = {
+    0x2d358dccaa6c78a5ull,
+    0x8bb84b93962eacc9ull,
+    0x4b33a62ed433d4a3ull,
+    0x4d5a2da51de1aa47ull,
+};
+
+//
+// private:
+//
+
+static void hash_mum(uint64_t*, uint64_t*);
+static uint64_t hash_mix(uint64_t, uint64_t);
+static uint64_t hash_r8(const uint8_t*);
+static uint64_t hash_r4(const uint8_t*);
+static uint64_t hash_seed(uint64_t);
+static const uint8_t* hash_blocks(uint64_t*, const uint8_t*, usize_t);
+static uint64_t
+    hash_finish(const uint8_t*, usize_t, uint64_t, uint64_t);
+
+//
+// public:
+//
+
+MSTR_EXPORT_API(uint64_t)
+mstr_hash_bytes(const void* data, usize_t len, uint64_t seed)
+{
+    const uint8_t* p = (const uint8_t*)data;
+    uint64_t lane[3];
+    usize_t rem = len;
+    lane[0] = hash_seed(seed);
+    if (len > MSTR_HASH_BLOCK_SIZE) {
+        // 3个乘法互相独立, 可以同时执行
+        usize_t blk = (len - 1) / MSTR_HASH_BLOCK_SIZE;
+        lane[1] = lane[0];
+        lane[2] = lane[0];
+        p = hash_blocks(lane, p, blk);
+        rem = len - blk * MSTR_HASH_BLOCK_SIZE;
+        lane[0] ^= lane[1] ^ lane[2];
+    }
+    return hash_finish(p, rem, (uint64_t)len, lane[0]);
+}
+
+MSTR_EXPORT_API(uint64_t) mstr_hash(const MString* str)
+{
+    return mstr_hash_bytes(str->buff, str->count, 0);
+}
+
+MSTR_EXPORT_API(uint64_t) mstr_hash_view(const MStringView* view)
+{
+    return mstr_hash_bytes(view->buff, view->count, 0);
+}
+
+MSTR_EXPORT_API(void)
+mstr_hash_init(MStrHashState* state, uint64_t seed)
+{
+    state->lane[0] = hash_seed(seed);
+    state->lane[1] = state->lane[0];
+    state->lane[2] = state->lane[0];
+    state->total = 0;
+    state->pending = 0;
+    memset(state->buff, 0, 16);
+}
+
+MSTR_EXPORT_API(void)
+mstr_hash_update(MStrHashState* state, const void* data, usize_t len)
+{
+    const uint8_t* p = (const uint8_t*)data;
+    uint8_t* pending = state->buff + 16;
+    state->total += len;
+    // 只有确定后面还有数据时才处理一个块,
+    // 和 mstr_hash_bytes 保持一致
+    if (state->pending > 0) {
+        usize_t cnt = MSTR_HASH_BLOCK_SIZE - state->pending;
+        if (len <= cnt) {
+            memcpy(pending + state->pending, p, len);
+            state->pending += len;
+            return;
+        }
+        memcpy(pending + state->pending, p, cnt);
+        hash_blocks(state->lane, pending, 1);
+        memcpy(state->buff, pending + MSTR_HASH_BLOCK_SIZE - 16, 16);
+        state->pending = 0;
+        p += cnt;
+        len -= cnt;
+    }
+    if (len > MSTR_HASH_BLOCK_SIZE) {
+        usize_t blk = (len - 1) / MSTR_HASH_BLOCK_SIZE;
+        p = hash_blocks(state->lane, p, blk);
+        memcpy(state->buff, p - 16, 16);
+        len -= blk * MSTR_HASH_BLOCK_SIZE;
+    }
+    memcpy(pending, p, len);
+    state->pending = len;
+}
+
+MSTR_EXPORT_API(uint64_t) mstr_hash_final(const MStrHashState* state)
+{
+    uint64_t seed = state->lane[0];
+    if (state->total > MSTR_HASH_BLOCK_SIZE) {
+        seed ^= state->lane[1] ^ state->lane[2];
+    }
+    return hash_finish(
+        state->buff + 16, state->pending, state->total, seed
+    );
+}
+
+/**
+ * @brief 64位乘法, 结果的低64位放在a, 高64位放在b
+ *
+ */
+static void hash_mum(uint64_t* a, uint64_t* b)
+{
+#if MSTR_BUILD_CC == MSTR_BUILD_CC_GNUC && defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)*a * *b;
+    *a = (uint64_t)r;
+    *b = (uint64_t)(r >> 64);
+#elif MSTR_BUILD_CC == MSTR_BUILD_CC_MSVC && defined(_M_X64)
+    *a = _umul128(*a, *b, b);
+#else
+    uint64_t ha = *a >> 32, hb = *b >> 32;
+    uint64_t la = (uint32_t)*a, lb = (uint32_t)*b;
+    uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    uint64_t t = rl + (rm0 << 32);
+    uint64_t c = t < rl;
+    uint64_t lo = t + (rm1 << 32);
+    c += lo < t;
+    *a = lo;
+    *b = rh + (rm0 >> 32) + (rm1 >> 32) + c;
+#endif // MSTR_BUILD_CC
+}
+
+/**
+ * @brief 相乘之后把高低两部分混合
+ *
+ */
+static uint64_t hash_mix(uint64_t a, uint64_t b)
+{
+    hash_mum(&a, &b);
+    return a ^ b;
+}
+
+/**
+ * @brief 读取8个字节
+ *
+ */
+static uint64_t hash_r8(const uint8_t* p)
+{
+    uint64_t v;
+    memcpy(&v, p, 8);
+    return v;
+}
+
+/**
+ * @brief 读取4个字节
+ *
+ */
+static uint64_t hash_r4(const uint8_t* p)
+{
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return v;
+}
+
+/**
+ * @brief 预先混合种子
+ *
+ */
+static uint64_t hash_seed(uint64_t seed)
+{
+    return seed ^ hash_mix(seed ^ hash_secret[0], hash_secret[1]);
+}
+
+/**
+ * @brief 处理blk个48字节的块
+ *
+ * @return const uint8_t*: 处理之后的位置
+ */
+static const uint8_t*
+    hash_blocks(uint64_t* lane, const uint8_t* p, usize_t blk)
+{
+    uint64_t s0 = lane[0], s1 = lane[1], s2 = lane[2];
+    while (blk > 0) {
+        s0 = hash_mix(hash_r8(p) ^ hash_secret[1], hash_r8(p + 8) ^ s0);
+        s1 = hash_mix(
+            hash_r8(p + 16) ^ hash_secret[2], hash_r8(p + 24) ^ s1
+        );
+        s2 = hash_mix(
+            hash_r8(p + 32) ^ hash_secret[3], hash_r8(p + 40) ^ s2
+        );
+        p += MSTR_HASH_BLOCK_SIZE;
+        blk -= 1;
+    }
+    lane[0] = s0;
+    lane[1] = s1;
+    lane[2] = s2;
+    return p;
+}
+
+/**
+ * @brief 处理最后的不超过48个字节
+ *
+ * @param[in] p: 剩下的数据
+ * @param[in] rem: 剩下的字节数
+ * @param[in] len: 总的字节数
+ * @param[in] seed: 累加值
+ *
+ * @attention len大于16时, 会读取p之前的最多16个字节
+ */
+static uint64_t hash_finish(
+    const uint8_t* p, usize_t rem, uint64_t len, uint64_t seed
+)
+{
+    uint64_t a, b;
+    if (len <= 16) {
+        if (rem >= 4) {
+            usize_t off = (rem >> 3) << 2;
+            const uint8_t* q = p + rem - 4;
+            a = (hash_r4(p) << 32) | hash_r4(p + off);
+            b = (hash_r4(q) << 32) | hash_r4(q - off);
+        }
+        else if (rem > 0) {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[rem >> 1] << 8) |
+                p[rem - 1];
+            b = 0;
+        }
+        else {
+            a = 0;
+            b = 0;
+        }
+    }
+    else {
+        while (rem > 16) {
+            seed = hash_mix(
+                hash_r8(p) ^ hash_secret[1], hash_r8(p + 8) ^ seed
+            );
+            p += 16;
+            rem -= 16;
+        }
+        a = hash_r8(p + rem - 16);
+        b = hash_r8(p + rem - 8);
+    }
+    a ^= hash_secret[1];
+    b ^= seed;
+    hash_mum(&a, &b);
+    return hash_mix(a ^ hash_secret[0] ^ len, b ^ hash_secret[1]);
+}
@@ -253,6 +253,8 @@ static void* heap_allocate_impl(
     if (alloc_block == NULL) {
         return NULL;
     }
+    // 没有split的空闲块整个分配出去
+    alloc_size = alloc_block->size;
     // 计算对齐后的地址
     head_addr = (uptr_t)alloc_block;
     align_addr = align_of(head_addr, align);
@@ -361,10 +363,12 @@ static FreeBlock* allocate_tactic(
             // 尺寸合适
             // 移走block这个node
             prev_it->next = block_it->next;
-            if (block->size > sizeof(FreeBlock) * 2) {
+            if (block->size >= need_size + sizeof(FreeBlock)) {
                 // 该空闲块可以split成两部分
+                // 剩余部分要放得下FreeBlock
                 FreeBlock* new_block =
                     split_free_block(block_it, need_size);
+                block->size = need_size;
                 // 插入新的空闲块
                 insert_free_block(heap, new_block);
             }
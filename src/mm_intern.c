@@ -0,0 +1,424 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    mm_intern.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   字符串驻留表
+ * @version 1.0
+ * @date    2023-08-30
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+
+#define MSTR_IMP_SOURCES 1
+
+#include "mm_intern.h"
+#include "mm_hash.h"
+#include "mm_heap.h"
+#include <stddef.h>
+#include <string.h>
+#if _MSTR_USE_SIMD_SSE2
+#include <emmintrin.h>
+#endif // _MSTR_USE_SIMD_SSE2
+
+/**
+ * @brief arena块, 数据在 ARENA_DATA_OFFSET 之后
+ *
+ */
+struct tagMStrInternArena
+{
+    /**
+     * @brief 下一个块
+     *
+     */
+    MStrInternArena* next;
+
+    /**
+     * @brief 块的数据大小
+     *
+     */
+    usize_t size;
+
+    /**
+     * @brief 已经使用的字节数
+     *
+     */
+    usize_t used;
+};
+
+/**
+ * @brief arena中分配的对齐
+ *
+ */
+#define ARENA_ALIGN 8
+
+/**
+ * @brief 向上对齐到 ARENA_ALIGN
+ *
+ */
+#define ARENA_ROUND_UP(s) \
+    (((s) + ARENA_ALIGN - 1) & ~(usize_t)(ARENA_ALIGN - 1))
+
+/**
+ * @brief arena块的数据相对于块的偏移
+ *
+ */
+#define ARENA_DATA_OFFSET ARENA_ROUND_UP(sizeof(MStrInternArena))
+
+/**
+ * @brief 空槽的控制字节
+ *
+ */
+#define CTRL_EMPTY        0x80
+
+/**
+ * @brief 哈希值中用作控制字节的部分
+ *
+ */
+#define HASH_CTRL(h)      ((uint8_t)((h)&0x7f))
+
+/**
+ * @brief 哈希值中用于选择组的部分
+ *
+ */
+#define HASH_GROUP(h)     ((usize_t)((h) >> 7))
+
+//
+// private:
+//
+
+static const MStrInterned*
+    intern_find(const MStrInternTable*, const MStringView*, uint64_t);
+static void
+    intern_group_match(const uint8_t*, uint8_t, uint32_t*, uint32_t*);
+static usize_t intern_first_bit(uint32_t);
+static void intern_place(
+    uint8_t*, const MStrInterned**, usize_t, const MStrInterned*
+);
+static mstr_result_t intern_grow(MStrInternTable*);
+static MStrInterned* intern_arena_alloc(MStrInternTable*, usize_t);
+
+//
+// public:
+//
+
+MSTR_EXPORT_API(void)
+mstr_intern_init(MStrInternTable* tab, usize_t arena_size)
+{
+    tab->ctrl = NULL;
+    tab->slots = NULL;
+    tab->capacity = 0;
+    tab->count = 0;
+    tab->arena = NULL;
+    tab->arena_size =
+        arena_size == 0 ? MSTR_INTERN_ARENA_SIZE : arena_size;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_intern_view(
+    MStrInternTable* tab,
+    const MStringView* view,
+    const MStrInterned** interned
+)
+{
+    uint64_t hash = mstr_hash_view(view);
+    const MStrInterned* found = intern_find(tab, view, hash);
+    MStrInterned* entry;
+    char* buff;
+    if (found != NULL) {
+        *interned = found;
+        return MStr_Ok;
+    }
+    // 负载因子不超过7/8
+    if ((tab->count + 1) * 8 > tab->capacity * 7) {
+        mstr_result_t res = intern_grow(tab);
+        if (MSTR_FAILED(res)) {
+            return res;
+        }
+    }
+    entry = intern_arena_alloc(
+        tab, sizeof(MStrInterned) + view->count + 1
+    );
+    if (entry == NULL) {
+        return MStr_Err_HeapTooSmall;
+    }
+    buff = (char*)(entry + 1);
+    memcpy(buff, view->buff, view->count);
+    buff[view->count] = '\0';
+    entry->view.buff = buff;
+    entry->view.count = view->count;
+    entry->view.length = view->length;
+    entry->hash = hash;
+    intern_place(tab->ctrl, tab->slots, tab->capacity, entry);
+    tab->count += 1;
+    *interned = entry;
+    return MStr_Ok;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_intern(
+    MStrInternTable* tab,
+    const MString* str,
+    const MStrInterned** interned
+)
+{
+    MStringView view;
+    mstr_view_of(&view, str);
+    return mstr_intern_view(tab, &view, interned);
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_intern_cstr(
+    MStrInternTable* tab, const char* str, const MStrInterned** interned
+)
+{
+    MStringView view;
+    mstr_result_t res = mstr_view_from_cstr(&view, str, NULL);
+    MSTR_AND_THEN(res, mstr_intern_view(tab, &view, interned));
+    return res;
+}
+
+MSTR_EXPORT_API(const MStrInterned*)
+mstr_intern_lookup(const MStrInternTable* tab, const MStringView* view)
+{
+    return intern_find(tab, view, mstr_hash_view(view));
+}
+
+MSTR_EXPORT_API(void)
+mstr_intern_statistics(
+    const MStrInternTable* tab, MStrInternStatistics* stat
+)
+{
+    const MStrInternArena* arena = tab->arena;
+    usize_t i;
+    stat->entry_count = tab->count;
+    stat->string_size = 0;
+    stat->arena_used = 0;
+    stat->arena_capacity = 0;
+    stat->table_size = tab->capacity * (1 + sizeof(*tab->slots));
+    while (arena != NULL) {
+        stat->arena_used += arena->used;
+        stat->arena_capacity += arena->size;
+        arena = arena->next;
+    }
+    for (i = 0; i < tab->capacity; i += 1) {
+        if (tab->ctrl[i] != CTRL_EMPTY) {
+            stat->string_size += tab->slots[i]->view.count;
+        }
+    }
+}
+
+MSTR_EXPORT_API(void) mstr_intern_free(MStrInternTable* tab)
+{
+    MStrInternArena* arena = tab->arena;
+    while (arena != NULL) {
+        MStrInternArena* next = arena->next;
+        mstr_heap_free(arena);
+        arena = next;
+    }
+    if (tab->ctrl != NULL) {
+        mstr_heap_free(tab->ctrl);
+    }
+    if (tab->slots != NULL) {
+        mstr_heap_free(tab->slots);
+    }
+    mstr_intern_init(tab, tab->arena_size);
+}
+
+/**
+ * @brief 查找内容相同的字符串
+ *
+ * @return const MStrInterned*: 找到的字符串, 没有时返回NULL
+ */
+static const MStrInterned* intern_find(
+    const MStrInternTable* tab, const MStringView* view, uint64_t hash
+)
+{
+    usize_t group_mask;
+    usize_t group;
+    usize_t step = 0;
+    uint8_t h2 = HASH_CTRL(hash);
+    if (tab->capacity == 0) {
+        return NULL;
+    }
+    group_mask = tab->capacity / MSTR_INTERN_GROUP_SIZE - 1;
+    group = HASH_GROUP(hash) & group_mask;
+    // 按照组做三角数探测, 组的数目是2^n时可以遍历所有的组
+    for (;;) {
+        usize_t base = group * MSTR_INTERN_GROUP_SIZE;
+        uint32_t match, empty;
+        intern_group_match(tab->ctrl + base, h2, &match, &empty);
+        while (match != 0) {
+            usize_t bit = intern_first_bit(match);
+            const MStrInterned* entry = tab->slots[base + bit];
+            const MStringView* ev = &entry->view;
+            if (entry->hash == hash && ev->count == view->count &&
+                memcmp(ev->buff, view->buff, view->count) == 0) {
+                return entry;
+            }
+            match &= match - 1;
+        }
+        if (empty != 0) {
+            // 负载因子小于1, 所以总能遇到空槽
+            return NULL;
+        }
+        step += 1;
+        group = (group + step) & group_mask;
+    }
+}
+
+/**
+ * @brief 比较一组控制字节
+ *
+ * @param[in] ctrl: 这一组的控制字节
+ * @param[in] h2: 需要查找的控制字节
+ * @param[out] match: 和h2相同的槽的位掩码
+ * @param[out] empty: 空槽的位掩码
+ */
+static void intern_group_match(
+    const uint8_t* ctrl, uint8_t h2, uint32_t* match, uint32_t* empty
+)
+{
+#if _MSTR_USE_SIMD_SSE2
+    __m128i x = _mm_loadu_si128((const __m128i*)ctrl);
+    __m128i m = _mm_cmpeq_epi8(x, _mm_set1_epi8((char)h2));
+    *match = (uint32_t)_mm_movemask_epi8(m);
+    *empty = (uint32_t)_mm_movemask_epi8(x);
+#else
+    usize_t i;
+    uint32_t m = 0;
+    uint32_t e = 0;
+    for (i = 0; i < MSTR_INTERN_GROUP_SIZE; i += 1) {
+        m |= (uint32_t)(ctrl[i] == h2) << i;
+        e |= (uint32_t)(ctrl[i] >> 7) << i;
+    }
+    *match = m;
+    *empty = e;
+#endif // _MSTR_USE_SIMD_SSE2
+}
+
+/**
+ * @brief 取得最低的1的位置
+ *
+ */
+static usize_t intern_first_bit(uint32_t mask)
+{
+#if MSTR_BUILD_CC == MSTR_BUILD_CC_GNUC
+    return (usize_t)__builtin_ctz(mask);
+#else
+    usize_t bit = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        bit += 1;
+    }
+    return bit;
+#endif // MSTR_BUILD_CC
+}
+
+/**
+ * @brief 把字符串放到第一个空槽
+ *
+ * @attention 调用之前需要保证表中有空槽
+ */
+static void intern_place(
+    uint8_t* ctrl,
+    const MStrInterned** slots,
+    usize_t capacity,
+    const MStrInterned* entry
+)
+{
+    usize_t group_mask = capacity / MSTR_INTERN_GROUP_SIZE - 1;
+    usize_t group = HASH_GROUP(entry->hash) & group_mask;
+    usize_t step = 0;
+    uint8_t h2 = HASH_CTRL(entry->hash);
+    for (;;) {
+        usize_t base = group * MSTR_INTERN_GROUP_SIZE;
+        uint32_t match, empty;
+        intern_group_match(ctrl + base, h2, &match, &empty);
+        if (empty != 0) {
+            usize_t idx = base + intern_first_bit(empty);
+            ctrl[idx] = h2;
+            slots[idx] = entry;
+            return;
+        }
+        step += 1;
+        group = (group + step) & group_mask;
+    }
+}
+
+/**
+ * @brief 扩大哈希表, 并重新放置所有的字符串
+ *
+ */
+static mstr_result_t intern_grow(MStrInternTable* tab)
+{
+    usize_t new_cap = tab->capacity == 0 ? MSTR_INTERN_GROUP_SIZE
+                                          : tab->capacity * 2;
+    uint8_t* new_ctrl = (uint8_t*)mstr_heap_alloc(new_cap);
+    const MStrInterned** new_slots;
+    usize_t i;
+    if (new_ctrl == NULL) {
+        return MStr_Err_HeapTooSmall;
+    }
+    new_slots = (const MStrInterned**)mstr_heap_alloc(
+        new_cap * sizeof(*new_slots)
+    );
+    if (new_slots == NULL) {
+        mstr_heap_free(new_ctrl);
+        return MStr_Err_HeapTooSmall;
+    }
+    memset(new_ctrl, CTRL_EMPTY, new_cap);
+    for (i = 0; i < tab->capacity; i += 1) {
+        if (tab->ctrl[i] != CTRL_EMPTY) {
+            intern_place(new_ctrl, new_slots, new_cap, tab->slots[i]);
+        }
+    }
+    if (tab->ctrl != NULL) {
+        mstr_heap_free(tab->ctrl);
+        mstr_heap_free(tab->slots);
+    }
+    tab->ctrl = new_ctrl;
+    tab->slots = new_slots;
+    tab->capacity = new_cap;
+    return MStr_Ok;
+}
+
+/**
+ * @brief 在arena中分配内存
+ *
+ * @note 超过块大小的字符串单独使用一个块,
+ * 放在当前块的后面, 当前块可以继续使用
+ *
+ * @return MStrInterned*: 分配的内存, 失败时返回NULL
+ */
+static MStrInterned*
+    intern_arena_alloc(MStrInternTable* tab, usize_t size)
+{
+    MStrInternArena* arena = tab->arena;
+    usize_t need = ARENA_ROUND_UP(size);
+    usize_t arena_size;
+    if (arena != NULL && arena->size - arena->used >= need) {
+        char* ptr = (char*)arena + ARENA_DATA_OFFSET + arena->used;
+        arena->used += need;
+        return (MStrInterned*)ptr;
+    }
+    arena_size = need > tab->arena_size ? need : tab->arena_size;
+    arena = (MStrInternArena*)mstr_heap_alloc(
+        ARENA_DATA_OFFSET + arena_size
+    );
+    if (arena == NULL) {
+        return NULL;
+    }
+    arena->size = arena_size;
+    arena->used = need;
+    if (need > tab->arena_size && tab->arena != NULL) {
+        // 单独的块
+        arena->next = tab->arena->next;
+        tab->arena->next = arena;
+    }
+    else {
+        arena->next = tab->arena;
+        tab->arena = arena;
+    }
+    return (MStrInterned*)((char*)arena + ARENA_DATA_OFFSET);
+}
@@ -14,21 +14,243 @@
 
 #include "mm_fmt.h"
 #include "mm_type.h"
+#include <string.h>
+#if _MSTR_USE_SIMD_SSE2
+#include <emmintrin.h>
+#endif // _MSTR_USE_SIMD_SSE2
+
+/**
+ * @brief 整数数组格式化时每次处理的元素数目
+ *
+ */
+#define ARRAY_CHUNK_SIZE       16
+
+/**
+ * @brief 整数数组格式化时, 输出末尾需要多留出的空间
+ *
+ * @note 数字和短分隔符按定长写入, 多写的会被覆盖
+ */
+#define ARRAY_OUTPUT_SLACK     8
+
+/**
+ * @brief 十六进制转储时每行的字节数
+ *
+ */
+#define HEXDUMP_LINE_BYTES     16
+
+/**
+ * @brief 十六进制转储时一整行的字符数, 不包括换行
+ *
+ * @note `00000000  xx .. xx  xx .. xx  |................|`
+ */
+#define HEXDUMP_LINE_CHARS     78
+
+/**
+ * @brief 定点数和量化值整数部分最多的十进制位数
+ *
+ */
+#define FIXED_IPART_CHARS      20
+
+/**
+ * @brief 定点数和量化值小数部分最多的十进制位数
+ *
+ * @note fbits位的二进制小数最多有fbits个十进制位,
+ * 按照FIXED_BATCH_DIGITS向上取整
+ */
+#define FIXED_FPART_CHARS      64
+
+/**
+ * @brief 转换小数部分时每次得到的十进制位数
+ *
+ */
+#define FIXED_BATCH_DIGITS     8
+
+/**
+ * @brief 时间戳可以表示的最小值: 0000-01-01 00:00:00
+ *
+ */
+#define TIMESTAMP_MIN_SECOND   ((int64_t)-62167219200)
+
+/**
+ * @brief 时间戳可以表示的最大值: 9999-12-31 23:59:59
+ *
+ */
+#define TIMESTAMP_MAX_SECOND   ((int64_t)253402300799)
+
+/**
+ * @brief -0400-03-01 到 1970-01-01 的秒数
+ *
+ * @note 从-0400-03-01开始计算的话, 范围内的时间都不是负数,
+ * 而且闰日在一年的最后
+ */
+#define TIMESTAMP_EPOCH_OFFSET ((uint64_t)865565 * 86400)
+
+/**
+ * @brief 日期时间的一个项最多的字符数
+ *
+ */
+#define CHRONO_ITEM_CHARS      4
+
+#if _MSTR_USE_CHRONO_CACHE
+/**
+ * @brief 日期时间前缀缓存最多的字节数
+ *
+ * @note `%yyyy-%MM-%dd %HH:%mm:%ss.` 需要20个字节
+ */
+#define CHRONO_CACHE_PREFIX_CHARS 32
+
+/**
+ * @brief 日期时间前缀缓存中分隔符最多的字节数
+ *
+ */
+#define CHRONO_CACHE_SPLIT_CHARS  16
+
+/**
+ * @brief 缓存的前缀中一个项的格式
+ *
+ */
+typedef struct tagChronoCacheItem
+{
+    //! 值类型 (MStrFmtChronoValueType)
+    uint8_t value_type;
+
+    //! 是否以固定长度进行格式化
+    uint8_t fixed_length;
+
+    //! 进行格式化的长度
+    uint8_t format_length;
+
+    //! 分隔符的字节数
+    uint8_t split_count;
+} ChronoCacheItem;
+
+/**
+ * @brief 上一次格式化的日期时间前缀
+ *
+ */
+typedef struct tagChronoCacheState
+{
+    //! 前缀的项数, 为0表示没有缓存
+    usize_t item_cnt;
+
+    //! 前缀中每一个项的格式
+    ChronoCacheItem items[MFMT_CHRONO_PLACE_MAX_NUM];
+
+    //! 前缀中的分隔符, 按顺序保存
+    char splits[CHRONO_CACHE_SPLIT_CHARS];
+
+    //! 前缀对应的日期时间值, 不比较亚秒值
+    MStrTime time;
+
+    //! 前缀的字节数
+    usize_t count;
+
+    //! 前缀的字符数
+    usize_t length;
+
+    //! 前缀
+    char prefix[CHRONO_CACHE_PREFIX_CHARS];
+} ChronoCacheState;
+
+/**
+ * @brief 日期时间前缀缓存 (每个线程一份)
+ *
+ */
+static MSTR_THREAD_LOCAL ChronoCacheState chrono_cache;
+#endif // _MSTR_USE_CHRONO_CACHE
+
+/**
+ * @brief Base64的字母表
+ *
+ */
+static const char* const BASE64_ALPHABET =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+/**
+ * @brief Base32的字母表
+ *
+ */
+static const char* const BASE32_ALPHABET =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ234567";
+
 static mstr_result_t convert_sign_helper(
     MString*, int32_t, MStrFmtSignDisplay
 );
-static mstr_result_t uqtoa_impl(MString*, uint32_t, uint32_t);
-static mstr_result_t uqtoa_helper_dpart(MString*, uint32_t, uint32_t);
+static mstr_result_t fixed_bits_mask(uint32_t, uint32_t, uint32_t*);
+static mstr_result_t
+    ufixtoa_impl(MString*, uint64_t, uint32_t, int32_t);
+static uint32_t fixed_frac_mul(uint64_t*, uint32_t);
+static void fixed_batch_to_digits(char*, uint32_t);
 static mstr_result_t utoa_impl_2base(
     MString*, uint32_t, char, uint32_t
 );
 static mstr_result_t utoa_impl_10base(MString*, uint32_t);
-static mstr_result_t bcdtoa(
-    MString*, uint32_t, uint32_t, uint32_t, mstr_bool_t
+static char* chrono_write_item(
+    char*, const MStrTime*, const MStrFmtChronoItemFormatSpec*
+);
+static char* chrono_write_bcd(
+    char*, uint32_t, uint32_t, uint32_t, mstr_bool_t
+);
+static uint32_t bcd_to_ascii4(uint32_t);
+#if _MSTR_USE_CHRONO_CACHE
+static usize_t chrono_cache_load(
+    char**,
+    usize_t*,
+    const MStrTime*,
+    const MStrFmtChronoFormatSpec*,
+    usize_t
+);
+static void chrono_cache_store(
+    const char*,
+    const char*,
+    usize_t,
+    const MStrTime*,
+    const MStrFmtChronoFormatSpec*,
+    usize_t
+);
+#endif // _MSTR_USE_CHRONO_CACHE
+static void timestamp_days_to_civil(uint32_t, MStrTime*);
+static uint32_t bin_to_bcd2(uint32_t);
+static uint32_t bin_to_bcd4(uint32_t);
+static mstr_result_t array_split_length(
+    usize_t*, const char*, const char*
 );
+static usize_t array_max_digits(usize_t, MStrFmtIntIndex);
+static void array_load_chunk(
+    uint32_t*, char*, const void*, usize_t, MStrFmtArgType, const char*
+);
+static char* array_write_chunk_10base(
+    char*, const uint32_t*, const char*, usize_t, const char*, usize_t
+);
+static char* array_write_split(char*, const char*, usize_t);
+static mstr_result_t array_reserve(MString*, usize_t);
+static void array_blocks_to_digits(char*, const uint16_t*, usize_t);
+static char* array_write_chunk_2base(
+    char*,
+    const uint32_t*,
+    const char*,
+    usize_t,
+    MStrFmtIntIndex,
+    const char*,
+    usize_t
+);
+static mstr_result_t hexdump_bytes(
+    MString*, const byte_t*, usize_t, char, const char*, const char*
+);
+static mstr_result_t hexdump_canonical(
+    MString*, const byte_t*, usize_t
+);
+static void hexdump_chunk_to_hex(char*, const byte_t*, usize_t, char);
+static void hexdump_chunk_to_ascii(char*, const byte_t*, usize_t);
+static void base32_encode_group(char*, const byte_t*);
+#if _MSTR_USE_SIMD_SSE2
+static void base64_encode_chunk(char*, const byte_t*);
+#endif // _MSTR_USE_SIMD_SSE2
 static void div_mod_10(uint32_t, uint32_t*, uint32_t*);
+static void div_mod_10000(uint32_t, uint32_t*, uint32_t*);
 static void div_mod_10_u64(uint64_t, uint64_t*, uint32_t*);
 static uint32_t abs_u32(int32_t);
+static uint64_t abs_u64(int64_t);
 
 MSTR_EXPORT_API(mstr_result_t)
 mstr_fmt_itoa(
@@ -99,40 +321,115 @@ mstr_fmt_iqtoa(
     uint32_t quat,
     MStrFmtSignDisplay sign
 )
+{
+    if (quat > 31) {
+        // 32位的值最高支持q31
+        return MStr_Err_UnsupportQuantBits;
+    }
+    else {
+        return mstr_fmt_iq64toa(res_str, value, quat, -1, sign);
+    }
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_fmt_uqtoa(MString* res_str, uint32_t value, uint32_t quat)
+{
+    if (quat > 31) {
+        // 32位的值最高支持q31
+        return MStr_Err_UnsupportQuantBits;
+    }
+    else {
+        return mstr_fmt_uq64toa(res_str, value, quat, -1);
+    }
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_fmt_iq64toa(
+    MString* res_str,
+    int64_t value,
+    uint32_t quat,
+    int32_t precision,
+    MStrFmtSignDisplay sign
+)
 {
     mstr_result_t result = MStr_Ok;
+    int32_t sign_val = value < 0 ? -1 : (value > 0);
+    if (quat > 63 || quat == 0) {
+        // 最高支持q63
+        return MStr_Err_UnsupportQuantBits;
+    }
     // 转换符号
-    MSTR_AND_THEN(result, convert_sign_helper(res_str, value, sign));
-    // 转换无符号值
     MSTR_AND_THEN(
-        result, mstr_fmt_uqtoa(res_str, abs_u32(value), quat)
+        result, convert_sign_helper(res_str, sign_val, sign)
+    );
+    // 转换绝对值
+    MSTR_AND_THEN(
+        result, ufixtoa_impl(res_str, abs_u64(value), quat, precision)
     );
-    // 返回
     return result;
 }
 
 MSTR_EXPORT_API(mstr_result_t)
-mstr_fmt_uqtoa(MString* res_str, uint32_t value, uint32_t quat)
+mstr_fmt_uq64toa(
+    MString* res_str, uint64_t value, uint32_t quat, int32_t precision
+)
 {
-    if (quat > 31 || quat == 0) {
-        // 最高支持q31
+    if (quat > 63 || quat == 0) {
+        // 最高支持q63
         return MStr_Err_UnsupportQuantBits;
     }
     else {
-        MString buff;
-        mstr_result_t alloc_result;
-        mstr_result_t result = MStr_Ok;
-        MSTR_AND_THEN(result, mstr_create_empty(&buff));
-        alloc_result = result;
-        // 进行转换
-        MSTR_AND_THEN(result, uqtoa_impl(&buff, value, quat));
-        // 拼接到输出
-        MSTR_AND_THEN(result, mstr_concat(res_str, &buff));
-        if (MSTR_SUCC(alloc_result)) {
-            mstr_free(&buff);
-        }
-        return result;
+        return ufixtoa_impl(res_str, value, quat, precision);
+    }
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_fmt_ifixtoa(
+    MString* res_str,
+    int32_t value,
+    uint32_t ibits,
+    uint32_t fbits,
+    int32_t precision,
+    MStrFmtSignDisplay sign
+)
+{
+    uint32_t mask = 0;
+    mstr_result_t result = MStr_Ok;
+    MSTR_AND_THEN(result, fixed_bits_mask(ibits, fbits, &mask));
+    if (MSTR_SUCC(result)) {
+        uint32_t bits = (uint32_t)value & mask;
+        // 最高位是符号位
+        uint32_t sign_bit = (mask >> 1) + 1;
+        uint32_t mag = (bits & sign_bit) ? (0u - bits) & mask : bits;
+        int32_t sign_val = (bits & sign_bit) ? -1 : (bits != 0);
+        // 转换符号
+        MSTR_AND_THEN(
+            result, convert_sign_helper(res_str, sign_val, sign)
+        );
+        // 转换绝对值
+        MSTR_AND_THEN(
+            result, ufixtoa_impl(res_str, mag, fbits, precision)
+        );
     }
+    return result;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_fmt_ufixtoa(
+    MString* res_str,
+    uint32_t value,
+    uint32_t ibits,
+    uint32_t fbits,
+    int32_t precision
+)
+{
+    uint32_t mask = 0;
+    mstr_result_t result = MStr_Ok;
+    MSTR_AND_THEN(result, fixed_bits_mask(ibits, fbits, &mask));
+    MSTR_AND_THEN(
+        result, ufixtoa_impl(res_str, value & mask, fbits, precision)
+    );
+    return result;
 }
 
 MSTR_EXPORT_API(mstr_result_t)
@@ -142,73 +439,329 @@ mstr_fmt_ttoa(
     const MStrFmtChronoFormatSpec* spec
 )
 {
+    usize_t need_count = res_str->count;
+    usize_t length = 0;
+    usize_t split_length = 0;
     usize_t i = 0;
+    char* beg;
+    char* out;
     mstr_result_t result = MStr_Ok;
-    for (; i < spec->item_cnt && MSTR_SUCC(result); i += 1) {
+#if _MSTR_USE_CHRONO_CACHE
+    // 第一个亚秒值之前的项是可以缓存的前缀
+    usize_t prefix_cnt = spec->item_cnt;
+#endif // _MSTR_USE_CHRONO_CACHE
+    for (i = 0; i < spec->item_cnt; i += 1) {
         const MStrFmtChronoItemFormatSpec* item = &spec->items[i];
-        // 取得日期和时间的值
-        uint32_t value = 0;
-        uint32_t max_len = 0;
-        switch (item->value_type) {
-        case MStrFmtChronoValueType_Day:
-            value = tm->day;
-            max_len = 2;
-            break;
-        case MStrFmtChronoValueType_Year:
-            value = tm->year;
-            max_len = 4;
-            break;
-        case MStrFmtChronoValueType_Month:
-            value = tm->month;
-            max_len = 2;
-            break;
-        case MStrFmtChronoValueType_Hour24:
-            value = tm->hour;
-            max_len = 2;
-            break;
-        case MStrFmtChronoValueType_Minute:
-            value = tm->minute;
-            max_len = 2;
-            break;
-        case MStrFmtChronoValueType_Second:
-            value = tm->second;
-            max_len = 2;
-            break;
-        case MStrFmtChronoValueType_Hour:
-            value = tm->hour;
-            max_len = 2;
-            // TODO 转为12h制
-            break;
-        case MStrFmtChronoValueType_Week:
-            value = tm->week;
-            max_len = 1;
-            // TODO 转换星期名字
-            break;
-        case MStrFmtChronoValueType_SubSecond:
-            value = tm->sub_second;
-            max_len = 4;
-            break;
+        need_count += CHRONO_ITEM_CHARS;
+        need_count += (usize_t)(item->split_end - item->split_beg);
+#if _MSTR_USE_CHRONO_CACHE
+        if (item->value_type == MStrFmtChronoValueType_SubSecond &&
+            prefix_cnt == spec->item_cnt) {
+            prefix_cnt = i;
         }
-        // 格式化单个的项
-        MSTR_AND_THEN(
-            result,
-            bcdtoa(
-                res_str,
-                value,
-                item->chrono_spec.format_length,
-                max_len,
-                item->chrono_spec.fixed_length
-            )
-        );
+#endif // _MSTR_USE_CHRONO_CACHE
+    }
+    MSTR_AND_THEN(result, array_reserve(res_str, need_count));
+    if (MSTR_FAILED(result)) {
+        return result;
+    }
+    beg = res_str->buff + res_str->count;
+    out = beg;
+#if _MSTR_USE_CHRONO_CACHE
+    i = chrono_cache_load(&out, &length, tm, spec, prefix_cnt);
+#else
+    i = 0;
+#endif // _MSTR_USE_CHRONO_CACHE
+    for (; i < spec->item_cnt && MSTR_SUCC(result); i += 1) {
+        const MStrFmtChronoItemFormatSpec* item = &spec->items[i];
+        usize_t split_count =
+            (usize_t)(item->split_end - item->split_beg);
+        char* item_beg = out;
+        // 格式化单个的项, 都是ASCII字符
+        out = chrono_write_item(out, tm, item);
+        length += (usize_t)(out - item_beg);
         // 放入分隔符
-        if (item->split_beg != item->split_end) {
+        if (split_count > 0) {
             MSTR_AND_THEN(
                 result,
-                mstr_concat_cstr_slice(
-                    res_str, item->split_beg, item->split_end
+                array_split_length(
+                    &split_length, item->split_beg, item->split_end
                 )
             );
+            memcpy(out, item->split_beg, split_count);
+            out += split_count;
+            length += split_length;
+        }
+#if _MSTR_USE_CHRONO_CACHE
+        if (i + 1 == prefix_cnt && MSTR_SUCC(result)) {
+            chrono_cache_store(beg, out, length, tm, spec, prefix_cnt);
+        }
+#endif // _MSTR_USE_CHRONO_CACHE
+    }
+    if (MSTR_SUCC(result)) {
+        res_str->count += (usize_t)(out - beg);
+        res_str->length += length;
+    }
+    return result;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_fmt_tstoa(
+    MString* res_str,
+    const MStrTimestamp* ts,
+    const MStrFmtChronoFormatSpec* spec
+)
+{
+    MStrTime tm;
+    mstr_result_t result = mstr_time_from_timestamp(&tm, ts);
+    MSTR_AND_THEN(result, mstr_fmt_ttoa(res_str, &tm, spec));
+    return result;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_time_from_timestamp(MStrTime* tm, const MStrTimestamp* ts)
+{
+    uint64_t sec;
+    uint32_t days, sod, hour, minute, sub_second;
+    if (ts->second < TIMESTAMP_MIN_SECOND ||
+        ts->second > TIMESTAMP_MAX_SECOND ||
+        ts->nanosecond >= 1000000000) {
+        return MStr_Err_TimestampOutOfRange;
+    }
+    sec = (uint64_t)ts->second + TIMESTAMP_EPOCH_OFFSET;
+    // days = sec / 86400 = (sec / 128) / 675, sec / 128 < 2^32
+    days = (uint32_t)(((sec >> 7) * 3257812231u) >> 41);
+    sod = (uint32_t)(sec - (uint64_t)days * 86400);
+    // 时分秒, 都是乘法和移位
+    hour = (sod * 37283) >> 27;
+    sod -= hour * 3600;
+    minute = (sod * 2185) >> 17;
+    sod -= minute * 60;
+    // 亚秒值, 单位0.1ms: ns / 100000
+    sub_second =
+        (uint32_t)(((uint64_t)ts->nanosecond * 351843721) >> 45);
+    timestamp_days_to_civil(days, tm);
+    tm->hour = (uint8_t)bin_to_bcd2(hour);
+    tm->minute = (uint8_t)bin_to_bcd2(minute);
+    tm->second = (uint8_t)bin_to_bcd2(sod);
+    tm->sub_second = bin_to_bcd4(sub_second);
+    return MStr_Ok;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_fmt_arrtoa(
+    MString* res_str,
+    const void* array,
+    usize_t array_len,
+    MStrFmtArgType ele_type,
+    MStrFmtIntIndex index,
+    MStrFmtSignDisplay sign,
+    const char* split_beg,
+    const char* split_end
+)
+{
+    // 符号: [正数, 0, 负数]
+    char sign_chars[3] = {'\0', '\0', '-'};
+    uint32_t values[ARRAY_CHUNK_SIZE];
+    char signs[ARRAY_CHUNK_SIZE];
+    char split_buff[ARRAY_OUTPUT_SLACK] = {0};
+    const char* split = split_beg;
+    usize_t split_count = (usize_t)(split_end - split_beg);
+    usize_t split_length = 0;
+    usize_t ele_bits = 0, ele_max_count, offset;
+    mstr_result_t result = MStr_Ok;
+    switch (ele_type) {
+    case MStrFmtArgType_Int8:
+    case MStrFmtArgType_Uint8: ele_bits = 8; break;
+    case MStrFmtArgType_Int16:
+    case MStrFmtArgType_Uint16: ele_bits = 16; break;
+    case MStrFmtArgType_Int32:
+    case MStrFmtArgType_Uint32: ele_bits = 32; break;
+    default: return MStr_Err_UnsupportType;
+    }
+    switch (sign) {
+    case MStrFmtSignDisplay_Always: sign_chars[0] = '+'; break;
+    case MStrFmtSignDisplay_NegOnly: break;
+    case MStrFmtSignDisplay_Neg_Or_Space:
+        sign_chars[0] = ' ';
+        sign_chars[1] = ' ';
+        break;
+    }
+    MSTR_AND_THEN(
+        result, array_split_length(&split_length, split_beg, split_end)
+    );
+    if (split_count <= ARRAY_OUTPUT_SLACK) {
+        // 填充到固定长度
+        memcpy(split_buff, split_beg, split_count);
+        split = split_buff;
+    }
+    // 每个元素最多需要: 符号, 0x前缀, 数字和分隔符
+    ele_max_count = 1 + 2 + array_max_digits(ele_bits, index);
+    ele_max_count += split_count;
+    for (offset = 0; offset < array_len && MSTR_SUCC(result);
+         offset += ARRAY_CHUNK_SIZE) {
+        usize_t chunk_len = array_len - offset;
+        usize_t need_count;
+        if (chunk_len > ARRAY_CHUNK_SIZE) {
+            chunk_len = ARRAY_CHUNK_SIZE;
+        }
+        // 一次性扩展好空间, 之后直接写入
+        need_count = res_str->count + chunk_len * ele_max_count;
+        need_count += ARRAY_OUTPUT_SLACK;
+        result = array_reserve(res_str, need_count);
+        if (MSTR_SUCC(result)) {
+            char* beg = res_str->buff + res_str->count;
+            char* end = beg;
+            usize_t write_count;
+            array_load_chunk(
+                values,
+                signs,
+                (const byte_t*)array + offset * (ele_bits / 8),
+                chunk_len,
+                ele_type,
+                sign_chars
+            );
+            if (index == MStrFmtIntIndex_Dec) {
+                end = array_write_chunk_10base(
+                    beg,
+                    values,
+                    signs,
+                    chunk_len,
+                    split,
+                    split_count
+                );
+            }
+            else {
+                end = array_write_chunk_2base(
+                    beg,
+                    values,
+                    signs,
+                    chunk_len,
+                    index,
+                    split,
+                    split_count
+                );
+            }
+            // 除了分隔符以外都是ASCII字符
+            write_count = (usize_t)(end - beg);
+            res_str->count += write_count;
+            res_str->length += write_count;
+            res_str->length -= chunk_len * split_count;
+            res_str->length += chunk_len * split_length;
+        }
+    }
+    // 去掉最后一个分隔符
+    if (MSTR_SUCC(result) && array_len > 0) {
+        res_str->count -= split_count;
+        res_str->length -= split_length;
+    }
+    return result;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_fmt_hexdump(
+    MString* res_str,
+    const void* data,
+    usize_t data_len,
+    MStrFmtHexDumpStyle style,
+    const char* split_beg,
+    const char* split_end
+)
+{
+    const byte_t* bytes = (const byte_t*)data;
+    switch (style) {
+    case MStrFmtHexDumpStyle_Bytes:
+        return hexdump_bytes(
+            res_str, bytes, data_len, 'a', split_beg, split_end
+        );
+    case MStrFmtHexDumpStyle_Bytes_UpperCase:
+        return hexdump_bytes(
+            res_str, bytes, data_len, 'A', split_beg, split_end
+        );
+    case MStrFmtHexDumpStyle_Canonical:
+        return hexdump_canonical(res_str, bytes, data_len);
+    default: return MStr_Err_UnsupportFormatType;
+    }
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_fmt_base64(MString* res_str, const void* data, usize_t data_len)
+{
+    const byte_t* bytes = (const byte_t*)data;
+    usize_t out_len = (data_len + 2) / 3 * 4;
+    mstr_result_t result = MStr_Ok;
+    // 输出长度是确定的, 一次性分配好
+    MSTR_AND_THEN(
+        result, array_reserve(res_str, res_str->count + out_len)
+    );
+    if (MSTR_SUCC(result)) {
+        char* out = res_str->buff + res_str->count;
+        usize_t i = 0;
+#if _MSTR_USE_SIMD_SSE2
+        // 每次转换12个字节, 但是会读取16个字节
+        for (; i + 16 <= data_len; i += 12) {
+            base64_encode_chunk(out, bytes + i);
+            out += 16;
+        }
+#endif // _MSTR_USE_SIMD_SSE2
+        for (; i + 3 <= data_len; i += 3) {
+            uint32_t w = ((uint32_t)bytes[i] << 16) |
+                         ((uint32_t)bytes[i + 1] << 8) |
+                         (uint32_t)bytes[i + 2];
+            out[0] = BASE64_ALPHABET[(w >> 18) & 0x3f];
+            out[1] = BASE64_ALPHABET[(w >> 12) & 0x3f];
+            out[2] = BASE64_ALPHABET[(w >> 6) & 0x3f];
+            out[3] = BASE64_ALPHABET[w & 0x3f];
+            out += 4;
+        }
+        if (i < data_len) {
+            // 剩下1或2个字节, 使用'='补齐
+            uint32_t w = (uint32_t)bytes[i] << 16;
+            out[2] = '=';
+            out[3] = '=';
+            if (i + 1 < data_len) {
+                w |= (uint32_t)bytes[i + 1] << 8;
+                out[2] = BASE64_ALPHABET[(w >> 6) & 0x3f];
+            }
+            out[0] = BASE64_ALPHABET[(w >> 18) & 0x3f];
+            out[1] = BASE64_ALPHABET[(w >> 12) & 0x3f];
+        }
+        res_str->count += out_len;
+        res_str->length += out_len;
+    }
+    return result;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_fmt_base32(MString* res_str, const void* data, usize_t data_len)
+{
+    // 剩下n个字节时的有效字符数
+    static const uint8_t tail_chars[5] = {0, 2, 4, 5, 7};
+    const byte_t* bytes = (const byte_t*)data;
+    usize_t out_len = (data_len + 4) / 5 * 8;
+    mstr_result_t result = MStr_Ok;
+    MSTR_AND_THEN(
+        result, array_reserve(res_str, res_str->count + out_len)
+    );
+    if (MSTR_SUCC(result)) {
+        char* out = res_str->buff + res_str->count;
+        byte_t tail[5] = {0};
+        usize_t i = 0, j;
+        for (; i + 5 <= data_len; i += 5) {
+            // 每5个字节(40位)作为一组, 转换为8个字符
+            base32_encode_group(out, bytes + i);
+            out += 8;
+        }
+        if (i < data_len) {
+            // 剩下不足5个字节, 使用'='补齐
+            memcpy(tail, bytes + i, data_len - i);
+            base32_encode_group(out, tail);
+            for (j = tail_chars[data_len - i]; j < 8; j += 1) {
+                out[j] = '=';
+            }
         }
+        res_str->count += out_len;
+        res_str->length += out_len;
     }
     return result;
 }
@@ -322,156 +875,1132 @@ static mstr_result_t utoa_impl_2base(
 }
 
 /**
- * @brief 量化值的格式化实现
+ * @brief 计算数组分隔符的字符长度
  *
- * @attention 最大支持的quat值是31, 外部需要保证参数正确
+ * @param[out] length: 字符长度
+ * @param[in] beg: 分隔符开始
+ * @param[in] end: 分隔符结束
  */
-static mstr_result_t uqtoa_impl(
-    MString* str, uint32_t value, uint32_t quat
+static mstr_result_t array_split_length(
+    usize_t* length, const char* beg, const char* end
 )
 {
-    mstr_result_t result = MStr_Ok;
-    if (value == 0) {
-        // 值是0
-        MSTR_AND_THEN(result, mstr_append(str, '0'));
-    }
-    else {
-        uint32_t ipart = value >> quat;
-        uint32_t dpart = value & ((1 << quat) - 1);
-        // 转换整数部分
-        MSTR_AND_THEN(result, utoa_impl_10base(str, ipart));
-        // 转换小数部分
-        if (dpart > 0) {
-            // 小数点
-            MSTR_AND_THEN(result, mstr_append(str, '.'));
-            // 小数部分
-            MSTR_AND_THEN(result, uqtoa_helper_dpart(str, dpart, quat));
-        }
+#if _MSTR_USE_UTF_8
+    usize_t len = 0;
+    while (beg < end) {
+        beg += mstr_char_length(*beg);
+        len += 1;
     }
-    return result;
+    *length = len;
+    // 分隔符的编码不完整
+    return beg == end ? MStr_Ok : MStr_Err_EncodingNotCompleted;
+#else
+    *length = (usize_t)(end - beg);
+    return MStr_Ok;
+#endif // _MSTR_USE_UTF_8
 }
 
 /**
- * @brief 转换量化值的小数部分
+ * @brief 计算ele_bits位的整数最多需要的数字个数
  *
  */
-static mstr_result_t uqtoa_helper_dpart(
-    MString* str, uint32_t value, uint32_t quat
+static usize_t array_max_digits(usize_t ele_bits, MStrFmtIntIndex index)
+{
+    switch (index) {
+    case MStrFmtIntIndex_Bin: return ele_bits;
+    case MStrFmtIntIndex_Oct: return (ele_bits + 2) / 3;
+    case MStrFmtIntIndex_Dec:
+        return ele_bits == 8 ? 3 : ele_bits == 16 ? 5 : 10;
+    default: return ele_bits / 4;
+    }
+}
+
+/**
+ * @brief 读取一段数组元素, 转换为绝对值和符号
+ *
+ * @param[out] values: 元素的绝对值
+ * @param[out] signs: 元素的符号, '\0'表示没有符号
+ * @param[in] array: 数组的开始位置
+ * @param[in] len: 元素个数
+ * @param[in] ele_type: 元素类型
+ * @param[in] sign_chars: 正数, 0和负数使用的符号
+ */
+static void array_load_chunk(
+    uint32_t* values,
+    char* signs,
+    const void* array,
+    usize_t len,
+    MStrFmtArgType ele_type,
+    const char* sign_chars
 )
 {
-    MString buff;
-    mstr_result_t result = MStr_Ok;
-    result = mstr_create_empty(&buff);
-    if (value == 0) {
-        // 值是0
-        MSTR_AND_THEN(result, mstr_append(&buff, '0'));
+    usize_t i;
+    switch (ele_type) {
+    case MStrFmtArgType_Uint8:
+        for (i = 0; i < len; i += 1) {
+            values[i] = ((const uint8_t*)array)[i];
+        }
+        break;
+    case MStrFmtArgType_Uint16:
+        for (i = 0; i < len; i += 1) {
+            values[i] = ((const uint16_t*)array)[i];
+        }
+        break;
+    case MStrFmtArgType_Uint32:
+        for (i = 0; i < len; i += 1) {
+            values[i] = ((const uint32_t*)array)[i];
+        }
+        break;
+    case MStrFmtArgType_Int8:
+        for (i = 0; i < len; i += 1) {
+            int32_t v = ((const int8_t*)array)[i];
+            signs[i] = sign_chars[v > 0 ? 0 : v == 0 ? 1 : 2];
+            values[i] = abs_u32(v);
+        }
+        return;
+    case MStrFmtArgType_Int16:
+        for (i = 0; i < len; i += 1) {
+            int32_t v = ((const int16_t*)array)[i];
+            signs[i] = sign_chars[v > 0 ? 0 : v == 0 ? 1 : 2];
+            values[i] = abs_u32(v);
+        }
+        return;
+    case MStrFmtArgType_Int32:
+        for (i = 0; i < len; i += 1) {
+            int32_t v = ((const int32_t*)array)[i];
+            signs[i] = sign_chars[v > 0 ? 0 : v == 0 ? 1 : 2];
+            values[i] = abs_u32(v);
+        }
+        return;
+    default: mstr_unreachable(); break;
+    }
+    // 无符号数没有符号
+    memset(signs, 0, len);
+}
+
+/**
+ * @brief 把一段数组元素转为十进制 (带分隔符)
+ *
+ * @param[out] out: 输出, 需要保证空间足够,
+ * 并且在末尾多留出 ARRAY_OUTPUT_SLACK 字节
+ * @param[in] values: 元素的绝对值
+ * @param[in] signs: 元素的符号
+ * @param[in] len: 元素个数, 不超过 ARRAY_CHUNK_SIZE
+ * @param[in] split: 分隔符
+ * @param[in] split_count: 分隔符的字节数
+ *
+ * @return char*: 输出的结束位置
+ */
+static char* array_write_chunk_10base(
+    char* out,
+    const uint32_t* values,
+    const char* signs,
+    usize_t len,
+    const char* split,
+    usize_t split_count
+)
+{
+    // 每个值拆为最多3个4位十进制数的块
+    uint16_t blocks[ARRAY_CHUNK_SIZE * 3];
+    char digits[(ARRAY_CHUNK_SIZE * 3 + 2) * 4];
+    uint8_t block_cnt[ARRAY_CHUNK_SIZE];
+    uint8_t first_len[ARRAY_CHUNK_SIZE];
+    usize_t i, block_len = 0;
+    const char* it;
+    for (i = 0; i < len; i += 1) {
+        uint32_t value = values[i];
+        uint32_t high, low;
+        if (value < 10000) {
+            blocks[block_len] = (uint16_t)value;
+            block_len += 1;
+            block_cnt[i] = 1;
+        }
+        else if (value < 100000000) {
+            div_mod_10000(value, &high, &low);
+            blocks[block_len] = (uint16_t)high;
+            blocks[block_len + 1] = (uint16_t)low;
+            block_len += 2;
+            block_cnt[i] = 2;
+            value = high;
+        }
+        else {
+            uint32_t mid;
+            div_mod_10000(value, &high, &low);
+            div_mod_10000(high, &high, &mid);
+            blocks[block_len] = (uint16_t)high;
+            blocks[block_len + 1] = (uint16_t)mid;
+            blocks[block_len + 2] = (uint16_t)low;
+            block_len += 3;
+            block_cnt[i] = 3;
+            value = high;
+        }
+        first_len[i] = (uint8_t)(value < 10     ? 1
+                                 : value < 100  ? 2
+                                 : value < 1000 ? 3
+                                                : 4);
+    }
+    // 批量转换为定长的数字
+    array_blocks_to_digits(digits, blocks, block_len);
+    // 去掉前导0, 并加上符号和分隔符
+    it = digits;
+    for (i = 0; i < len; i += 1) {
+        if (signs[i] != '\0') {
+            *out = signs[i];
+            out += 1;
+        }
+        // 首块, 以及后面最多2个块
+        memcpy(out, it + 4 - first_len[i], 4);
+        out += first_len[i];
+        it += 4;
+        memcpy(out, it, 8);
+        out += (block_cnt[i] - 1) * 4;
+        it += (block_cnt[i] - 1) * 4;
+        out = array_write_split(out, split, split_count);
+    }
+    return out;
+}
+
+/**
+ * @brief 写入分隔符
+ *
+ * @param[out] out: 输出
+ * @param[in] split: 分隔符, 长度不超过 ARRAY_OUTPUT_SLACK 时,
+ * 需要填充到 ARRAY_OUTPUT_SLACK 字节
+ * @param[in] split_count: 分隔符的字节数
+ *
+ * @return char*: 输出的结束位置
+ */
+static char* array_write_split(
+    char* out, const char* split, usize_t split_count
+)
+{
+    if (split_count <= ARRAY_OUTPUT_SLACK) {
+        // 固定长度的复制比变长的memcpy更快
+        memcpy(out, split, ARRAY_OUTPUT_SLACK);
     }
     else {
-        uint32_t p5;
-        uint64_t acc;
-        uint32_t mask;
-        usize_t cv_sz = 0;
-        mstr_bool_t tail_0 = True;
-        uint64_t dpart_value;
-        usize_t fill_len;
-        // 转换值
-        // 因为2^-1 = 0.5, 2^-2 = 0.25 ...
-        // 也就是5, 25, 125 ...
-        // 即5的幂次, 因此这尝试用5的幂次来完成计算
-        // 这样子的话, 就可以避免 / 4096 什么的啦
-        p5 = 1;
-        acc = 0;
-        mask = 1 << (quat - 1);
-        while (mask > 0) {
-            p5 *= 5;
-            acc *= 10;
-            if ((value & mask) == mask) {
-                acc += p5;
-            }
-            mask >>= 1;
+        memcpy(out, split, split_count);
+    }
+    return out + split_count;
+}
+
+/**
+ * @brief 一次性扩展好输出的空间
+ *
+ * @param[inout] str: 输出
+ * @param[in] need_count: 需要的字节数, 不包括末尾的'\0'
+ */
+static mstr_result_t array_reserve(MString* str, usize_t need_count)
+{
+    usize_t new_size = str->cap_size;
+    if (need_count >= new_size) {
+        new_size = str->cap_size * 2;
+        if (new_size < need_count + 1) {
+            new_size = need_count + 1;
         }
-        // 把累加出来的值变成字符串
-        dpart_value = acc;
-        while (dpart_value > 0) {
-            char ch;
-            uint32_t digit;
-            uint64_t next_value;
-            div_mod_10_u64(dpart_value, &next_value, &digit);
-            // 转换为字符
-            ch = (char)('0' + digit);
-            // 消除后缀多余的0, 然后push char
-            if (digit != 0 || !tail_0) {
-                // push char
-                MSTR_AND_THEN(result, mstr_append(&buff, ch));
-                if (MSTR_FAILED(result)) {
-                    break;
+    }
+    // 容量足够时也要调用, 保证内存区不和其它字符串共享
+    return mstr_reserve(str, new_size);
+}
+
+/**
+ * @brief 把4位十进制数的块转换为4个数字字符
+ *
+ * @param[out] digits: 输出, 每个块占4个字节
+ * @param[in] blocks: 块, 值都小于10000
+ * @param[in] len: 块的个数
+ *
+ * @note 不使用除法: x / 100 = (x * 5243) >> 19, y / 10 = (y * 103)
+ * >> 10, 在x < 10000, y < 100 时结果是准确的. 使用SWAR,
+ * 在一个32位整数中同时处理2个16位的lane; 如果有SSE2,
+ * 一次处理8个块
+ */
+static void array_blocks_to_digits(
+    char* digits, const uint16_t* blocks, usize_t len
+)
+{
+    usize_t i = 0;
+#if _MSTR_USE_SIMD_SSE2
+    const __m128i c_5243 = _mm_set1_epi16(5243);
+    const __m128i c_6554 = _mm_set1_epi16(6554);
+    const __m128i c_100 = _mm_set1_epi16(100);
+    const __m128i c_10 = _mm_set1_epi16(10);
+    const __m128i c_zero = _mm_set1_epi8('0');
+    for (; i + 8 <= len; i += 8) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(blocks + i));
+        // 前2位和后2位
+        __m128i hi = _mm_srli_epi16(_mm_mulhi_epu16(x, c_5243), 3);
+        __m128i lo = _mm_sub_epi16(x, _mm_mullo_epi16(hi, c_100));
+        // 每2位中的十位 ((y * 6554) >> 16 = y / 10) 和个位
+        __m128i hi_t = _mm_mulhi_epu16(hi, c_6554);
+        __m128i lo_t = _mm_mulhi_epu16(lo, c_6554);
+        __m128i hi_o = _mm_sub_epi16(hi, _mm_mullo_epi16(hi_t, c_10));
+        __m128i lo_o = _mm_sub_epi16(lo, _mm_mullo_epi16(lo_t, c_10));
+        __m128i a = _mm_or_si128(hi_t, _mm_slli_epi16(hi_o, 8));
+        __m128i b = _mm_or_si128(lo_t, _mm_slli_epi16(lo_o, 8));
+        // 交错得到每个块的4个字节
+        __m128i r0 = _mm_add_epi8(_mm_unpacklo_epi16(a, b), c_zero);
+        __m128i r1 = _mm_add_epi8(_mm_unpackhi_epi16(a, b), c_zero);
+        _mm_storeu_si128((__m128i*)(digits + i * 4), r0);
+        _mm_storeu_si128((__m128i*)(digits + i * 4 + 16), r1);
+    }
+#endif // _MSTR_USE_SIMD_SSE2
+    for (; i < len; i += 1) {
+        uint32_t x = blocks[i];
+        uint32_t hi = (x * 5243) >> 19;
+        // lane: [x / 100, x % 100]
+        uint32_t w = hi | ((x - hi * 100) << 16);
+        // lane: [十位, 个位]
+        uint32_t t = ((w * 103) >> 10) & 0x000f000f;
+        uint32_t d = (t | ((w - t * 10) << 8)) + 0x30303030;
+        char* p = digits + i * 4;
+        p[0] = (char)(d & 0xff);
+        p[1] = (char)((d >> 8) & 0xff);
+        p[2] = (char)((d >> 16) & 0xff);
+        p[3] = (char)((d >> 24) & 0xff);
+    }
+}
+
+/**
+ * @brief 把一段数组元素转为2, 8, 16进制 (带分隔符)
+ *
+ * @param[out] out: 输出, 需要保证空间足够
+ * @param[in] values: 元素的绝对值
+ * @param[in] signs: 元素的符号
+ * @param[in] len: 元素个数
+ * @param[in] index: 进制
+ * @param[in] split: 分隔符
+ * @param[in] split_count: 分隔符的字节数
+ *
+ * @return char*: 输出的结束位置
+ */
+static char* array_write_chunk_2base(
+    char* out,
+    const uint32_t* values,
+    const char* signs,
+    usize_t len,
+    MStrFmtIntIndex index,
+    const char* split,
+    usize_t split_count
+)
+{
+    const char* prefix = "";
+    uint32_t shift = 4;
+    char hex_base = 'a';
+    usize_t prefix_count, i;
+    switch (index) {
+    case MStrFmtIntIndex_Bin: shift = 1; break;
+    case MStrFmtIntIndex_Oct: shift = 3; break;
+    case MStrFmtIntIndex_Hex_WithPrefix: prefix = "0x"; break;
+    case MStrFmtIntIndex_Hex_UpperCase: hex_base = 'A'; break;
+    case MStrFmtIntIndex_Hex_UpperCase_WithPrefix:
+        prefix = "0X";
+        hex_base = 'A';
+        break;
+    default: break;
+    }
+    prefix_count = prefix[0] == '\0' ? 0 : 2;
+    for (i = 0; i < len; i += 1) {
+        uint32_t value = values[i];
+        uint32_t digits = 1;
+        char* it;
+        if (signs[i] != '\0') {
+            *out = signs[i];
+            out += 1;
+        }
+        memcpy(out, prefix, prefix_count);
+        out += prefix_count;
+        // 数字的个数
+        while (digits * shift < 32 &&
+               (value >> (digits * shift)) != 0) {
+            digits += 1;
+        }
+        // 从后往前写入
+        it = out + digits;
+        out = it;
+        do {
+            uint32_t digit = value & ((1u << shift) - 1);
+            value >>= shift;
+            it -= 1;
+            if (digit >= 10) {
+                *it = (char)(hex_base + digit - 10);
+            }
+            else {
+                *it = (char)('0' + digit);
+            }
+        } while (value > 0);
+        out = array_write_split(out, split, split_count);
+    }
+    return out;
+}
+
+/**
+ * @brief 把字节数组转为十六进制字符, 并插入分隔符
+ *
+ * @param[out] res_str: 输出
+ * @param[in] data: 字节数组
+ * @param[in] data_len: 字节数
+ * @param[in] hex_base: 十六进制的'a'或者'A'
+ * @param[in] split_beg: 分隔符的开始
+ * @param[in] split_end: 分隔符的结束
+ */
+static mstr_result_t hexdump_bytes(
+    MString* res_str,
+    const byte_t* data,
+    usize_t data_len,
+    char hex_base,
+    const char* split_beg,
+    const char* split_end
+)
+{
+    char hex[HEXDUMP_LINE_BYTES * 2];
+    char split_buff[ARRAY_OUTPUT_SLACK] = {0};
+    const char* split = split_beg;
+    usize_t split_count = (usize_t)(split_end - split_beg);
+    usize_t split_length = 0;
+    usize_t need_count, offset, i;
+    mstr_result_t result = MStr_Ok;
+    MSTR_AND_THEN(
+        result, array_split_length(&split_length, split_beg, split_end)
+    );
+    if (MSTR_FAILED(result) || data_len == 0) {
+        return result;
+    }
+    if (split_count <= ARRAY_OUTPUT_SLACK) {
+        // 填充到固定长度
+        memcpy(split_buff, split_beg, split_count);
+        split = split_buff;
+    }
+    need_count = res_str->count + data_len * (2 + split_count);
+    need_count += ARRAY_OUTPUT_SLACK;
+    MSTR_AND_THEN(result, array_reserve(res_str, need_count));
+    if (MSTR_SUCC(result)) {
+        char* beg = res_str->buff + res_str->count;
+        char* out = beg;
+        for (offset = 0; offset < data_len;
+             offset += HEXDUMP_LINE_BYTES) {
+            usize_t chunk_len = data_len - offset;
+            if (chunk_len > HEXDUMP_LINE_BYTES) {
+                chunk_len = HEXDUMP_LINE_BYTES;
+            }
+            hexdump_chunk_to_hex(
+                hex, data + offset, chunk_len, hex_base
+            );
+            if (split_count == 0) {
+                // 连续的十六进制字符
+                memcpy(out, hex, chunk_len * 2);
+                out += chunk_len * 2;
+            }
+            else {
+                for (i = 0; i < chunk_len; i += 1) {
+                    memcpy(out, hex + i * 2, 2);
+                    out = array_write_split(
+                        out + 2, split, split_count
+                    );
                 }
-                // 标记其不是0后缀
-                tail_0 = False;
             }
-            cv_sz += 1;
-            dpart_value = next_value;
-        }
-        // 补全前导0
-        fill_len = quat - cv_sz;
-        while (fill_len > 0) {
-            MSTR_AND_THEN(result, mstr_append(&buff, '0'));
-            fill_len -= 1;
-            if (MSTR_FAILED(result)) {
-                break;
+        }
+        // 去掉最后一个分隔符, 其余都是ASCII字符
+        out -= split_count;
+        res_str->count += (usize_t)(out - beg);
+        res_str->length += data_len * 2;
+        res_str->length += (data_len - 1) * split_length;
+    }
+    return result;
+}
+
+/**
+ * @brief 按照`hexdump -C`的格式转储字节数组
+ *
+ * @param[out] res_str: 输出
+ * @param[in] data: 字节数组
+ * @param[in] data_len: 字节数
+ */
+static mstr_result_t hexdump_canonical(
+    MString* res_str, const byte_t* data, usize_t data_len
+)
+{
+    char hex[HEXDUMP_LINE_BYTES * 2];
+    byte_t offset_bytes[4];
+    usize_t line_cnt, need_count, offset, i;
+    mstr_result_t result = MStr_Ok;
+    if (data_len == 0) {
+        return MStr_Ok;
+    }
+    line_cnt = (data_len + HEXDUMP_LINE_BYTES - 1) / HEXDUMP_LINE_BYTES;
+    need_count = res_str->count + line_cnt * (HEXDUMP_LINE_CHARS + 1);
+    need_count += ARRAY_OUTPUT_SLACK;
+    MSTR_AND_THEN(result, array_reserve(res_str, need_count));
+    if (MSTR_SUCC(result)) {
+        char* beg = res_str->buff + res_str->count;
+        char* out = beg;
+        for (offset = 0; offset < data_len;
+             offset += HEXDUMP_LINE_BYTES) {
+            usize_t chunk_len = data_len - offset;
+            if (chunk_len > HEXDUMP_LINE_BYTES) {
+                chunk_len = HEXDUMP_LINE_BYTES;
+            }
+            // 偏移量, 8个十六进制字符
+            offset_bytes[0] = (byte_t)((offset >> 24) & 0xff);
+            offset_bytes[1] = (byte_t)((offset >> 16) & 0xff);
+            offset_bytes[2] = (byte_t)((offset >> 8) & 0xff);
+            offset_bytes[3] = (byte_t)(offset & 0xff);
+            hexdump_chunk_to_hex(out, offset_bytes, 4, 'a');
+            memset(out + 8, ' ', HEXDUMP_LINE_CHARS - 8);
+            // 十六进制值, 8个字节一组
+            hexdump_chunk_to_hex(hex, data + offset, chunk_len, 'a');
+            for (i = 0; i < chunk_len; i += 1) {
+                char* p = out + 10 + i * 3 + (i >= 8 ? 1 : 0);
+                p[0] = hex[i * 2];
+                p[1] = hex[i * 2 + 1];
             }
+            // ASCII
+            out[60] = '|';
+            hexdump_chunk_to_ascii(out + 61, data + offset, chunk_len);
+            out[61 + chunk_len] = '|';
+            out[62 + chunk_len] = '\n';
+            out += 63 + chunk_len;
         }
-        // 翻转结果
-        if (MSTR_SUCC(result)) {
-            mstr_reverse_only(&buff);
+        // 去掉最后一个换行
+        out -= 1;
+        res_str->count += (usize_t)(out - beg);
+        res_str->length += (usize_t)(out - beg);
+    }
+    return result;
+}
+
+/**
+ * @brief 把最多 HEXDUMP_LINE_BYTES 个字节转为十六进制字符
+ *
+ * @param[out] hex: 输出, 每个字节占2个字符
+ * @param[in] bytes: 字节
+ * @param[in] len: 字节数
+ * @param[in] hex_base: 十六进制的'a'或者'A'
+ *
+ * @note 有SSE2时一次转换16个字节,
+ * 大于9的nibble需要加上到hex_base的偏移量
+ */
+static void hexdump_chunk_to_hex(
+    char* hex, const byte_t* bytes, usize_t len, char hex_base
+)
+{
+    usize_t i;
+#if _MSTR_USE_SIMD_SSE2
+    if (len == HEXDUMP_LINE_BYTES) {
+        const __m128i c_0f = _mm_set1_epi8(0x0f);
+        const __m128i c_9 = _mm_set1_epi8(9);
+        const __m128i c_zero = _mm_set1_epi8('0');
+        const __m128i c_alpha =
+            _mm_set1_epi8((char)(hex_base - '0' - 10));
+        __m128i x = _mm_loadu_si128((const __m128i*)bytes);
+        __m128i hi = _mm_and_si128(_mm_srli_epi16(x, 4), c_0f);
+        __m128i lo = _mm_and_si128(x, c_0f);
+        __m128i hi_a = _mm_and_si128(_mm_cmpgt_epi8(hi, c_9), c_alpha);
+        __m128i lo_a = _mm_and_si128(_mm_cmpgt_epi8(lo, c_9), c_alpha);
+        hi = _mm_add_epi8(_mm_add_epi8(hi, c_zero), hi_a);
+        lo = _mm_add_epi8(_mm_add_epi8(lo, c_zero), lo_a);
+        // 交错得到 [hi, lo, hi, lo, ...]
+        _mm_storeu_si128((__m128i*)hex, _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(
+            (__m128i*)(hex + 16), _mm_unpackhi_epi8(hi, lo)
+        );
+        return;
+    }
+#endif // _MSTR_USE_SIMD_SSE2
+    for (i = 0; i < len; i += 1) {
+        uint32_t hi = (uint32_t)(bytes[i] >> 4);
+        uint32_t lo = (uint32_t)(bytes[i] & 0x0f);
+        hex[i * 2] = (char)(hi < 10 ? '0' + hi : hex_base + hi - 10);
+        hex[i * 2 + 1] =
+            (char)(lo < 10 ? '0' + lo : hex_base + lo - 10);
+    }
+}
+
+/**
+ * @brief 把最多 HEXDUMP_LINE_BYTES 个字节转为ASCII字符
+ *
+ * @param[out] out: 输出
+ * @param[in] bytes: 字节
+ * @param[in] len: 字节数
+ *
+ * @note 不可打印的字符显示为'.'
+ */
+static void hexdump_chunk_to_ascii(
+    char* out, const byte_t* bytes, usize_t len
+)
+{
+    usize_t i;
+#if _MSTR_USE_SIMD_SSE2
+    if (len == HEXDUMP_LINE_BYTES) {
+        // 有符号比较, 大于0x7f的字节是负数
+        const __m128i c_1f = _mm_set1_epi8(0x1f);
+        const __m128i c_7f = _mm_set1_epi8(0x7f);
+        const __m128i c_dot = _mm_set1_epi8('.');
+        __m128i x = _mm_loadu_si128((const __m128i*)bytes);
+        __m128i mask = _mm_and_si128(
+            _mm_cmpgt_epi8(x, c_1f), _mm_cmplt_epi8(x, c_7f)
+        );
+        __m128i res = _mm_or_si128(
+            _mm_and_si128(mask, x), _mm_andnot_si128(mask, c_dot)
+        );
+        _mm_storeu_si128((__m128i*)out, res);
+        return;
+    }
+#endif // _MSTR_USE_SIMD_SSE2
+    for (i = 0; i < len; i += 1) {
+        byte_t ch = bytes[i];
+        out[i] = (char)(ch >= 0x20 && ch < 0x7f ? ch : '.');
+    }
+}
+
+/**
+ * @brief 把5个字节转换为8个Base32字符
+ *
+ * @param[out] out: 输出
+ * @param[in] bytes: 字节
+ */
+static void base32_encode_group(char* out, const byte_t* bytes)
+{
+    uint64_t w = ((uint64_t)bytes[0] << 32) |
+                 ((uint64_t)bytes[1] << 24) |
+                 ((uint64_t)bytes[2] << 16) |
+                 ((uint64_t)bytes[3] << 8) | (uint64_t)bytes[4];
+    out[0] = BASE32_ALPHABET[(w >> 35) & 0x1f];
+    out[1] = BASE32_ALPHABET[(w >> 30) & 0x1f];
+    out[2] = BASE32_ALPHABET[(w >> 25) & 0x1f];
+    out[3] = BASE32_ALPHABET[(w >> 20) & 0x1f];
+    out[4] = BASE32_ALPHABET[(w >> 15) & 0x1f];
+    out[5] = BASE32_ALPHABET[(w >> 10) & 0x1f];
+    out[6] = BASE32_ALPHABET[(w >> 5) & 0x1f];
+    out[7] = BASE32_ALPHABET[w & 0x1f];
+}
+
+#if _MSTR_USE_SIMD_SSE2
+/**
+ * @brief 使用SSE2把12个字节转换为16个Base64字符
+ *
+ * @param[out] out: 输出
+ * @param[in] bytes: 字节, 需要可以读取16个字节
+ *
+ * @note 每个32位的lane放入3个字节, 拆出4个6位的值,
+ * 然后用比较代替查表, 计算到字符的偏移量
+ */
+static void base64_encode_chunk(char* out, const byte_t* bytes)
+{
+    const __m128i c_3f = _mm_set1_epi32(0x3f);
+    const __m128i c_30 = _mm_set1_epi32(0x30);
+    const __m128i c_0f = _mm_set1_epi32(0x0f);
+    const __m128i c_3c = _mm_set1_epi32(0x3c);
+    const __m128i c_03 = _mm_set1_epi32(0x03);
+    __m128i v = _mm_loadu_si128((const __m128i*)bytes);
+    // lane: [b0, b1, b2, x]
+    __m128i x = _mm_unpacklo_epi64(
+        _mm_unpacklo_epi32(v, _mm_srli_si128(v, 3)),
+        _mm_unpacklo_epi32(_mm_srli_si128(v, 6), _mm_srli_si128(v, 9))
+    );
+    __m128i s0 = _mm_and_si128(_mm_srli_epi32(x, 2), c_3f);
+    __m128i s1 = _mm_or_si128(
+        _mm_and_si128(_mm_slli_epi32(x, 4), c_30),
+        _mm_and_si128(_mm_srli_epi32(x, 12), c_0f)
+    );
+    __m128i s2 = _mm_or_si128(
+        _mm_and_si128(_mm_srli_epi32(x, 6), c_3c),
+        _mm_and_si128(_mm_srli_epi32(x, 22), c_03)
+    );
+    __m128i s3 = _mm_and_si128(_mm_srli_epi32(x, 16), c_3f);
+    __m128i idx = _mm_or_si128(
+        _mm_or_si128(s0, _mm_slli_epi32(s1, 8)),
+        _mm_or_si128(_mm_slli_epi32(s2, 16), _mm_slli_epi32(s3, 24))
+    );
+    // 'A' + i, 'a' + (i - 26), '0' + (i - 52), '+', '/'
+    __m128i offset = _mm_set1_epi8('A');
+    offset = _mm_add_epi8(
+        offset,
+        _mm_and_si128(
+            _mm_cmpgt_epi8(idx, _mm_set1_epi8(25)), _mm_set1_epi8(6)
+        )
+    );
+    offset = _mm_add_epi8(
+        offset,
+        _mm_and_si128(
+            _mm_cmpgt_epi8(idx, _mm_set1_epi8(51)), _mm_set1_epi8(-75)
+        )
+    );
+    offset = _mm_add_epi8(
+        offset,
+        _mm_and_si128(
+            _mm_cmpeq_epi8(idx, _mm_set1_epi8(62)), _mm_set1_epi8(-15)
+        )
+    );
+    offset = _mm_add_epi8(
+        offset,
+        _mm_and_si128(
+            _mm_cmpeq_epi8(idx, _mm_set1_epi8(63)), _mm_set1_epi8(-12)
+        )
+    );
+    _mm_storeu_si128((__m128i*)out, _mm_add_epi8(idx, offset));
+}
+#endif // _MSTR_USE_SIMD_SSE2
+
+/**
+ * @brief 检查定点数的位数, 并取得值的掩码
+ *
+ * @param[in] ibits: 整数部分的位数
+ * @param[in] fbits: 小数部分的位数
+ * @param[out] mask: 低ibits + fbits位的掩码
+ */
+static mstr_result_t fixed_bits_mask(
+    uint32_t ibits, uint32_t fbits, uint32_t* mask
+)
+{
+    uint32_t bits = ibits + fbits;
+    if (ibits > 32 || fbits > 32 || bits == 0 || bits > 32) {
+        // 最多32位
+        return MStr_Err_UnsupportQuantBits;
+    }
+    *mask = (uint32_t)(((uint64_t)1 << bits) - 1);
+    return MStr_Ok;
+}
+
+/**
+ * @brief 定点数和量化值的格式化实现
+ *
+ * @param[out] str: 转换结果
+ * @param[in] value: 值, 已经去掉了多余的位
+ * @param[in] fbits: 小数部分的位数, 0 ~ 63
+ * @param[in] precision: 小数位数, -1表示输出全部的有效位数
+ *
+ * @note 小数部分左对齐到64位, 每次乘以10^8,
+ * 移出小数点的部分就是接下来的8个十进制位, 不需要除法.
+ * 舍入时把剩下的小数部分和0.5比较, 等于0.5时舍入到偶数
+ */
+static mstr_result_t ufixtoa_impl(
+    MString* str, uint64_t value, uint32_t fbits, int32_t precision
+)
+{
+    const uint32_t pow10[] = {
+        1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+    };
+    const uint64_t half = (uint64_t)1 << 63;
+    char buff[FIXED_IPART_CHARS + 1 + FIXED_FPART_CHARS];
+    char digits[FIXED_BATCH_DIGITS];
+    char* dot = buff + FIXED_IPART_CHARS;
+    char* frac = dot + 1;
+    char* beg = dot;
+    char* end = dot;
+    // 以2^-64为单位的小数部分
+    uint64_t fpart = fbits == 0 ? 0 : value << (64 - fbits);
+    uint64_t ipart = fbits == 0 ? value : value >> fbits;
+    usize_t frac_len = 0;
+    usize_t i = 0;
+    usize_t len;
+    mstr_result_t result = MStr_Ok;
+    if (precision < 0) {
+        // 全部的有效位数, 然后去掉后缀的0
+        while (fpart != 0) {
+            uint32_t batch =
+                fixed_frac_mul(&fpart, pow10[FIXED_BATCH_DIGITS]);
+            fixed_batch_to_digits(frac + frac_len, batch);
+            frac_len += FIXED_BATCH_DIGITS;
+        }
+        while (frac_len > 0 && frac[frac_len - 1] == '0') {
+            frac_len -= 1;
+        }
+    }
+    else {
+        uint32_t last_digit;
+        frac_len = (usize_t)precision;
+        while (i < frac_len && fpart != 0) {
+            usize_t k = frac_len - i;
+            uint32_t batch;
+            if (k > FIXED_BATCH_DIGITS) {
+                k = FIXED_BATCH_DIGITS;
+            }
+            batch = fixed_frac_mul(&fpart, pow10[k]);
+            fixed_batch_to_digits(digits, batch);
+            memcpy(frac + i, digits + FIXED_BATCH_DIGITS - k, k);
+            i += k;
+        }
+        if (i < frac_len) {
+            // 剩下的都是0
+            memset(frac + i, '0', frac_len - i);
+        }
+        // 舍入
+        last_digit = frac_len > 0 ? (uint32_t)(frac[frac_len - 1] - '0')
+                                  : (uint32_t)(ipart & 1);
+        if (fpart > half || (fpart == half && (last_digit & 1))) {
+            i = frac_len;
+            while (i > 0 && frac[i - 1] == '9') {
+                frac[i - 1] = '0';
+                i -= 1;
+            }
+            if (i > 0) {
+                frac[i - 1] = (char)(frac[i - 1] + 1);
+            }
+            else {
+                // 进位到整数部分
+                ipart += 1;
+            }
         }
     }
-    // copy到输出
-    MSTR_AND_THEN(result, mstr_concat(str, &buff));
-    mstr_free(&buff);
+    // 整数部分, 从小数点往前写
+    do {
+        uint32_t digit;
+        uint64_t next_value;
+        div_mod_10_u64(ipart, &next_value, &digit);
+        beg -= 1;
+        *beg = (char)('0' + digit);
+        ipart = next_value;
+    } while (ipart > 0);
+    if (frac_len > 0) {
+        *dot = '.';
+        end = frac + frac_len;
+    }
+    // 都是ASCII字符, 直接复制到输出
+    len = (usize_t)(end - beg);
+    MSTR_AND_THEN(result, array_reserve(str, str->count + len));
+    if (MSTR_SUCC(result)) {
+        memcpy(str->buff + str->count, beg, len);
+        str->count += len;
+        str->length += len;
+    }
     return result;
 }
 
+/**
+ * @brief 小数部分乘以scale, 返回移出小数点的整数部分
+ *
+ * @param[inout] frac: 以2^-64为单位的小数部分
+ * @param[in] scale: 乘数, 不超过10^8
+ *
+ * @note 分成2个32位的乘法, 不需要128位的整数
+ */
+static uint32_t fixed_frac_mul(uint64_t* frac, uint32_t scale)
+{
+    uint64_t lo = (*frac & 0xffffffff) * scale;
+    uint64_t hi = (*frac >> 32) * scale + (lo >> 32);
+    *frac = (hi << 32) | (lo & 0xffffffff);
+    return (uint32_t)(hi >> 32);
+}
+
+/**
+ * @brief 把小于10^8的值转为8个十进制字符, 包括前导0
+ *
+ */
+static void fixed_batch_to_digits(char* digits, uint32_t batch)
+{
+    uint32_t hi, lo;
+    uint16_t blocks[2];
+    div_mod_10000(batch, &hi, &lo);
+    blocks[0] = (uint16_t)hi;
+    blocks[1] = (uint16_t)lo;
+    array_blocks_to_digits(digits, blocks, 2);
+}
+
+/**
+ * @brief 格式化日期时间的一个项
+ *
+ * @param[out] out: 输出, 至少有 CHRONO_ITEM_CHARS 个字节
+ * @param[in] tm: 日期时间值
+ * @param[in] item: 项的格式化描述
+ *
+ * @return char*: 输出的结束位置
+ */
+static char* chrono_write_item(
+    char* out,
+    const MStrTime* tm,
+    const MStrFmtChronoItemFormatSpec* item
+)
+{
+    // 取得日期和时间的值
+    uint32_t value = 0;
+    uint32_t max_len = 0;
+    switch (item->value_type) {
+    case MStrFmtChronoValueType_Day:
+        value = tm->day;
+        max_len = 2;
+        break;
+    case MStrFmtChronoValueType_Year:
+        value = tm->year;
+        max_len = 4;
+        break;
+    case MStrFmtChronoValueType_Month:
+        value = tm->month;
+        max_len = 2;
+        break;
+    case MStrFmtChronoValueType_Hour24:
+        value = tm->hour;
+        max_len = 2;
+        break;
+    case MStrFmtChronoValueType_Minute:
+        value = tm->minute;
+        max_len = 2;
+        break;
+    case MStrFmtChronoValueType_Second:
+        value = tm->second;
+        max_len = 2;
+        break;
+    case MStrFmtChronoValueType_Hour:
+        value = tm->hour;
+        max_len = 2;
+        // TODO 转为12h制
+        break;
+    case MStrFmtChronoValueType_Week:
+        value = tm->week;
+        max_len = 1;
+        // TODO 转换星期名字
+        break;
+    case MStrFmtChronoValueType_SubSecond:
+        value = tm->sub_second;
+        max_len = 4;
+        break;
+    }
+    return chrono_write_bcd(
+        out,
+        value,
+        item->chrono_spec.format_length,
+        max_len,
+        item->chrono_spec.fixed_length
+    );
+}
+
 /**
  * @brief BCD值转换为字符串
  *
- * @param[out] str: 字符串输出
+ * @param[out] out: 输出, 至少有 CHRONO_ITEM_CHARS 个字节
  * @param[in] bcd: BCD码, 最多16位(4个十进制位)
  * @param[in] len: 期望转换的长度, 1 ~ 4
  * @param[in] max_len: 预期最大进行的转换长度, 1 ~ 4
  * @param[in] fixed: 是否补0
+ *
+ * @return char*: 输出的结束位置
  */
-static mstr_result_t bcdtoa(
-    MString* str,
+static char* chrono_write_bcd(
+    char* out,
     uint32_t bcd,
     uint32_t len,
     uint32_t max_len,
     mstr_bool_t fixed
 )
 {
-    usize_t counter = max_len;
-    mstr_result_t result = MStr_Ok;
-    while (MSTR_SUCC(result) && counter > 0) {
-        char ch;
-        uint32_t dec_val;
-        usize_t cur_pos;
-        counter -= 1;
-        cur_pos = counter;
-        if (fixed && cur_pos < max_len - len) {
+    uint32_t pos = max_len;
+    if (fixed && len == max_len) {
+        // 固定长度: 左对齐之后一次展开4个BCD位,
+        // 写入4个字节, 多写的会被后面的内容覆盖
+        uint32_t word =
+            bcd_to_ascii4((bcd << (4 * (4 - max_len))) & 0xffff);
+        out[0] = (char)(word & 0xff);
+        out[1] = (char)((word >> 8) & 0xff);
+        out[2] = (char)((word >> 16) & 0xff);
+        out[3] = (char)((word >> 24) & 0xff);
+        return out + max_len;
+    }
+    while (pos > 0) {
+        uint32_t digit;
+        pos -= 1;
+        if (fixed && pos < max_len - len) {
             // 到达限定的位数了
             break;
         }
         // 转换当前位
-        dec_val = (bcd >> (4 * cur_pos)) & 0xf;
-        if (dec_val > 0) {
-            ch = (char)(dec_val + '0');
-            MSTR_AND_THEN(result, mstr_append(str, ch));
+        digit = (bcd >> (4 * pos)) & 0xf;
+        if (digit > 0 || fixed || len > pos) {
+            *out = (char)('0' + digit);
+            out += 1;
         }
-        else if (fixed || len > cur_pos) {
-            MSTR_AND_THEN(result, mstr_append(str, '0'));
+    }
+    return out;
+}
+
+/**
+ * @brief 把4个BCD位展开为4个数字字符
+ *
+ * @param[in] bcd: BCD码, 0xABCD
+ *
+ * @return uint32_t: 从低字节开始依次为'A', 'B', 'C', 'D'
+ */
+static uint32_t bcd_to_ascii4(uint32_t bcd)
+{
+    // 0xABCD -> 0x00CD00AB -> 0x0D0C0B0A
+    uint32_t x = ((bcd & 0xff) << 16) | ((bcd >> 8) & 0xff);
+    x = ((x & 0x00f000f0) >> 4) | ((x & 0x000f000f) << 8);
+    return x | 0x30303030;
+}
+
+#if _MSTR_USE_CHRONO_CACHE
+/**
+ * @brief 如果缓存的前缀可以使用, 复制前缀到输出
+ *
+ * @param[inout] pout: 输出的位置
+ * @param[out] length: 前缀的字符数
+ * @param[in] tm: 日期时间值
+ * @param[in] spec: 格式化信息
+ * @param[in] prefix_cnt: 前缀的项数
+ *
+ * @return usize_t: 已经输出的项数, 未命中时为0
+ */
+static usize_t chrono_cache_load(
+    char** pout,
+    usize_t* length,
+    const MStrTime* tm,
+    const MStrFmtChronoFormatSpec* spec,
+    usize_t prefix_cnt
+)
+{
+    const MStrTime* cached_tm = &chrono_cache.time;
+    const char* split = chrono_cache.splits;
+    usize_t i;
+    if (prefix_cnt == 0 || prefix_cnt != chrono_cache.item_cnt) {
+        return 0;
+    }
+    // 亚秒值之外的部分需要相同
+    if (tm->second != cached_tm->second ||
+        tm->minute != cached_tm->minute ||
+        tm->hour != cached_tm->hour || tm->day != cached_tm->day ||
+        tm->month != cached_tm->month ||
+        tm->year != cached_tm->year || tm->week != cached_tm->week) {
+        return 0;
+    }
+    // 格式需要相同, 分隔符比较内容而不是地址
+    for (i = 0; i < prefix_cnt; i += 1) {
+        const MStrFmtChronoItemFormatSpec* item = &spec->items[i];
+        const ChronoCacheItem* cached = &chrono_cache.items[i];
+        usize_t split_count =
+            (usize_t)(item->split_end - item->split_beg);
+        if (cached->value_type != (uint8_t)item->value_type ||
+            cached->fixed_length !=
+                (uint8_t)item->chrono_spec.fixed_length ||
+            cached->format_length != item->chrono_spec.format_length ||
+            cached->split_count != split_count ||
+            (split_count > 0 &&
+             memcmp(split, item->split_beg, split_count) != 0)) {
+            return 0;
         }
+        split += split_count;
     }
-    return result;
+    memcpy(*pout, chrono_cache.prefix, chrono_cache.count);
+    *pout += chrono_cache.count;
+    *length = chrono_cache.length;
+    return prefix_cnt;
+}
+
+/**
+ * @brief 保存格式化得到的前缀
+ *
+ * @param[in] beg: 前缀的开始
+ * @param[in] end: 前缀的结束
+ * @param[in] length: 前缀的字符数
+ * @param[in] tm: 日期时间值
+ * @param[in] spec: 格式化信息
+ * @param[in] prefix_cnt: 前缀的项数
+ *
+ * @note 前缀或者分隔符太长的时候不缓存
+ */
+static void chrono_cache_store(
+    const char* beg,
+    const char* end,
+    usize_t length,
+    const MStrTime* tm,
+    const MStrFmtChronoFormatSpec* spec,
+    usize_t prefix_cnt
+)
+{
+    usize_t count = (usize_t)(end - beg);
+    usize_t split_offset = 0;
+    usize_t i;
+    chrono_cache.item_cnt = 0;
+    if (count > CHRONO_CACHE_PREFIX_CHARS) {
+        return;
+    }
+    for (i = 0; i < prefix_cnt; i += 1) {
+        const MStrFmtChronoItemFormatSpec* item = &spec->items[i];
+        ChronoCacheItem* cached = &chrono_cache.items[i];
+        usize_t split_count =
+            (usize_t)(item->split_end - item->split_beg);
+        if (split_count > CHRONO_CACHE_SPLIT_CHARS - split_offset) {
+            return;
+        }
+        cached->value_type = (uint8_t)item->value_type;
+        cached->fixed_length = (uint8_t)item->chrono_spec.fixed_length;
+        cached->format_length = item->chrono_spec.format_length;
+        cached->split_count = (uint8_t)split_count;
+        if (split_count > 0) {
+            memcpy(
+                chrono_cache.splits + split_offset,
+                item->split_beg,
+                split_count
+            );
+            split_offset += split_count;
+        }
+    }
+    memcpy(chrono_cache.prefix, beg, count);
+    chrono_cache.time = *tm;
+    chrono_cache.count = count;
+    chrono_cache.length = length;
+    chrono_cache.item_cnt = prefix_cnt;
+}
+#endif // _MSTR_USE_CHRONO_CACHE
+
+/**
+ * @brief 从-0400-03-01开始的天数转换为年月日和星期
+ *
+ * @param[in] days: 天数
+ * @param[out] tm: 日期, BCD码
+ *
+ * @note 使用Neri-Schneider的算法, 把除法换成了乘法和移位,
+ * 常数对 days < 2^22 都成立
+ */
+static void timestamp_days_to_civil(uint32_t days, MStrTime* tm)
+{
+    // 400年的周期(146097天)中的世纪
+    uint32_t n1 = 4 * days + 3;
+    uint32_t century = (uint32_t)(((uint64_t)n1 * 15051803) >> 41);
+    uint32_t n2 = (n1 - century * 146097) | 3;
+    // 世纪中的年, 以及年中的天数(从3月1日开始)
+    uint64_t p2 = (uint64_t)n2 * 2939745;
+    uint32_t year = century * 100 + (uint32_t)(p2 >> 32);
+    uint32_t yday = (uint32_t)(
+        ((uint64_t)(uint32_t)p2 * 1531969483) >> 54
+    );
+    // 月份和日期, 2141 / 65536 约为 1 / 30.6
+    uint32_t n3 = 2141 * yday + 197913;
+    uint32_t month = n3 >> 16;
+    uint32_t day = (((n3 & 0xffff) * 31345) >> 26) + 1;
+    // 星期一 ~ 星期日为1 ~ 7, 1970-01-01是星期四
+    uint32_t week_days = days + 2;
+    uint32_t week =
+        week_days -
+        (uint32_t)(((uint64_t)week_days * 4793491) >> 25) * 7 + 1;
+    if (yday >= 306) {
+        // 1月和2月属于下一年
+        year += 1;
+        month -= 12;
+    }
+    tm->year = (uint16_t)bin_to_bcd4(year - 400);
+    tm->month = (uint8_t)bin_to_bcd2(month);
+    tm->day = (uint8_t)bin_to_bcd2(day);
+    tm->week = (uint8_t)week;
+}
+
+/**
+ * @brief 小于100的值转换为BCD码
+ *
+ * @note x / 10 = (x * 103) >> 10, 对 x < 179 成立
+ */
+static uint32_t bin_to_bcd2(uint32_t x)
+{
+    return x + ((x * 103) >> 10) * 6;
+}
+
+/**
+ * @brief 小于10000的值转换为BCD码
+ *
+ * @note x / 100 = (x * 5243) >> 19, 对 x < 43699 成立
+ */
+static uint32_t bin_to_bcd4(uint32_t x)
+{
+    uint32_t hi = (x * 5243) >> 19;
+    return (bin_to_bcd2(hi) << 8) | bin_to_bcd2(x - hi * 100);
 }
 
 /**
@@ -504,6 +2033,23 @@ static void div_mod_10(uint32_t x, uint32_t* div, uint32_t* rem)
 #endif // _MSTR_USE_HARDWARE_DIV
 }
 
+/**
+ * @brief 返回: div = x / 10000; rem = x % 10000
+ *
+ * @note x / 10000 = (x * 3518437209) >> 45, 对所有的32位x都成立
+ */
+static void div_mod_10000(uint32_t x, uint32_t* div, uint32_t* rem)
+{
+#if _MSTR_USE_HARDWARE_DIV
+    *div = x / 10000;
+    *rem = x % 10000;
+#else
+    uint32_t q = (uint32_t)(((uint64_t)x * 3518437209u) >> 45);
+    *div = q;
+    *rem = x - q * 10000;
+#endif // _MSTR_USE_HARDWARE_DIV
+}
+
 /**
  * @brief 返回: div = x / 10; rem = x % 10
  *
@@ -541,5 +2087,14 @@ static void div_mod_10_u64(uint64_t x, uint64_t* div, uint32_t* rem)
  */
 static uint32_t abs_u32(int32_t x)
 {
-    return x > 0 ? (uint32_t)x : (uint32_t)(-x);
+    return x > 0 ? (uint32_t)x : 0u - (uint32_t)x;
+}
+
+/**
+ * @brief 计算|x|
+ *
+ */
+static uint64_t abs_u64(int64_t x)
+{
+    return x > 0 ? (uint64_t)x : (uint64_t)0 - (uint64_t)x;
 }
@@ -120,6 +120,9 @@ typedef enum tagTokenType
     //! ':t'
     TokenType_Type_SysTime,
 
+    //! ':T'
+    TokenType_Type_Timestamp,
+
     //! '{'
     TokenType_LeftBrace,
 
@@ -315,6 +318,10 @@ static mstr_result_t
 static mstr_result_t
     parse_chrono_spec_item(MStrFmtParserState*, MStrFmtChronoItemFormatSpec*);
 static mstr_result_t parse_opt_width(MStrFmtParserState*, int32_t*);
+static mstr_result_t
+    parse_opt_precision(MStrFmtParserState*, int32_t*);
+static mstr_result_t
+    parse_opt_base_encoding(MStrFmtParserState*, MStrFmtFormatSpec*);
 static mstr_result_t
     parse_opt_sign(MStrFmtParserState*, MStrFmtSignDisplay*);
 static mstr_result_t
@@ -654,6 +661,7 @@ static mstr_result_t parse_opt_formatfield_spec(
 )
 {
     int32_t width = -1;
+    int32_t precision = -1;
     char fill_char = ' ';
     MStrFmtAlign align = MStrFmtAlign_Right;
     MStrFmtSignDisplay sign_display = MStrFmtSignDisplay_NegOnly;
@@ -690,6 +698,10 @@ static mstr_result_t parse_opt_formatfield_spec(
             MSTR_AND_THEN(result, parse_opt_sign(state, &sign_display));
             // 可选的width
             MSTR_AND_THEN(result, parse_opt_width(state, &width));
+            // 可选的precision
+            MSTR_AND_THEN(
+                result, parse_opt_precision(state, &precision)
+            );
             // 可选的进行格式化的方式
             MSTR_AND_THEN(
                 result, parse_opt_format_chrono_spec(state, &fmt_spec)
@@ -704,6 +716,7 @@ static mstr_result_t parse_opt_formatfield_spec(
         spec->fill_char = fill_char;
         spec->sign_display = sign_display;
         spec->width = width;
+        spec->precision = precision;
     }
     state->stage =
         PARSER_STAGE_END(state->stage, ParserStage_MatchChronoToken);
@@ -778,11 +791,28 @@ static mstr_result_t parse_format_spec(
         be_matched = True;
         spec->fmt_type = MStrFmtFormatType_Hex_UpperCase_WithPrefix;
         break;
+    case 'y':
+        be_matched = True;
+        spec->fmt_type = MStrFmtFormatType_HexBytes;
+        break;
+    case 'Y':
+        be_matched = True;
+        spec->fmt_type = MStrFmtFormatType_HexBytes_UpperCase;
+        break;
+    case 'D':
+        be_matched = True;
+        spec->fmt_type = MStrFmtFormatType_HexDump;
+        break;
     default: be_matched = False; break;
     }
     if (be_matched) {
         // 类型正确
-        return parser_next_token(state);
+        mstr_result_t result = parser_next_token(state);
+        if (MSTR_SUCC(result) && ch == 'b') {
+            // `b64`, `b32`
+            result = parse_opt_base_encoding(state, spec);
+        }
+        return result;
     }
     else {
         // 不支持的formatter type
@@ -792,6 +822,27 @@ static mstr_result_t parse_format_spec(
     }
 }
 
+/**
+ * @brief 解析`b`后面可选的编码位数: `b64`, `b32`
+ *
+ */
+static mstr_result_t parse_opt_base_encoding(
+    MStrFmtParserState* state, MStrFmtFormatSpec* spec
+)
+{
+    const Token* cur_token = &LEX_CURRENT_TOKEN(state);
+    if (cur_token->type != TokenType_Digits) {
+        // 只有`b`
+        return MStr_Ok;
+    }
+    switch (lex_atou(cur_token->beg, cur_token->len)) {
+    case 64: spec->fmt_type = MStrFmtFormatType_Base64; break;
+    case 32: spec->fmt_type = MStrFmtFormatType_Base32; break;
+    default: return MStr_Err_UnsupportFormatType;
+    }
+    return parser_next_token(state);
+}
+
 /**
  * @brief 解析时间日期的值格式化的方式(chrono_spec)
  *
@@ -1043,6 +1094,40 @@ static mstr_result_t parse_opt_width(
     }
 }
 
+/**
+ * @brief 解析可选的小数位数: `.` digits, 默认为-1
+ *
+ * @note `.`不在lex里面, 是一个OtherChar
+ *
+ * @attention 该函数不设置默认值
+ */
+static mstr_result_t parse_opt_precision(
+    MStrFmtParserState* state, int32_t* precision
+)
+{
+    mstr_result_t result = MStr_Ok;
+    const Token* cur_token = &LEX_CURRENT_TOKEN(state);
+    uint32_t p;
+    if (cur_token->type != TokenType_OtherChar ||
+        *cur_token->beg != '.') {
+        return MStr_Ok;
+    }
+    MSTR_AND_THEN(result, parser_next_token(state));
+    if (MSTR_FAILED(result)) {
+        return result;
+    }
+    else if (cur_token->type != TokenType_Digits) {
+        // `.`后面必须是数字
+        return MStr_Err_UnsupportFormatType;
+    }
+    p = lex_atou(cur_token->beg, cur_token->len);
+    if (p >= MFMT_PLACE_MAX_PRECISION) {
+        return MStr_Err_PrecisionTooLarge;
+    }
+    *precision = (int32_t)p;
+    return parser_next_token(state);
+}
+
 /**
  * @brief 指定符号的显示方式
  *
@@ -1127,12 +1212,17 @@ static mstr_result_t parse_opt_items(
             }
             else {
                 // 后面应该是format_type或者sign
-                if ((cur_token->type == TokenType_OtherChar &&
-                     *cur_token->beg == ' ') ||
-                    (cur_token->type == TokenType_OtherChar &&
-                     *cur_token->beg == '+') ||
-                    (cur_token->type == TokenType_OtherChar &&
-                     *cur_token->beg == '-')) {
+                if (cur_token->type == TokenType_OtherChar &&
+                    *cur_token->beg == '.') {
+                    // precision, 后面再解析
+                    return MStr_Ok;
+                }
+                else if ((cur_token->type == TokenType_OtherChar &&
+                          *cur_token->beg == ' ') ||
+                         (cur_token->type == TokenType_OtherChar &&
+                          *cur_token->beg == '+') ||
+                         (cur_token->type == TokenType_OtherChar &&
+                          *cur_token->beg == '-')) {
                     // 优先匹配sign
                     return parse_opt_sign(state, sign);
                 }
@@ -1206,12 +1296,26 @@ static mstr_result_t parse_arg_type(
     case TokenType_Type_Uint32: typ = MStrFmtArgType_Uint32; break;
     case TokenType_Type_CString: typ = MStrFmtArgType_CString; break;
     case TokenType_Type_SysTime: typ = MStrFmtArgType_Time; break;
+    case TokenType_Type_Timestamp:
+        typ = MStrFmtArgType_Timestamp;
+        break;
     case TokenType_Type_IQuant:
-        typ = MStrFmtArgType_QuantizedValue;
         parse_arg_get_fixed_props(cur_token, arg_prop);
+        // 超过31位的量化值需要64位的值
+        typ = arg_prop->a > 31 ? MStrFmtArgType_QuantizedValue64
+                               : MStrFmtArgType_QuantizedValue;
         break;
     case TokenType_Type_UQuant:
-        typ = MStrFmtArgType_QuantizedUnsignedValue;
+        parse_arg_get_fixed_props(cur_token, arg_prop);
+        typ = arg_prop->a > 31 ? MStrFmtArgType_QuantizedUnsignedValue64
+                               : MStrFmtArgType_QuantizedUnsignedValue;
+        break;
+    case TokenType_Type_IFixedNumber:
+        typ = MStrFmtArgType_FixedValue;
+        parse_arg_get_fixed_props(cur_token, arg_prop);
+        break;
+    case TokenType_Type_UFixedNumber:
+        typ = MStrFmtArgType_FixedUnsignedValue;
         parse_arg_get_fixed_props(cur_token, arg_prop);
         break;
     default:
@@ -1240,18 +1344,28 @@ static void parse_arg_get_fixed_props(
 {
     // assert: token->type == TokenType_Type_IQuant
     //          ||  token->type == TokenType_Type_UQuant
-    // 跳过 `:` `q`
+    //          ||  token->type == TokenType_Type_IFixedNumber
+    //          ||  token->type == TokenType_Type_UFixedNumber
+    // 跳过 `:` `q` 或者 `:` `F`
     const char* beg = token->beg + 2;
-    uint32_t v1 = (uint32_t)(beg[0] - '0');
-    if (token->len > 3 && IS_NUMBER(beg[1])) {
-        uint32_t v2 = (uint32_t)(beg[1] - '0');
-        arg_prop->a = v1 * 10 + v2;
+    const char* end = token->beg + token->len;
+    const char* p = beg;
+    while (p < end && IS_NUMBER(*p)) {
+        p += 1;
+    }
+    arg_prop->a = lex_atou(beg, (usize_t)(p - beg));
+    if (p < end && *p == '.') {
+        // 定点数的小数部分位数
+        beg = p + 1;
+        p = beg;
+        while (p < end && IS_NUMBER(*p)) {
+            p += 1;
+        }
+        arg_prop->b = lex_atou(beg, (usize_t)(p - beg));
     }
     else {
-        mstr_assert(token->len == 3);
-        arg_prop->a = v1;
+        arg_prop->b = 0;
     }
-    arg_prop->b = 0;
 }
 
 /**
@@ -1447,6 +1561,7 @@ colon:
 #endif // _MSTR_USE_FP
     case 's': goto type_str;
     case 't': goto type_time;
+    case 'T': goto type_timestamp;
     default: goto acc;
     }
 type_ix:
@@ -1650,6 +1765,9 @@ type_str:
 type_time:
     matched_type = TokenType_Type_SysTime;
     goto signed_char_acc;
+type_timestamp:
+    matched_type = TokenType_Type_Timestamp;
+    goto signed_char_acc;
 v_line:
     LEX_MOVE_TO_NEXT(pstr);
     LEX_ACCEPT_TOKEN(token, TokenType_OtherChar, pstr);
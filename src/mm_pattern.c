@@ -262,6 +262,7 @@ static mstr_result_t mstr_retain_start_with_impl(
         MSTR_AND_THEN(
             res, unicode_length_of(&patt_len, patt, patt_cnt)
         );
+        MSTR_AND_THEN(res, mstr_detach(str));
         // 把数据挪到前面覆盖掉
         if (MSTR_SUCC(res)) {
             memmove(
@@ -293,6 +294,7 @@ static mstr_result_t mstr_retain_end_with_impl(
         MSTR_AND_THEN(
             res, unicode_length_of(&patt_len, patt, patt_cnt)
         );
+        MSTR_AND_THEN(res, mstr_detach(str));
         if (MSTR_SUCC(res)) {
             // 减去长度, 把数据截断
             str->count -= patt_cnt;
@@ -0,0 +1,339 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    mm_rope.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   分块的字符串构建器
+ * @version 1.0
+ * @date    2023-08-28
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+
+#define MSTR_IMP_SOURCES 1
+
+#include "mm_rope.h"
+#include "mm_fmt.h"
+#include "mm_heap.h"
+#include <stdarg.h>
+#include <stddef.h>
+#include <string.h>
+
+/**
+ * @brief 块, 数据紧跟在结构之后
+ *
+ */
+struct tagMStrRopeChunk
+{
+    /**
+     * @brief 下一个块
+     *
+     */
+    MStrRopeChunk* next;
+
+    /**
+     * @brief 已经使用的字节数
+     *
+     */
+    usize_t count;
+};
+
+/**
+ * @brief 取得块的数据
+ *
+ */
+#define ROPE_CHUNK_DATA(c) ((char*)((c) + 1))
+
+//
+// private:
+//
+
+static mstr_result_t rope_io_write(void*, const byte_t*, usize_t);
+static usize_t rope_split(const char*, usize_t, usize_t);
+static MStrRopeChunk* rope_take_chunk(MStrRope*);
+static void rope_free_list(MStrRopeChunk*);
+
+//
+// public:
+//
+
+MSTR_EXPORT_API(void)
+mstr_rope_init(MStrRope* rope, usize_t chunk_size)
+{
+    rope->head = NULL;
+    rope->tail = NULL;
+    rope->free_list = NULL;
+    rope->chunk_size =
+        chunk_size == 0 ? MSTR_ROPE_CHUNK_SIZE : chunk_size;
+    // 至少能放下一个完整的UTF-8字符
+    rope->chunk_size =
+        rope->chunk_size < 4 ? 4 : rope->chunk_size;
+    rope->count = 0;
+    rope->length = 0;
+    mstr_io_init(rope, &rope->io, rope_io_write);
+    mstr_init(&rope->scratch);
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_rope_concat_view(MStrRope* rope, const MStringView* view)
+{
+    const char* src = view->buff;
+    usize_t rem = view->count;
+    usize_t space = 0;
+    MStrRopeChunk* new_head = NULL;
+    MStrRopeChunk* new_tail = NULL;
+    if (rope->tail != NULL) {
+        space = rope->chunk_size - rope->tail->count;
+    }
+    // 先取得所有需要的块, 失败时不修改构建器
+    while (rem > 0) {
+        usize_t cnt = rope_split(src, rem, space);
+        MStrRopeChunk* chunk;
+        src += cnt;
+        rem -= cnt;
+        if (rem == 0) {
+            break;
+        }
+        chunk = rope_take_chunk(rope);
+        if (chunk == NULL) {
+            if (new_head != NULL) {
+                new_tail->next = rope->free_list;
+                rope->free_list = new_head;
+            }
+            return MStr_Err_HeapTooSmall;
+        }
+        if (new_head == NULL) {
+            new_head = chunk;
+        }
+        else {
+            new_tail->next = chunk;
+        }
+        new_tail = chunk;
+        space = rope->chunk_size;
+    }
+    // 链接到最后
+    if (new_head != NULL) {
+        if (rope->tail == NULL) {
+            rope->head = new_head;
+        }
+        else {
+            rope->tail->next = new_head;
+        }
+    }
+    // 写入数据, 和上面按照相同的位置分开
+    if (rope->tail == NULL) {
+        rope->tail = new_head;
+    }
+    src = view->buff;
+    rem = view->count;
+    while (rem > 0) {
+        MStrRopeChunk* chunk = rope->tail;
+        usize_t cnt =
+            rope_split(src, rem, rope->chunk_size - chunk->count);
+        if (cnt == 0) {
+            rope->tail = chunk->next;
+            continue;
+        }
+        memcpy(ROPE_CHUNK_DATA(chunk) + chunk->count, src, cnt);
+        chunk->count += cnt;
+        src += cnt;
+        rem -= cnt;
+    }
+    rope->count += view->count;
+    rope->length += view->length;
+    return MStr_Ok;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_rope_concat(MStrRope* rope, const MString* str)
+{
+    MStringView view;
+    mstr_view_of(&view, str);
+    return mstr_rope_concat_view(rope, &view);
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_rope_concat_cstr(MStrRope* rope, const char* str)
+{
+    MStringView view;
+    mstr_result_t res = mstr_view_from_cstr(&view, str, NULL);
+    MSTR_AND_THEN(res, mstr_rope_concat_view(rope, &view));
+    return res;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_rope_format(
+    MStrRope* rope, const char* fmt, usize_t fmt_place, ...
+)
+{
+    va_list ap;
+    mstr_result_t res;
+    MStringView view;
+    mstr_clear(&rope->scratch);
+    va_start(ap, fmt_place);
+    res = mstr_vformat(fmt, &rope->scratch, fmt_place, &ap);
+    va_end(ap);
+    if (MSTR_SUCC(res)) {
+        mstr_view_of(&view, &rope->scratch);
+        res = mstr_rope_concat_view(rope, &view);
+    }
+    return res;
+}
+
+MSTR_EXPORT_API(MStrIOCallback*) mstr_rope_io(MStrRope* rope)
+{
+    // 构建器可能被复制过, 所以每次都重新设置capture
+    mstr_io_init(rope, &rope->io, rope_io_write);
+    return &rope->io;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_rope_flush(MStrRope* rope, MStrIOCallback* io)
+{
+    const MStrRopeChunk* chunk = rope->head;
+    while (chunk != NULL) {
+        const byte_t* data = (const byte_t*)ROPE_CHUNK_DATA(chunk);
+        mstr_result_t res =
+            io->io_write(io->capture, data, chunk->count);
+        if (MSTR_FAILED(res)) {
+            return res;
+        }
+        chunk = chunk->next;
+    }
+    mstr_rope_clear(rope);
+    return MStr_Ok;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_rope_flatten(const MStrRope* rope, MString* str)
+{
+    const MStrRopeChunk* chunk = rope->head;
+    char* dst;
+    mstr_result_t res;
+    if (rope->count == 0) {
+        return MStr_Ok;
+    }
+    // 多一个字节给 mstr_c_str 的'\0'
+    res = mstr_reserve(str, str->count + rope->count + 1);
+    if (MSTR_FAILED(res)) {
+        return res;
+    }
+    dst = str->buff + str->count;
+    while (chunk != NULL) {
+        memcpy(dst, ROPE_CHUNK_DATA(chunk), chunk->count);
+        dst += chunk->count;
+        chunk = chunk->next;
+    }
+    str->count += rope->count;
+    str->length += rope->length;
+    return MStr_Ok;
+}
+
+MSTR_EXPORT_API(void) mstr_rope_clear(MStrRope* rope)
+{
+    MStrRopeChunk* chunk = rope->head;
+    while (chunk != NULL) {
+        MStrRopeChunk* next = chunk->next;
+        chunk->count = 0;
+        chunk->next = rope->free_list;
+        rope->free_list = chunk;
+        chunk = next;
+    }
+    rope->head = NULL;
+    rope->tail = NULL;
+    rope->count = 0;
+    rope->length = 0;
+}
+
+MSTR_EXPORT_API(void) mstr_rope_free(MStrRope* rope)
+{
+    rope_free_list(rope->head);
+    rope_free_list(rope->free_list);
+    mstr_free(&rope->scratch);
+    mstr_init(&rope->scratch);
+    rope->head = NULL;
+    rope->tail = NULL;
+    rope->free_list = NULL;
+    rope->count = 0;
+    rope->length = 0;
+}
+
+/**
+ * @brief IO的写入callback
+ *
+ */
+static mstr_result_t rope_io_write(
+    void* ctx, const byte_t* data, usize_t len
+)
+{
+    MStringView view;
+    const char* beg = (const char*)data;
+    mstr_result_t res = mstr_view_from_cstr(&view, beg, beg + len);
+    MSTR_AND_THEN(res, mstr_rope_concat_view((MStrRope*)ctx, &view));
+    return res;
+}
+
+/**
+ * @brief 计算剩余空间为space的块能放下的字节数
+ *
+ * @param[in] src: 数据
+ * @param[in] rem: 数据的字节数
+ * @param[in] space: 块的剩余空间
+ *
+ * @return usize_t: 字节数, 不会把一个UTF-8字符分到两个块中,
+ * 放不下一个完整的字符时返回0
+ */
+static usize_t rope_split(const char* src, usize_t rem, usize_t space)
+{
+    usize_t cnt = space;
+    if (rem <= space) {
+        return rem;
+    }
+#if _MSTR_USE_UTF_8
+    // 最多回退3个字节到字符的开头
+    while (cnt > 0 && space - cnt < 3 &&
+           ((uint8_t)src[cnt] & 0xc0) == 0x80) {
+        cnt -= 1;
+    }
+#else
+    (void)src;
+#endif // _MSTR_USE_UTF_8
+    return cnt;
+}
+
+/**
+ * @brief 取得一个空的块, 优先使用空闲的块
+ *
+ * @return MStrRopeChunk*: 块, 分配失败时返回NULL
+ */
+static MStrRopeChunk* rope_take_chunk(MStrRope* rope)
+{
+    MStrRopeChunk* chunk = rope->free_list;
+    if (chunk != NULL) {
+        rope->free_list = chunk->next;
+    }
+    else {
+        chunk = (MStrRopeChunk*)mstr_heap_alloc(
+            sizeof(MStrRopeChunk) + rope->chunk_size
+        );
+        if (chunk == NULL) {
+            return NULL;
+        }
+    }
+    chunk->next = NULL;
+    chunk->count = 0;
+    return chunk;
+}
+
+/**
+ * @brief 释放块的链表
+ *
+ */
+static void rope_free_list(MStrRopeChunk* chunk)
+{
+    while (chunk != NULL) {
+        MStrRopeChunk* next = chunk->next;
+        mstr_heap_free(chunk);
+        chunk = next;
+    }
+}
@@ -0,0 +1,1453 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    mm_scan.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   字符串到数值的转换, mm_into的逆过程
+ * @version 1.0
+ * @date    2023-08-20
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+
+#define MSTR_IMP_SOURCES 1
+
+#include "mm_scan.h"
+#include "mm_type.h"
+#include <string.h>
+#if _MSTR_USE_SIMD_SSE2
+#include <emmintrin.h>
+#endif // _MSTR_USE_SIMD_SSE2
+
+/**
+ * @brief 十进制数每次转换的位数
+ *
+ */
+#define SCAN_BATCH_DIGITS    8
+
+/**
+ * @brief 小数部分最多保存的limb数目
+ *
+ * @note q63的舍入边界最多有64个十进制位,
+ * 再后面的位只影响是否正好在舍入边界上
+ */
+#define SCAN_FRAC_LIMBS      8
+
+/**
+ * @brief 小数部分一个limb的基数 (10^SCAN_BATCH_DIGITS)
+ *
+ */
+#define SCAN_LIMB_BASE       ((uint32_t)100000000)
+
+/**
+ * @brief UINT64_MAX / 10^8
+ *
+ */
+#define SCAN_U64_MAX_DIV_1E8 ((uint64_t)184467440737)
+
+/**
+ * @brief UINT64_MAX % 10^8
+ *
+ */
+#define SCAN_U64_MAX_MOD_1E8 ((uint32_t)9551615)
+
+/**
+ * @brief UINT64_MAX / 10
+ *
+ */
+#define SCAN_U64_MAX_DIV_10  ((uint64_t)1844674407370955161)
+
+/**
+ * @brief 十进制小数的小数部分
+ *
+ */
+typedef struct tagScanDecimalFrac
+{
+    //! 每个limb保存SCAN_BATCH_DIGITS个十进制位, 高位在前
+    uint32_t limbs[SCAN_FRAC_LIMBS];
+
+    //! limb的数目, 不包括末尾为0的limb
+    usize_t limb_cnt;
+
+    //! limbs之后是否还有不为0的位
+    mstr_bool_t sticky;
+} ScanDecimalFrac;
+
+static mstr_result_t scan_template(
+    const MString*, const MStrScanTemplate*, usize_t, va_list*
+);
+static mstr_result_t scan_next_item(MStrScanItem*, const char**);
+static mstr_result_t scan_item_from_parser(
+    MStrScanItem*, const MStrFmtParseResult*, const char*
+);
+static mstr_result_t scan_item(
+    const char**, const char*, const MStrScanItem*, MStrFmtArgsContext*
+);
+static mstr_result_t scan_field(
+    const char**, const char*, const MStrScanItem*, void*
+);
+static mstr_result_t scan_repeat_field(
+    const char**, const char*, const MStrScanItem*, const void*
+);
+static usize_t scan_value_size(MStrFmtArgType);
+static const char*
+    scan_trim_fill(const char*, const char*, const MStrScanItem*);
+static mstr_result_t scan_int(
+    void*,
+    uint32_t,
+    const char*,
+    const char*,
+    MStrFmtIntIndex,
+    const char**
+);
+static mstr_result_t scan_uint(
+    void*,
+    uint32_t,
+    const char*,
+    const char*,
+    MStrFmtIntIndex,
+    const char**
+);
+static mstr_result_t scan_load_arg(
+    void**, MStrFmtArgsContext*, uint32_t, MStrFmtArgType
+);
+static mstr_result_t scan_int_index(
+    MStrFmtIntIndex*, MStrFmtFormatType
+);
+static mstr_bool_t scan_match_literal(
+    const char*, const char*, usize_t
+);
+static mstr_result_t parse_integer(
+    uint64_t*,
+    mstr_bool_t*,
+    const char*,
+    const char*,
+    MStrFmtIntIndex,
+    uint64_t,
+    uint64_t,
+    const char**
+);
+static mstr_result_t parse_fixed(
+    uint64_t*,
+    mstr_bool_t*,
+    const char*,
+    const char*,
+    uint32_t,
+    uint64_t,
+    uint64_t,
+    const char**
+);
+static mstr_result_t fixed_bits_check(uint32_t, uint32_t);
+static const char* scan_sign(mstr_bool_t*, const char*, const char*);
+static const char* scan_10base(
+    uint64_t*, mstr_bool_t*, const char*, const char*
+);
+static const char* scan_2base(
+    uint64_t*, mstr_bool_t*, const char*, const char*, uint32_t
+);
+static const char* scan_frac(
+    ScanDecimalFrac*, const char*, const char*
+);
+static uint64_t frac_to_bits(ScanDecimalFrac*, uint32_t);
+static uint32_t frac_double(ScanDecimalFrac*);
+static uint32_t digit_value(char);
+static uint64_t load_u64_le(const char*);
+static mstr_bool_t swar_is_8digits(uint64_t);
+static uint32_t swar_8digits_value(uint64_t);
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_i32(
+    int32_t* value,
+    const char* beg,
+    const char* end,
+    MStrFmtIntIndex index,
+    const char** stop
+)
+{
+    uint64_t mag = 0;
+    mstr_bool_t neg = False;
+    mstr_result_t result = parse_integer(
+        &mag, &neg, beg, end, index, 0x7fffffff, 0x80000000, stop
+    );
+    if (MSTR_SUCC(result)) {
+        *value = (int32_t)(neg ? 0u - (uint32_t)mag : (uint32_t)mag);
+    }
+    return result;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_u32(
+    uint32_t* value,
+    const char* beg,
+    const char* end,
+    MStrFmtIntIndex index,
+    const char** stop
+)
+{
+    uint64_t mag = 0;
+    mstr_bool_t neg = False;
+    mstr_result_t result = parse_integer(
+        &mag, &neg, beg, end, index, 0xffffffff, 0, stop
+    );
+    if (MSTR_SUCC(result)) {
+        *value = (uint32_t)mag;
+    }
+    return result;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_i64(
+    int64_t* value,
+    const char* beg,
+    const char* end,
+    MStrFmtIntIndex index,
+    const char** stop
+)
+{
+    const uint64_t max_neg = (uint64_t)1 << 63;
+    uint64_t mag = 0;
+    mstr_bool_t neg = False;
+    mstr_result_t result = parse_integer(
+        &mag, &neg, beg, end, index, max_neg - 1, max_neg, stop
+    );
+    if (MSTR_SUCC(result)) {
+        *value = (int64_t)(neg ? (uint64_t)0 - mag : mag);
+    }
+    return result;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_u64(
+    uint64_t* value,
+    const char* beg,
+    const char* end,
+    MStrFmtIntIndex index,
+    const char** stop
+)
+{
+    uint64_t mag = 0;
+    mstr_bool_t neg = False;
+    mstr_result_t result = parse_integer(
+        &mag, &neg, beg, end, index, ~(uint64_t)0, 0, stop
+    );
+    if (MSTR_SUCC(result)) {
+        *value = mag;
+    }
+    return result;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_iq(
+    int32_t* value,
+    const char* beg,
+    const char* end,
+    uint32_t quat,
+    const char** stop
+)
+{
+    if (quat > 31 || quat == 0) {
+        // 32位的值最高支持q31
+        return MStr_Err_UnsupportQuantBits;
+    }
+    else {
+        return mstr_parse_ifix(value, beg, end, 32 - quat, quat, stop);
+    }
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_uq(
+    uint32_t* value,
+    const char* beg,
+    const char* end,
+    uint32_t quat,
+    const char** stop
+)
+{
+    if (quat > 31 || quat == 0) {
+        // 32位的值最高支持q31
+        return MStr_Err_UnsupportQuantBits;
+    }
+    else {
+        return mstr_parse_ufix(value, beg, end, 32 - quat, quat, stop);
+    }
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_iq64(
+    int64_t* value,
+    const char* beg,
+    const char* end,
+    uint32_t quat,
+    const char** stop
+)
+{
+    const uint64_t max_neg = (uint64_t)1 << 63;
+    uint64_t mag = 0;
+    mstr_bool_t neg = False;
+    mstr_result_t result = MStr_Ok;
+    if (quat > 63 || quat == 0) {
+        // 最高支持q63
+        return MStr_Err_UnsupportQuantBits;
+    }
+    result = parse_fixed(
+        &mag, &neg, beg, end, quat, max_neg - 1, max_neg, stop
+    );
+    if (MSTR_SUCC(result)) {
+        *value = (int64_t)(neg ? (uint64_t)0 - mag : mag);
+    }
+    return result;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_uq64(
+    uint64_t* value,
+    const char* beg,
+    const char* end,
+    uint32_t quat,
+    const char** stop
+)
+{
+    uint64_t mag = 0;
+    mstr_bool_t neg = False;
+    mstr_result_t result = MStr_Ok;
+    if (quat > 63 || quat == 0) {
+        // 最高支持q63
+        return MStr_Err_UnsupportQuantBits;
+    }
+    result = parse_fixed(
+        &mag, &neg, beg, end, quat, ~(uint64_t)0, 0, stop
+    );
+    if (MSTR_SUCC(result)) {
+        *value = mag;
+    }
+    return result;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_ifix(
+    int32_t* value,
+    const char* beg,
+    const char* end,
+    uint32_t ibits,
+    uint32_t fbits,
+    const char** stop
+)
+{
+    uint64_t mag = 0;
+    mstr_bool_t neg = False;
+    mstr_result_t result = fixed_bits_check(ibits, fbits);
+    if (MSTR_SUCC(result)) {
+        const uint64_t max_neg = (uint64_t)1 << (ibits + fbits - 1);
+        result = parse_fixed(
+            &mag, &neg, beg, end, fbits, max_neg - 1, max_neg, stop
+        );
+    }
+    if (MSTR_SUCC(result)) {
+        *value = (int32_t)(neg ? 0u - (uint32_t)mag : (uint32_t)mag);
+    }
+    return result;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_parse_ufix(
+    uint32_t* value,
+    const char* beg,
+    const char* end,
+    uint32_t ibits,
+    uint32_t fbits,
+    const char** stop
+)
+{
+    uint64_t mag = 0;
+    mstr_bool_t neg = False;
+    mstr_result_t result = fixed_bits_check(ibits, fbits);
+    if (MSTR_SUCC(result)) {
+        const uint64_t max_pos = ((uint64_t)1 << (ibits + fbits)) - 1;
+        result = parse_fixed(
+            &mag, &neg, beg, end, fbits, max_pos, 0, stop
+        );
+    }
+    if (MSTR_SUCC(result)) {
+        *value = (uint32_t)mag;
+    }
+    return result;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_scan(const MString* input, const char* fmt, usize_t fmt_place, ...)
+{
+    mstr_result_t res;
+    va_list ap;
+    va_start(ap, fmt_place);
+    res = mstr_vscan(input, fmt, fmt_place, &ap);
+    va_end(ap);
+    return res;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_vscan(
+    const MString* input,
+    const char* fmt,
+    usize_t fmt_place,
+    va_list* ap_ptr
+)
+{
+    MStrFmtArgsContext context = {0};
+    const char* p = input->buff;
+    const char* end = input->buff + input->count;
+    mstr_result_t result = MStr_Ok;
+    if (fmt_place > MFMT_PLACE_MAX_NUM) {
+        return MStr_Err_IndexTooLarge;
+    }
+    context.max_place = fmt_place;
+    context.p_ap = ap_ptr;
+    // 边解析边读取, 不需要保存整个模板
+    while (*fmt != '\0' && MSTR_SUCC(result)) {
+        MStrScanItem item;
+        result = scan_next_item(&item, &fmt);
+        MSTR_AND_THEN(result, scan_item(&p, end, &item, &context));
+    }
+    if (MSTR_SUCC(result) && p != end) {
+        // 多余的输入
+        result = MStr_Err_InputMismatch;
+    }
+    return result;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_scan_compile(MStrScanTemplate* tpl, const char* fmt)
+{
+    mstr_result_t result = MStr_Ok;
+    tpl->item_cnt = 0;
+    while (*fmt != '\0' && MSTR_SUCC(result)) {
+        if (tpl->item_cnt < MFMT_SCAN_ITEM_MAX_NUM) {
+            result = scan_next_item(&tpl->items[tpl->item_cnt], &fmt);
+            tpl->item_cnt += MSTR_SUCC(result) ? 1 : 0;
+        }
+        else {
+            result = MStr_Err_InternalBufferTooSmall;
+        }
+    }
+    return result;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_scan_compiled(
+    const MString* input,
+    const MStrScanTemplate* tpl,
+    usize_t fmt_place,
+    ...
+)
+{
+    mstr_result_t res;
+    va_list ap;
+    va_start(ap, fmt_place);
+    res = scan_template(input, tpl, fmt_place, &ap);
+    va_end(ap);
+    return res;
+}
+
+/**
+ * @brief 按照模板读取
+ *
+ * @param[in] input: 输入
+ * @param[in] tpl: 模板
+ * @param[in] fmt_place: 参数数目
+ * @param[in] ap_ptr: 参数
+ */
+static mstr_result_t scan_template(
+    const MString* input,
+    const MStrScanTemplate* tpl,
+    usize_t fmt_place,
+    va_list* ap_ptr
+)
+{
+    MStrFmtArgsContext context = {0};
+    const char* p = input->buff;
+    const char* end = input->buff + input->count;
+    mstr_result_t result = MStr_Ok;
+    usize_t i;
+    if (fmt_place > MFMT_PLACE_MAX_NUM) {
+        return MStr_Err_IndexTooLarge;
+    }
+    context.max_place = fmt_place;
+    context.p_ap = ap_ptr;
+    for (i = 0; i < tpl->item_cnt && MSTR_SUCC(result); i += 1) {
+        result = scan_item(&p, end, &tpl->items[i], &context);
+    }
+    if (MSTR_SUCC(result) && p != end) {
+        // 多余的输入
+        result = MStr_Err_InputMismatch;
+    }
+    return result;
+}
+
+/**
+ * @brief 解析模板中的下一个项
+ *
+ * @param[out] item: 项
+ * @param[inout] pfmt: & 格式化串
+ *
+ * @note 一段字面量会在'{'和'}'处结束,
+ * 转义字符作为只有一个字符的字面量
+ */
+static mstr_result_t scan_next_item(
+    MStrScanItem* item, const char** pfmt
+)
+{
+    mstr_result_t result = MStr_Ok;
+    const char* fmt = *pfmt;
+    item->literal_beg = fmt;
+    item->typ = MStrFmtArgType_Unknown;
+    while (*fmt != '\0' && *fmt != '{' && *fmt != '}') {
+        fmt += 1;
+    }
+    item->literal_end = fmt;
+    if (fmt == item->literal_beg) {
+        // replacement field
+        MStrFmtParseResult parser_result;
+        MStrFmtParserState* state;
+        byte_t state_memory[MFMT_PARSER_STATE_SIZE];
+        mstr_fmt_parser_init(state_memory, fmt, &state);
+        result = mstr_fmt_parse_goal(state, &parser_result);
+        if (MSTR_SUCC(result)) {
+            fmt += mstr_fmt_parser_end_position(state, fmt);
+            result = scan_item_from_parser(item, &parser_result, fmt);
+        }
+    }
+    *pfmt = fmt;
+    return result;
+}
+
+/**
+ * @brief 把parser的结果转为模板的项
+ *
+ * @param[inout] item: 项, 字面量已经设置好
+ * @param[in] parser_result: parser的结果
+ * @param[in] next: fmt中replacement field之后的位置
+ */
+static mstr_result_t scan_item_from_parser(
+    MStrScanItem* item,
+    const MStrFmtParseResult* parser_result,
+    const char* next
+)
+{
+    mstr_result_t result = MStr_Ok;
+    const MStrFmtParseResultValueResult* val = &parser_result->val.val;
+    switch (parser_result->arg_class) {
+    case MStrFmtArgClass_EscapeChar:
+        // "{{"和"}}"的第一个字符就是转义之后的字符
+        item->literal_end = item->literal_beg + 1;
+        break;
+    case MStrFmtArgClass_Value:
+        item->typ = val->typ;
+        item->id = val->id;
+        item->prop = val->prop;
+        item->index = MStrFmtIntIndex_Dec;
+        item->width = val->spec.width;
+        item->fill_char = val->spec.fill_char;
+        item->align = val->spec.fmt_align;
+        // 字符串读取到下一个字面量字符
+        item->until = next[0];
+        if ((next[0] == '{' || next[0] == '}') && next[1] != next[0]) {
+            item->until = '\0';
+        }
+        switch (val->typ) {
+        case MStrFmtArgType_Int8:
+        case MStrFmtArgType_Int16:
+        case MStrFmtArgType_Int32:
+        case MStrFmtArgType_Uint8:
+        case MStrFmtArgType_Uint16:
+        case MStrFmtArgType_Uint32:
+            result = scan_int_index(
+                &item->index, val->spec.fmt_spec.fmt_type
+            );
+            break;
+        case MStrFmtArgType_CString:
+        case MStrFmtArgType_QuantizedValue:
+        case MStrFmtArgType_QuantizedUnsignedValue:
+        case MStrFmtArgType_QuantizedValue64:
+        case MStrFmtArgType_QuantizedUnsignedValue64:
+        case MStrFmtArgType_FixedValue:
+        case MStrFmtArgType_FixedUnsignedValue: break;
+        default: result = MStr_Err_UnsupportType; break;
+        }
+        break;
+    case MStrFmtArgClass_Array: result = MStr_Err_UnsupportType; break;
+    }
+    return result;
+}
+
+/**
+ * @brief 读取一个项
+ *
+ * @param[inout] pp: & 输入的当前位置
+ * @param[in] end: 输入的结束
+ * @param[in] item: 项
+ * @param[inout] ctx: 参数
+ */
+static mstr_result_t scan_item(
+    const char** pp,
+    const char* end,
+    const MStrScanItem* item,
+    MStrFmtArgsContext* ctx
+)
+{
+    mstr_result_t result = MStr_Ok;
+    const char* p = *pp;
+    usize_t literal_len =
+        (usize_t)(item->literal_end - item->literal_beg);
+    void* out = NULL;
+    if (literal_len > 0) {
+        if ((usize_t)(end - p) < literal_len ||
+            !scan_match_literal(p, item->literal_beg, literal_len)) {
+            return MStr_Err_InputMismatch;
+        }
+        p += literal_len;
+    }
+    if (item->typ != MStrFmtArgType_Unknown) {
+        // 同一个参数已经读取过时, 再次读取的值需要和第一次相同
+        mstr_bool_t repeat =
+            item->id < ctx->max_place &&
+            ctx->cache[item->id].type != MStrFmtArgType_Unknown;
+        result = scan_load_arg(&out, ctx, item->id, item->typ);
+        if (repeat) {
+            MSTR_AND_THEN(
+                result, scan_repeat_field(&p, end, item, out)
+            );
+        }
+        else {
+            MSTR_AND_THEN(result, scan_field(&p, end, item, out));
+        }
+    }
+    if (MSTR_SUCC(result)) {
+        *pp = p;
+    }
+    return result;
+}
+
+/**
+ * @brief 读取一个值
+ *
+ * @param[inout] pp: & 输入的当前位置
+ * @param[in] end: 输入的结束
+ * @param[in] item: 项
+ * @param[out] out: 结果
+ */
+static mstr_result_t scan_field(
+    const char** pp,
+    const char* end,
+    const MStrScanItem* item,
+    void* out
+)
+{
+    mstr_result_t result = MStr_Ok;
+    const char* beg = *pp;
+    const char* stop = end;
+    const char** pstop = &stop;
+    const MStrFmtArgProperty* prop = &item->prop;
+    if (item->width > 0) {
+        // 读取宽度个字符, 并去掉填充的一侧的填充字符
+        if (end - beg > item->width) {
+            end = beg + item->width;
+        }
+        stop = end;
+        pstop = NULL;
+        if (item->align != MStrFmtAlign_Left) {
+            beg = scan_trim_fill(beg, end, item);
+        }
+        if (item->align != MStrFmtAlign_Right) {
+            while (end - beg > 1 && end[-1] == item->fill_char) {
+                end -= 1;
+            }
+        }
+    }
+    switch (item->typ) {
+    case MStrFmtArgType_Int8:
+        result = scan_int(out, 8, beg, end, item->index, pstop);
+        break;
+    case MStrFmtArgType_Int16:
+        result = scan_int(out, 16, beg, end, item->index, pstop);
+        break;
+    case MStrFmtArgType_Int32:
+        result = scan_int(out, 32, beg, end, item->index, pstop);
+        break;
+    case MStrFmtArgType_Uint8:
+        result = scan_uint(out, 8, beg, end, item->index, pstop);
+        break;
+    case MStrFmtArgType_Uint16:
+        result = scan_uint(out, 16, beg, end, item->index, pstop);
+        break;
+    case MStrFmtArgType_Uint32:
+        result = scan_uint(out, 32, beg, end, item->index, pstop);
+        break;
+    case MStrFmtArgType_QuantizedValue:
+        result = mstr_parse_iq(out, beg, end, prop->a, pstop);
+        break;
+    case MStrFmtArgType_QuantizedUnsignedValue:
+        result = mstr_parse_uq(out, beg, end, prop->a, pstop);
+        break;
+    case MStrFmtArgType_QuantizedValue64:
+        result = mstr_parse_iq64(out, beg, end, prop->a, pstop);
+        break;
+    case MStrFmtArgType_QuantizedUnsignedValue64:
+        result = mstr_parse_uq64(out, beg, end, prop->a, pstop);
+        break;
+    case MStrFmtArgType_FixedValue:
+        result = mstr_parse_ifix(
+            out, beg, end, prop->a, prop->b, pstop
+        );
+        break;
+    case MStrFmtArgType_FixedUnsignedValue:
+        result = mstr_parse_ufix(
+            out, beg, end, prop->a, prop->b, pstop
+        );
+        break;
+    case MStrFmtArgType_CString:
+        if (pstop != NULL && item->until != '\0') {
+            const char* until =
+                memchr(beg, item->until, (usize_t)(end - beg));
+            end = until != NULL ? until : end;
+            stop = end;
+        }
+        mstr_clear((MString*)out);
+        result = mstr_concat_cstr_slice((MString*)out, beg, end);
+        break;
+    default: result = MStr_Err_UnsupportType; break;
+    }
+    if (MSTR_SUCC(result)) {
+        *pp = stop;
+    }
+    return result;
+}
+
+/**
+ * @brief 读取重复使用的参数, 值和第一次读取的不同时返回
+ * MStr_Err_InputMismatch
+ *
+ * @param[in] first: 第一次读取的结果
+ */
+static mstr_result_t scan_repeat_field(
+    const char** pp,
+    const char* end,
+    const MStrScanItem* item,
+    const void* first
+)
+{
+    mstr_result_t result = MStr_Ok;
+    if (item->typ == MStrFmtArgType_CString) {
+        MString value;
+        result = mstr_create_empty(&value);
+        MSTR_AND_THEN(result, scan_field(pp, end, item, &value));
+        if (MSTR_SUCC(result) &&
+            !mstr_equal(&value, (const MString*)first)) {
+            result = MStr_Err_InputMismatch;
+        }
+        mstr_free(&value);
+    }
+    else {
+        uint64_t value = 0;
+        result = scan_field(pp, end, item, &value);
+        if (MSTR_SUCC(result) &&
+            memcmp(&value, first, scan_value_size(item->typ)) != 0) {
+            result = MStr_Err_InputMismatch;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief 数值类型的结果的大小
+ *
+ */
+static usize_t scan_value_size(MStrFmtArgType typ)
+{
+    switch (typ) {
+    case MStrFmtArgType_Int8:
+    case MStrFmtArgType_Uint8: return 1;
+    case MStrFmtArgType_Int16:
+    case MStrFmtArgType_Uint16: return 2;
+    case MStrFmtArgType_QuantizedValue64:
+    case MStrFmtArgType_QuantizedUnsignedValue64: return 8;
+    default: return 4;
+    }
+}
+
+/**
+ * @brief 去掉开头的填充字符, 至少保留一个字符
+ *
+ * @note 数值用'0'填充时, '0'本身就是合法的数值,
+ * 只有'0'后面是符号时才去掉, 否则交给转换函数
+ */
+static const char* scan_trim_fill(
+    const char* beg, const char* end, const MStrScanItem* item
+)
+{
+    const char* p = beg;
+    while (end - p > 1 && *p == item->fill_char) {
+        p += 1;
+    }
+    if (item->fill_char == '0' && item->typ != MStrFmtArgType_CString &&
+        *p != '+' && *p != '-') {
+        return beg;
+    }
+    return p;
+}
+
+/**
+ * @brief 读取有符号整数
+ *
+ * @param[out] out: 结果, 按照bits写入int8_t, int16_t或者int32_t
+ * @param[in] bits: 整数的位数
+ */
+static mstr_result_t scan_int(
+    void* out,
+    uint32_t bits,
+    const char* beg,
+    const char* end,
+    MStrFmtIntIndex index,
+    const char** stop
+)
+{
+    const int32_t max = (int32_t)((1u << (bits - 1)) - 1);
+    int32_t value = 0;
+    mstr_result_t result =
+        mstr_parse_i32(&value, beg, end, index, stop);
+    if (MSTR_SUCC(result) && (value > max || value < -max - 1)) {
+        result = MStr_Err_NumberOutOfRange;
+    }
+    if (MSTR_SUCC(result)) {
+        if (bits == 8) {
+            *(int8_t*)out = (int8_t)value;
+        }
+        else if (bits == 16) {
+            *(int16_t*)out = (int16_t)value;
+        }
+        else {
+            *(int32_t*)out = value;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief 读取无符号整数
+ *
+ * @param[out] out: 结果, 按照bits写入uint8_t, uint16_t或者uint32_t
+ * @param[in] bits: 整数的位数
+ */
+static mstr_result_t scan_uint(
+    void* out,
+    uint32_t bits,
+    const char* beg,
+    const char* end,
+    MStrFmtIntIndex index,
+    const char** stop
+)
+{
+    const uint32_t max = (uint32_t)(((uint64_t)1 << bits) - 1);
+    uint32_t value = 0;
+    mstr_result_t result =
+        mstr_parse_u32(&value, beg, end, index, stop);
+    if (MSTR_SUCC(result) && value > max) {
+        result = MStr_Err_NumberOutOfRange;
+    }
+    if (MSTR_SUCC(result)) {
+        if (bits == 8) {
+            *(uint8_t*)out = (uint8_t)value;
+        }
+        else if (bits == 16) {
+            *(uint16_t*)out = (uint16_t)value;
+        }
+        else {
+            *(uint32_t*)out = value;
+        }
+    }
+    return result;
+}
+
+/**
+ * @brief 从可变参数里面载入结果的指针
+ *
+ * @param[out] out: 结果的指针
+ * @param[inout] ctx: Context
+ * @param[in] arg_id: 参数id
+ * @param[in] spec_type: 指定的参数值类型
+ *
+ * @note 和格式化一样, 参数需要按顺序使用,
+ * 同一个参数使用多次时类型需要一致
+ */
+static mstr_result_t scan_load_arg(
+    void** out,
+    MStrFmtArgsContext* ctx,
+    uint32_t arg_id,
+    MStrFmtArgType spec_type
+)
+{
+    MStrFmtFormatArgument* cache = ctx->cache;
+    if (arg_id >= ctx->max_place) {
+        return MStr_Err_InvaildArgumentID;
+    }
+    if (arg_id > 0 &&
+        cache[arg_id - 1].type == MStrFmtArgType_Unknown) {
+        return MStr_Err_UnusedArgumentID;
+    }
+    if (cache[arg_id].type == MStrFmtArgType_Unknown) {
+        cache[arg_id].value = (iptr_t)va_arg(*ctx->p_ap, iptr_t);
+        cache[arg_id].type = spec_type;
+    }
+    else if (cache[arg_id].type != spec_type) {
+        return MStr_Err_InvaildArgumentType;
+    }
+    *out = (void*)cache[arg_id].value;
+    return MStr_Ok;
+}
+
+/**
+ * @brief 把 MStrFmtFormatType 转为 整数的index
+ *
+ * @param[out] index: 结果
+ * @param[in] typ: MStrFmtFormatType
+ */
+static mstr_result_t scan_int_index(
+    MStrFmtIntIndex* index, MStrFmtFormatType typ
+)
+{
+    mstr_result_t result = MStr_Ok;
+    switch (typ) {
+    case MStrFmtFormatType_Binary: *index = MStrFmtIntIndex_Bin; break;
+    case MStrFmtFormatType_Oct: *index = MStrFmtIntIndex_Oct; break;
+    case MStrFmtFormatType_Hex:
+    case MStrFmtFormatType_Hex_UpperCase:
+        // 读取时不区分大小写
+        *index = MStrFmtIntIndex_Hex;
+        break;
+    case MStrFmtFormatType_Hex_WithPrefix:
+    case MStrFmtFormatType_Hex_UpperCase_WithPrefix:
+        *index = MStrFmtIntIndex_Hex_WithPrefix;
+        break;
+    case MStrFmtFormatType_UnSpec:
+    case MStrFmtFormatType_Deciaml: *index = MStrFmtIntIndex_Dec; break;
+    default:
+        // 只能用于字节数组
+        result = MStr_Err_UnsupportFormatType;
+        break;
+    }
+    return result;
+}
+
+/**
+ * @brief 比较输入和字面量
+ *
+ * @param[in] p: 输入, 至少有len个字符
+ * @param[in] lit: 字面量
+ * @param[in] len: 字面量的长度
+ *
+ * @note 有SSE2时每次比较16个字节, 否则每次比较8个字节
+ */
+static mstr_bool_t scan_match_literal(
+    const char* p, const char* lit, usize_t len
+)
+{
+#if _MSTR_USE_SIMD_SSE2
+    while (len >= 16) {
+        __m128i a = _mm_loadu_si128((const __m128i*)p);
+        __m128i b = _mm_loadu_si128((const __m128i*)lit);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xffff) {
+            return False;
+        }
+        p += 16;
+        lit += 16;
+        len -= 16;
+    }
+#endif // _MSTR_USE_SIMD_SSE2
+    while (len >= 8) {
+        if (load_u64_le(p) != load_u64_le(lit)) {
+            return False;
+        }
+        p += 8;
+        lit += 8;
+        len -= 8;
+    }
+    while (len > 0) {
+        if (*p != *lit) {
+            return False;
+        }
+        p += 1;
+        lit += 1;
+        len -= 1;
+    }
+    return True;
+}
+
+/**
+ * @brief 转换整数
+ *
+ * @param[out] value: 绝对值
+ * @param[out] neg: 是否为负数
+ * @param[in] beg: 字符串的开始
+ * @param[in] end: 字符串的结束
+ * @param[in] index: Index
+ * @param[in] max_pos: 正数的最大值
+ * @param[in] max_neg: 负数绝对值的最大值, 为0表示不允许'-'号
+ * @param[out] stop: 转换结束的位置, 可以为NULL
+ */
+static mstr_result_t parse_integer(
+    uint64_t* value,
+    mstr_bool_t* neg,
+    const char* beg,
+    const char* end,
+    MStrFmtIntIndex index,
+    uint64_t max_pos,
+    uint64_t max_neg,
+    const char** stop
+)
+{
+    uint64_t mag = 0;
+    mstr_bool_t is_neg = False;
+    mstr_bool_t overflow = False;
+    const char* digits;
+    const char* p = scan_sign(&is_neg, beg, end);
+    if (is_neg && max_neg == 0) {
+        return MStr_Err_InvalidNumber;
+    }
+    if (index == MStrFmtIntIndex_Hex_WithPrefix ||
+        index == MStrFmtIntIndex_Hex_UpperCase_WithPrefix) {
+        // "0x" 或者 "0X"
+        if (end - p < 2 || p[0] != '0' || (p[1] | 0x20) != 'x') {
+            return MStr_Err_InvalidNumber;
+        }
+        p += 2;
+    }
+    digits = p;
+    switch (index) {
+    case MStrFmtIntIndex_Bin:
+        p = scan_2base(&mag, &overflow, p, end, 1);
+        break;
+    case MStrFmtIntIndex_Oct:
+        p = scan_2base(&mag, &overflow, p, end, 3);
+        break;
+    case MStrFmtIntIndex_Dec:
+        p = scan_10base(&mag, &overflow, p, end);
+        break;
+    case MStrFmtIntIndex_Hex:
+    case MStrFmtIntIndex_Hex_UpperCase:
+    case MStrFmtIntIndex_Hex_WithPrefix:
+    case MStrFmtIntIndex_Hex_UpperCase_WithPrefix:
+        p = scan_2base(&mag, &overflow, p, end, 4);
+        break;
+    default: return MStr_Err_UnsupportFormatType;
+    }
+    if (p == digits || (stop == NULL && p != end)) {
+        return MStr_Err_InvalidNumber;
+    }
+    if (overflow || mag > (is_neg ? max_neg : max_pos)) {
+        return MStr_Err_NumberOutOfRange;
+    }
+    *value = mag;
+    *neg = is_neg;
+    if (stop != NULL) {
+        *stop = p;
+    }
+    return MStr_Ok;
+}
+
+/**
+ * @brief 转换十进制小数到定点数
+ *
+ * @param[out] value: 绝对值, 包括fbits位小数
+ * @param[out] neg: 是否为负数
+ * @param[in] beg: 字符串的开始
+ * @param[in] end: 字符串的结束
+ * @param[in] fbits: 小数部分的位数, 0 ~ 63
+ * @param[in] max_pos: 正数的最大值
+ * @param[in] max_neg: 负数绝对值的最大值, 为0表示不允许'-'号
+ * @param[out] stop: 转换结束的位置, 可以为NULL
+ *
+ * @note 接受 `[+|-]digits[.[digits]]` 和 `[+|-].digits`
+ */
+static mstr_result_t parse_fixed(
+    uint64_t* value,
+    mstr_bool_t* neg,
+    const char* beg,
+    const char* end,
+    uint32_t fbits,
+    uint64_t max_pos,
+    uint64_t max_neg,
+    const char** stop
+)
+{
+    ScanDecimalFrac frac;
+    uint64_t ipart = 0, fpart, mag;
+    mstr_bool_t is_neg = False;
+    mstr_bool_t overflow = False;
+    mstr_bool_t has_digits;
+    const char* digits;
+    const char* p = scan_sign(&is_neg, beg, end);
+    if (is_neg && max_neg == 0) {
+        return MStr_Err_InvalidNumber;
+    }
+    // 整数部分
+    digits = p;
+    p = scan_10base(&ipart, &overflow, p, end);
+    has_digits = p != digits;
+    // 小数部分
+    frac.limb_cnt = 0;
+    frac.sticky = False;
+    if (p < end && *p == '.') {
+        const char* frac_end = scan_frac(&frac, p + 1, end);
+        if (has_digits || frac_end != p + 1) {
+            has_digits = True;
+            p = frac_end;
+        }
+    }
+    if (!has_digits || (stop == NULL && p != end)) {
+        return MStr_Err_InvalidNumber;
+    }
+    // 合并, 小数部分舍入之后可能进位到整数部分
+    fpart = frac_to_bits(&frac, fbits);
+    if (fbits != 0 && (ipart >> (64 - fbits)) != 0) {
+        overflow = True;
+    }
+    mag = (ipart << fbits) + fpart;
+    if (mag < fpart) {
+        overflow = True;
+    }
+    if (overflow || mag > (is_neg ? max_neg : max_pos)) {
+        return MStr_Err_NumberOutOfRange;
+    }
+    *value = mag;
+    *neg = is_neg;
+    if (stop != NULL) {
+        *stop = p;
+    }
+    return MStr_Ok;
+}
+
+/**
+ * @brief 检查定点数的位数
+ *
+ * @param[in] ibits: 整数部分的位数
+ * @param[in] fbits: 小数部分的位数
+ */
+static mstr_result_t fixed_bits_check(uint32_t ibits, uint32_t fbits)
+{
+    uint32_t bits = ibits + fbits;
+    if (ibits > 32 || fbits > 32 || bits == 0 || bits > 32) {
+        // 32位的值最多32位
+        return MStr_Err_UnsupportQuantBits;
+    }
+    else {
+        return MStr_Ok;
+    }
+}
+
+/**
+ * @brief 读取可选的符号
+ *
+ * @param[out] neg: 是否为'-'号
+ * @param[in] p: 开始位置
+ * @param[in] end: 字符串的结束
+ *
+ * @return const char*: 符号之后的位置
+ */
+static const char* scan_sign(
+    mstr_bool_t* neg, const char* p, const char* end
+)
+{
+    if (p < end && (*p == '+' || *p == '-')) {
+        *neg = *p == '-';
+        return p + 1;
+    }
+    else {
+        *neg = False;
+        return p;
+    }
+}
+
+/**
+ * @brief 读取十进制数
+ *
+ * @param[out] value: 值, 溢出时没有意义
+ * @param[out] overflow: 是否超出了64位
+ * @param[in] p: 开始位置
+ * @param[in] end: 字符串的结束
+ *
+ * @return const char*: 最后一个数字之后的位置
+ *
+ * @note 先每次转换SCAN_BATCH_DIGITS个数字, 剩下的再逐个转换
+ */
+static const char* scan_10base(
+    uint64_t* value,
+    mstr_bool_t* overflow,
+    const char* p,
+    const char* end
+)
+{
+    uint64_t v = 0;
+    mstr_bool_t ovf = False;
+    while (end - p >= SCAN_BATCH_DIGITS) {
+        uint64_t chunk = load_u64_le(p);
+        uint32_t batch;
+        if (!swar_is_8digits(chunk)) {
+            break;
+        }
+        batch = swar_8digits_value(chunk);
+        if (v > SCAN_U64_MAX_DIV_1E8 ||
+            (v == SCAN_U64_MAX_DIV_1E8 &&
+             batch > SCAN_U64_MAX_MOD_1E8)) {
+            ovf = True;
+        }
+        v = v * SCAN_LIMB_BASE + batch;
+        p += SCAN_BATCH_DIGITS;
+    }
+    while (p < end && digit_value(*p) < 10) {
+        uint32_t d = digit_value(*p);
+        if (v > SCAN_U64_MAX_DIV_10 ||
+            (v == SCAN_U64_MAX_DIV_10 && d > 5)) {
+            ovf = True;
+        }
+        v = v * 10 + d;
+        p += 1;
+    }
+    *value = v;
+    *overflow = ovf;
+    return p;
+}
+
+/**
+ * @brief 读取2^n进制的数
+ *
+ * @param[out] value: 值, 溢出时没有意义
+ * @param[out] overflow: 是否超出了64位
+ * @param[in] p: 开始位置
+ * @param[in] end: 字符串的结束
+ * @param[in] shift: 每个数字的位数, 1 (二进制), 3 (八进制)
+ * 或者4 (十六进制)
+ *
+ * @return const char*: 最后一个数字之后的位置
+ */
+static const char* scan_2base(
+    uint64_t* value,
+    mstr_bool_t* overflow,
+    const char* p,
+    const char* end,
+    uint32_t shift
+)
+{
+    uint64_t v = 0;
+    mstr_bool_t ovf = False;
+    while (p < end) {
+        uint32_t d = digit_value(*p);
+        if (d >= (1u << shift)) {
+            break;
+        }
+        if ((v >> (64 - shift)) != 0) {
+            ovf = True;
+        }
+        v = (v << shift) | d;
+        p += 1;
+    }
+    *value = v;
+    *overflow = ovf;
+    return p;
+}
+
+/**
+ * @brief 读取小数部分的数字
+ *
+ * @param[out] frac: 小数部分
+ * @param[in] p: 小数点之后的位置
+ * @param[in] end: 字符串的结束
+ *
+ * @return const char*: 最后一个数字之后的位置
+ */
+static const char* scan_frac(
+    ScanDecimalFrac* frac, const char* p, const char* end
+)
+{
+    uint32_t limb = 0;
+    uint32_t limb_digits = 0;
+    while (p < end && frac->limb_cnt < SCAN_FRAC_LIMBS) {
+        if (limb_digits == 0 && end - p >= SCAN_BATCH_DIGITS) {
+            uint64_t chunk = load_u64_le(p);
+            if (swar_is_8digits(chunk)) {
+                frac->limbs[frac->limb_cnt] = swar_8digits_value(chunk);
+                frac->limb_cnt += 1;
+                p += SCAN_BATCH_DIGITS;
+                continue;
+            }
+        }
+        if (digit_value(*p) >= 10) {
+            break;
+        }
+        limb = limb * 10 + digit_value(*p);
+        limb_digits += 1;
+        p += 1;
+        if (limb_digits == SCAN_BATCH_DIGITS) {
+            frac->limbs[frac->limb_cnt] = limb;
+            frac->limb_cnt += 1;
+            limb = 0;
+            limb_digits = 0;
+        }
+    }
+    if (limb_digits != 0) {
+        // 最后一个limb补齐到SCAN_BATCH_DIGITS位
+        while (limb_digits < SCAN_BATCH_DIGITS) {
+            limb *= 10;
+            limb_digits += 1;
+        }
+        frac->limbs[frac->limb_cnt] = limb;
+        frac->limb_cnt += 1;
+    }
+    // 超出limbs的部分只记录是否为0
+    while (p < end && digit_value(*p) < 10) {
+        if (*p != '0') {
+            frac->sticky = True;
+        }
+        p += 1;
+    }
+    while (frac->limb_cnt > 0 && frac->limbs[frac->limb_cnt - 1] == 0) {
+        frac->limb_cnt -= 1;
+    }
+    return p;
+}
+
+/**
+ * @brief 把十进制的小数部分转换为fbits位二进制小数
+ *
+ * @param[inout] frac: 小数部分, 转换之后是剩下的部分
+ * @param[in] fbits: 小数部分的位数, 0 ~ 63
+ *
+ * @return uint64_t: 按照四舍六入五成双舍入的结果, 可能等于2^fbits
+ *
+ * @note 每次把小数乘以2, 整数部分就是下一个二进制位, 是精确的
+ */
+static uint64_t frac_to_bits(ScanDecimalFrac* frac, uint32_t fbits)
+{
+    uint64_t bits = 0;
+    uint32_t i;
+    mstr_bool_t round_bit, rest;
+    if (frac->limb_cnt <= 2 && !frac->sticky) {
+        // 最多16个十进制位, 可以直接使用64位整数
+        const uint64_t base = (uint64_t)SCAN_LIMB_BASE * SCAN_LIMB_BASE;
+        uint64_t r = 0;
+        if (frac->limb_cnt > 0) {
+            r = (uint64_t)frac->limbs[0] * SCAN_LIMB_BASE;
+        }
+        if (frac->limb_cnt > 1) {
+            r += frac->limbs[1];
+        }
+        for (i = 0; i <= fbits; i += 1) {
+            r <<= 1;
+            bits <<= 1;
+            if (r >= base) {
+                r -= base;
+                bits |= 1;
+            }
+        }
+        rest = r != 0;
+    }
+    else {
+        // 多转换1位作为舍入位
+        for (i = 0; i <= fbits && frac->limb_cnt > 0; i += 1) {
+            bits = (bits << 1) | frac_double(frac);
+        }
+        if (bits != 0) {
+            // 剩下的位都是0
+            bits <<= fbits + 1 - i;
+        }
+        rest = frac->limb_cnt != 0 || frac->sticky;
+    }
+    round_bit = (bits & 1) != 0;
+    bits >>= 1;
+    if (round_bit && (rest || (bits & 1) != 0)) {
+        bits += 1;
+    }
+    return bits;
+}
+
+/**
+ * @brief 把小数部分乘以2
+ *
+ * @param[inout] frac: 小数部分
+ *
+ * @return uint32_t: 进位到整数部分的值, 0或者1
+ */
+static uint32_t frac_double(ScanDecimalFrac* frac)
+{
+    uint32_t carry = 0;
+    usize_t i = frac->limb_cnt;
+    while (i > 0) {
+        uint32_t v;
+        i -= 1;
+        v = (frac->limbs[i] << 1) + carry;
+        carry = v >= SCAN_LIMB_BASE ? 1 : 0;
+        frac->limbs[i] = v - carry * SCAN_LIMB_BASE;
+    }
+    while (frac->limb_cnt > 0 && frac->limbs[frac->limb_cnt - 1] == 0) {
+        frac->limb_cnt -= 1;
+    }
+    return carry;
+}
+
+/**
+ * @brief 取得一个数字的值, 字母不区分大小写
+ *
+ * @return uint32_t: 数字的值, 不是数字或者字母时返回0xff
+ */
+static uint32_t digit_value(char ch)
+{
+    uint32_t c = (uint32_t)(byte_t)ch;
+    if (c - '0' < 10) {
+        return c - '0';
+    }
+    c |= 0x20;
+    if (c - 'a' < 26) {
+        return c - 'a' + 10;
+    }
+    return 0xff;
+}
+
+/**
+ * @brief 按照小端序读取8个字符, 第一个字符在最低字节
+ *
+ */
+static uint64_t load_u64_le(const char* p)
+{
+    const byte_t* b = (const byte_t*)p;
+    return (uint64_t)b[0] | ((uint64_t)b[1] << 8) |
+           ((uint64_t)b[2] << 16) | ((uint64_t)b[3] << 24) |
+           ((uint64_t)b[4] << 32) | ((uint64_t)b[5] << 40) |
+           ((uint64_t)b[6] << 48) | ((uint64_t)b[7] << 56);
+}
+
+/**
+ * @brief 判断8个字符是否都是十进制数字
+ *
+ * @note 高4位都是3, 并且低4位加上6之后不会进位
+ */
+static mstr_bool_t swar_is_8digits(uint64_t x)
+{
+    const uint64_t hi_mask = 0xf0f0f0f0f0f0f0f0ull;
+    uint64_t t = (x + 0x0606060606060606ull) & hi_mask;
+    return ((x & hi_mask) | (t >> 4)) == 0x3333333333333333ull;
+}
+
+/**
+ * @brief 把8个十进制数字转换为值
+ *
+ * @note 依次合并相邻的1位、2位、4位数字, 只需要3次乘法
+ */
+static uint32_t swar_8digits_value(uint64_t x)
+{
+    const uint64_t mask = 0x000000ff000000ffull;
+    // 100 + (1000000 << 32)
+    const uint64_t mul1 = 0x000f424000000064ull;
+    // 1 + (10000 << 32)
+    const uint64_t mul2 = 0x0000271000000001ull;
+    x -= 0x3030303030303030ull;
+    x = x * 10 + (x >> 8);
+    x = ((x & mask) * mul1 + ((x >> 16) & mask) * mul2) >> 32;
+    return (uint32_t)x;
+}
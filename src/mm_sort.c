@@ -0,0 +1,465 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    mm_sort.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   字符串数组的排序
+ * @version 1.0
+ * @date    2023-09-02
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+
+#define MSTR_IMP_SOURCES 1
+
+#include "mm_sort.h"
+#include "mm_heap.h"
+#include <stddef.h>
+#include <string.h>
+
+//! 元素数目不超过它时使用插入排序
+#define SORT_INSERTION_SIZE 16
+
+//! 按首字节分桶时的桶数目, 0号桶是空字符串
+#define SORT_BUCKET_NUM 257
+
+/**
+ * @brief 排序项
+ *
+ */
+typedef struct tagSortEntry
+{
+    /**
+     * @brief 从当前深度开始的8个字节, 按大端序拼接, 不足的部分补0
+     *
+     */
+    uint64_t key;
+
+    /**
+     * @brief 内容
+     *
+     */
+    const char* buff;
+
+    /**
+     * @brief 字节数
+     *
+     */
+    usize_t count;
+
+    /**
+     * @brief 在原来的数组中的位置
+     *
+     */
+    usize_t index;
+} SortEntry;
+
+/**
+ * @brief 按首字节分的桶
+ *
+ */
+typedef struct tagSortBucket
+{
+    SortEntry* base;
+    usize_t count;
+} SortBucket;
+
+//
+// private:
+//
+
+static void sort_entries(SortEntry*, usize_t, const MStrSortPool*);
+static void sort_parallel(SortEntry*, usize_t, const MStrSortPool*);
+static void sort_task(void*);
+static void sort_mkqs(SortEntry*, usize_t, usize_t);
+static usize_t sort_finished(SortEntry*, usize_t, usize_t);
+static void sort_insertion(SortEntry*, usize_t, usize_t);
+static int sort_compare(const SortEntry*, const SortEntry*, usize_t);
+static void sort_load_key(SortEntry*, usize_t, usize_t);
+static uint64_t sort_key(const char*, usize_t, usize_t);
+static uint64_t sort_median3(uint64_t, uint64_t, uint64_t);
+static usize_t sort_bucket_of(const SortEntry*);
+static void sort_swap(SortEntry*, SortEntry*);
+
+//
+// public:
+//
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_sort(MString* arr, usize_t cnt, const MStrSortPool* pool)
+{
+    SortEntry* ent;
+    MString tmp;
+    usize_t i;
+    if (cnt < 2) {
+        return MStr_Ok;
+    }
+    ent = (SortEntry*)mstr_heap_alloc(cnt * sizeof(SortEntry));
+    if (ent == NULL) {
+        return MStr_Err_HeapTooSmall;
+    }
+    for (i = 0; i < cnt; i += 1) {
+        ent[i].buff = arr[i].buff;
+        ent[i].count = arr[i].count;
+        ent[i].index = i;
+    }
+    sort_entries(ent, cnt, pool);
+    // 按照排序的结果沿着环移动, 每个环只需要一个临时对象
+    tmp.buff = NULL;
+    for (i = 0; i < cnt; i += 1) {
+        usize_t j = i;
+        if (ent[i].index == i) {
+            continue;
+        }
+        mstr_move_from(&tmp, &arr[i]);
+        for (;;) {
+            usize_t k = ent[j].index;
+            ent[j].index = j;
+            if (k == i) {
+                mstr_move_from(&arr[j], &tmp);
+                break;
+            }
+            mstr_move_from(&arr[j], &arr[k]);
+            j = k;
+        }
+    }
+    mstr_heap_free(ent);
+    return MStr_Ok;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_sort_view(MStringView* arr, usize_t cnt, const MStrSortPool* pool)
+{
+    SortEntry* ent;
+    MStringView tmp;
+    usize_t i;
+    if (cnt < 2) {
+        return MStr_Ok;
+    }
+    ent = (SortEntry*)mstr_heap_alloc(cnt * sizeof(SortEntry));
+    if (ent == NULL) {
+        return MStr_Err_HeapTooSmall;
+    }
+    for (i = 0; i < cnt; i += 1) {
+        ent[i].buff = arr[i].buff;
+        ent[i].count = arr[i].count;
+        ent[i].index = i;
+    }
+    sort_entries(ent, cnt, pool);
+    for (i = 0; i < cnt; i += 1) {
+        usize_t j = i;
+        if (ent[i].index == i) {
+            continue;
+        }
+        tmp = arr[i];
+        for (;;) {
+            usize_t k = ent[j].index;
+            ent[j].index = j;
+            if (k == i) {
+                arr[j] = tmp;
+                break;
+            }
+            arr[j] = arr[k];
+            j = k;
+        }
+    }
+    mstr_heap_free(ent);
+    return MStr_Ok;
+}
+
+/**
+ * @brief 排序
+ *
+ */
+static void sort_entries(
+    SortEntry* ent, usize_t cnt, const MStrSortPool* pool
+)
+{
+    if (pool != NULL && cnt > pool->threshold) {
+        sort_parallel(ent, cnt, pool);
+    }
+    else {
+        sort_load_key(ent, cnt, 0);
+        sort_mkqs(ent, cnt, 0);
+    }
+}
+
+/**
+ * @brief 先按首字节原地分桶 (MSD基数排序的第一趟),
+ * 再把各个桶交给线程池
+ *
+ */
+static void sort_parallel(
+    SortEntry* ent, usize_t cnt, const MStrSortPool* pool
+)
+{
+    SortBucket bucket[SORT_BUCKET_NUM];
+    SortEntry* start;
+    usize_t i, b;
+    memset(bucket, 0, sizeof(bucket));
+    for (i = 0; i < cnt; i += 1) {
+        bucket[sort_bucket_of(&ent[i])].count += 1;
+    }
+    start = ent;
+    for (b = 0; b < SORT_BUCKET_NUM; b += 1) {
+        bucket[b].base = start;
+        start += bucket[b].count;
+    }
+    // base是下一个要放的位置, count是剩下的数目
+    for (b = 0; b < SORT_BUCKET_NUM; b += 1) {
+        while (bucket[b].count > 0) {
+            SortEntry* p = bucket[b].base;
+            usize_t c = sort_bucket_of(p);
+            while (c != b) {
+                sort_swap(p, bucket[c].base);
+                bucket[c].base += 1;
+                bucket[c].count -= 1;
+                c = sort_bucket_of(p);
+            }
+            bucket[b].base += 1;
+            bucket[b].count -= 1;
+        }
+    }
+    // 现在base是各个桶的结尾
+    start = ent;
+    for (b = 0; b < SORT_BUCKET_NUM; b += 1) {
+        SortEntry* end = bucket[b].base;
+        bucket[b].base = start;
+        bucket[b].count = (usize_t)(end - start);
+        start = end;
+    }
+    // 0号桶都是空字符串, 不需要排序
+    for (b = 1; b < SORT_BUCKET_NUM; b += 1) {
+        if (bucket[b].count < 2 || bucket[b].count < pool->task_size) {
+            continue;
+        }
+        if (!pool->submit(pool->capture, sort_task, &bucket[b])) {
+            sort_task(&bucket[b]);
+        }
+    }
+    for (b = 1; b < SORT_BUCKET_NUM; b += 1) {
+        if (bucket[b].count >= 2 && bucket[b].count < pool->task_size) {
+            sort_task(&bucket[b]);
+        }
+    }
+    pool->wait(pool->capture);
+}
+
+/**
+ * @brief 对一个桶排序, 桶内的首字节都相同
+ *
+ */
+static void sort_task(void* arg)
+{
+    SortBucket* bucket = (SortBucket*)arg;
+    sort_load_key(bucket->base, bucket->count, 1);
+    sort_mkqs(bucket->base, bucket->count, 1);
+}
+
+/**
+ * @brief 多关键字快速排序, 关键字是从depth开始的8个字节
+ *
+ * @param[inout] ent: 排序项, key已经按照depth加载
+ * @param[in] cnt: 数目
+ * @param[in] depth: 前面depth个字节都相同
+ */
+static void sort_mkqs(SortEntry* ent, usize_t cnt, usize_t depth)
+{
+    while (cnt > SORT_INSERTION_SIZE) {
+        uint64_t pivot = sort_median3(
+            ent[0].key, ent[cnt / 2].key, ent[cnt - 1].key
+        );
+        usize_t lt = 0, i = 0, gt = cnt;
+        usize_t fin, eq_cnt, gt_cnt;
+        SortEntry* eq;
+        while (i < gt) {
+            if (ent[i].key < pivot) {
+                sort_swap(&ent[lt], &ent[i]);
+                lt += 1;
+                i += 1;
+            }
+            else if (ent[i].key > pivot) {
+                gt -= 1;
+                sort_swap(&ent[i], &ent[gt]);
+            }
+            else {
+                i += 1;
+            }
+        }
+        // 相等的部分中已经结束的字符串已经有序, 放在前面
+        fin = sort_finished(ent + lt, gt - lt, depth);
+        eq = ent + lt + fin;
+        eq_cnt = gt - lt - fin;
+        gt_cnt = cnt - gt;
+        sort_load_key(eq, eq_cnt, depth + 8);
+        // 递归处理较小的两部分, 最大的部分继续循环,
+        // 这样递归的深度不超过log(cnt)
+        if (lt >= eq_cnt && lt >= gt_cnt) {
+            sort_mkqs(eq, eq_cnt, depth + 8);
+            sort_mkqs(ent + gt, gt_cnt, depth);
+            cnt = lt;
+        }
+        else if (eq_cnt >= gt_cnt) {
+            sort_mkqs(ent, lt, depth);
+            sort_mkqs(ent + gt, gt_cnt, depth);
+            ent = eq;
+            cnt = eq_cnt;
+            depth += 8;
+        }
+        else {
+            sort_mkqs(ent, lt, depth);
+            sort_mkqs(eq, eq_cnt, depth + 8);
+            ent += gt;
+            cnt = gt_cnt;
+        }
+    }
+    sort_insertion(ent, cnt, depth);
+}
+
+/**
+ * @brief 把key相同并且在这8个字节内结束的字符串按长度排好,
+ * 放在前面
+ *
+ * @return usize_t: 这样的字符串的数目
+ */
+static usize_t sort_finished(SortEntry* ent, usize_t cnt, usize_t depth)
+{
+    usize_t fin = 0, pos = 0, i, len;
+    for (i = 0; i < cnt; i += 1) {
+        if (ent[i].count <= depth + 8) {
+            sort_swap(&ent[fin], &ent[i]);
+            fin += 1;
+        }
+    }
+    // 长度只有 depth ~ depth + 8 这几种, 短的是长的的前缀
+    for (len = depth; len < depth + 8 && pos + 1 < fin; len += 1) {
+        for (i = pos; i < fin; i += 1) {
+            if (ent[i].count == len) {
+                sort_swap(&ent[pos], &ent[i]);
+                pos += 1;
+            }
+        }
+    }
+    return fin;
+}
+
+/**
+ * @brief 插入排序
+ *
+ */
+static void sort_insertion(SortEntry* ent, usize_t cnt, usize_t depth)
+{
+    SortEntry t;
+    usize_t i, j;
+    for (i = 1; i < cnt; i += 1) {
+        t = ent[i];
+        j = i;
+        while (j > 0 && sort_compare(&t, &ent[j - 1], depth) < 0) {
+            ent[j] = ent[j - 1];
+            j -= 1;
+        }
+        ent[j] = t;
+    }
+}
+
+/**
+ * @brief 比较前面depth个字节相同的两项
+ *
+ */
+static int sort_compare(
+    const SortEntry* a, const SortEntry* b, usize_t depth
+)
+{
+    usize_t n;
+    int ret;
+    if (a->key != b->key) {
+        return a->key < b->key ? -1 : 1;
+    }
+    // key相同并且有一个已经结束时, 它是另一个的前缀
+    if (a->count > depth + 8 && b->count > depth + 8) {
+        n = a->count < b->count ? a->count : b->count;
+        ret = memcmp(
+            a->buff + depth + 8, b->buff + depth + 8, n - depth - 8
+        );
+        if (ret != 0) {
+            return ret;
+        }
+    }
+    if (a->count == b->count) {
+        return 0;
+    }
+    return a->count < b->count ? -1 : 1;
+}
+
+/**
+ * @brief 加载从depth开始的key
+ *
+ */
+static void sort_load_key(SortEntry* ent, usize_t cnt, usize_t depth)
+{
+    usize_t i;
+    for (i = 0; i < cnt; i += 1) {
+        ent[i].key = sort_key(ent[i].buff, ent[i].count, depth);
+    }
+}
+
+/**
+ * @brief 把从depth开始的8个字节按大端序拼接成整数,
+ * 整数的大小关系和字节的字典序一致
+ *
+ */
+static uint64_t sort_key(const char* buff, usize_t count, usize_t depth)
+{
+    const uint8_t* p;
+    uint64_t key = 0;
+    usize_t i;
+    if (count >= depth + 8) {
+        p = (const uint8_t*)buff + depth;
+        for (i = 0; i < 8; i += 1) {
+            key = (key << 8) | p[i];
+        }
+    }
+    else {
+        for (i = 0; i < 8; i += 1) {
+            key <<= 8;
+            if (depth + i < count) {
+                key |= (uint8_t)buff[depth + i];
+            }
+        }
+    }
+    return key;
+}
+
+/**
+ * @brief 三个数的中位数
+ *
+ */
+static uint64_t sort_median3(uint64_t a, uint64_t b, uint64_t c)
+{
+    if (a < b) {
+        return b < c ? b : (a < c ? c : a);
+    }
+    else {
+        return a < c ? a : (b < c ? c : b);
+    }
+}
+
+/**
+ * @brief 按首字节分的桶的编号
+ *
+ */
+static usize_t sort_bucket_of(const SortEntry* ent)
+{
+    return ent->count == 0 ? 0 : (usize_t)(uint8_t)ent->buff[0] + 1;
+}
+
+/**
+ * @brief 交换两项
+ *
+ */
+static void sort_swap(SortEntry* a, SortEntry* b)
+{
+    SortEntry t = *a;
+    *a = *b;
+    *b = t;
+}
@@ -16,6 +16,9 @@
 #include "mm_heap.h"
 #include <stddef.h>
 #include <string.h>
+#if _MSTR_USE_SIMD_SSE2
+#include <emmintrin.h>
+#endif // _MSTR_USE_SIMD_SSE2
 
 /**
  * @brief 进行扩展的阈值
@@ -29,6 +32,38 @@
  */
 #define MSTR_SIZE_LARGE_CAP_SIZE_STEP 512
 
+#if _MSTR_USE_SHARED_BUFFER
+#if MSTR_BUILD_CC == MSTR_BUILD_CC_MSVC
+#include <intrin.h>
+/**
+ * @brief 引用计数的类型
+ *
+ */
+typedef volatile long mstr_refcnt_t;
+#else
+typedef usize_t mstr_refcnt_t;
+#endif // MSTR_BUILD_CC == MSTR_BUILD_CC_MSVC
+
+/**
+ * @brief 共享的内存区的头部, 字符串的内容紧跟在它后面
+ *
+ */
+typedef struct tagMStrBuffHeader
+{
+    /**
+     * @brief 引用计数
+     *
+     */
+    mstr_refcnt_t ref_cnt;
+} MStrBuffHeader;
+
+/**
+ * @brief 取得内存区的头部
+ *
+ */
+#define MSTR_BUFF_HEADER(b) (((MStrBuffHeader*)(iptr_t)(b)) - 1)
+#endif // _MSTR_USE_SHARED_BUFFER
+
 //
 // private:
 //
@@ -36,9 +71,20 @@
 static mstr_bool_t mstr_compare_helper(
     const char*, const char*, usize_t
 );
+static usize_t mstr_mismatch(const char*, const char*, usize_t);
+static int mstr_compare_bytes(
+    const char*, usize_t, const char*, usize_t
+);
 static void
     mstr_reverse_unicode_helper(mstr_char_t*, const mstr_char_t*);
 static void* mstr_string_realloc(void*, mstr_bool_t, usize_t, usize_t);
+static char* mstr_buff_alloc(usize_t);
+static void mstr_buff_release(char*);
+static mstr_bool_t mstr_is_heap(const MString*);
+#if _MSTR_USE_SHARED_BUFFER
+static void mstr_buff_retain(char*);
+static mstr_bool_t mstr_buff_is_shared(const char*);
+#endif // _MSTR_USE_SHARED_BUFFER
 static usize_t mstr_resize_tactic(usize_t, usize_t);
 static mstr_result_t
     mstr_strlen(usize_t*, usize_t*, const mstr_char_t*, const mstr_char_t*);
@@ -71,7 +117,7 @@ mstr_create(MString* str, const char* content)
         }
         else {
             str->cap_size = content_cnt + MSTR_STACK_REGION_SIZE;
-            str->buff = (char*)mstr_heap_alloc(str->cap_size);
+            str->buff = mstr_buff_alloc(str->cap_size);
             if (str->buff == NULL) {
                 // 内存分配失败
                 return MStr_Err_HeapTooSmall;
@@ -109,14 +155,53 @@ mstr_move_from(MString* str, MString* other)
 MSTR_EXPORT_API(mstr_result_t)
 mstr_copy_from(MString* str, const MString* other)
 {
-    mstr_result_t result = MStr_Ok;
+    if (str == other) {
+        return MStr_Ok;
+    }
+#if _MSTR_USE_SHARED_BUFFER
+    if (mstr_is_heap(other)) {
+        char* buff = other->buff;
+        // 先补上'\0', 共享之后 mstr_c_str 就不需要写入了
+        buff[other->count] = 0;
+        mstr_buff_retain(buff);
+        if (str->buff != NULL) {
+            mstr_free(str);
+        }
+        str->buff = buff;
+        str->count = other->count;
+        str->length = other->length;
+        str->cap_size = other->cap_size;
+        return MStr_Ok;
+    }
+#endif // _MSTR_USE_SHARED_BUFFER
     if (str->buff != NULL) {
-        mstr_free(str);
+        // 保留原有的内存区
+        mstr_clear(str);
     }
-    MSTR_AND_THEN(result, mstr_create(str, ""));
-    MSTR_AND_THEN(result, mstr_concat(str, other));
-    return result;
+    else {
+        mstr_init(str);
+    }
+    return mstr_concat(str, other);
 }
+
+MSTR_EXPORT_API(mstr_result_t) mstr_detach(MString* str)
+{
+#if _MSTR_USE_SHARED_BUFFER
+    if (mstr_is_heap(str) && mstr_buff_is_shared(str->buff)) {
+        char* new_buff = mstr_buff_alloc(str->cap_size);
+        if (new_buff == NULL) {
+            return MStr_Err_HeapTooSmall;
+        }
+        memcpy(new_buff, str->buff, str->count);
+        mstr_buff_release(str->buff);
+        str->buff = new_buff;
+    }
+#else
+    (void)str;
+#endif // _MSTR_USE_SHARED_BUFFER
+    return MStr_Ok;
+}
+
 MSTR_EXPORT_API(mstr_result_t)
 mstr_reserve(MString* str, usize_t new_size)
 {
@@ -136,7 +221,7 @@ mstr_reserve(MString* str, usize_t new_size)
         return MStr_Ok;
     }
     else {
-        return MStr_Ok;
+        return mstr_detach(str);
     }
 }
 
@@ -164,6 +249,7 @@ mstr_repeat_append(MString* str, mstr_codepoint_t ch, usize_t cnt)
         buff[0] = (mstr_char_t)(ch & 0x7f);
 #endif // _MSTR_USE_UTF_8
         need_len = code_len * cnt;
+        MSTR_AND_THEN(result, mstr_detach(str));
         if (str->count + need_len + 1 >= str->cap_size) {
             // 保证length < cap_size + 1
             // 且有足够的空间存放下一个字符
@@ -194,7 +280,7 @@ mstr_repeat_append(MString* str, mstr_codepoint_t ch, usize_t cnt)
 MSTR_EXPORT_API(mstr_result_t)
 mstr_concat(MString* str, const MString* other)
 {
-    mstr_result_t result = MStr_Ok;
+    mstr_result_t result = mstr_detach(str);
     if (str->count + other->count >= str->cap_size) {
         // 且有足够的空间存放
         MSTR_AND_THEN(
@@ -259,21 +345,39 @@ mstr_concat_cstr_slice(MString* str, const char* start, const char* end)
 
 MSTR_EXPORT_API(void) mstr_clear(MString* str)
 {
+#if _MSTR_USE_SHARED_BUFFER
+    if (mstr_is_heap(str) && mstr_buff_is_shared(str->buff)) {
+        // 共享的内存区留给其它的字符串
+        mstr_buff_release(str->buff);
+        mstr_init(str);
+        return;
+    }
+#endif // _MSTR_USE_SHARED_BUFFER
     str->count = 0;
     str->length = 0;
 }
 
 MSTR_EXPORT_API(void) mstr_reverse_self(MString* str)
 {
-    mstr_char_t* pe = str->buff + str->count;
+    mstr_char_t* pe;
+    if (MSTR_FAILED(mstr_detach(str))) {
+        return;
+    }
+    pe = str->buff + str->count;
     mstr_reverse_only(str);
     mstr_reverse_unicode_helper(str->buff, pe);
 }
 
 MSTR_EXPORT_API(void) mstr_reverse_only(MString* str)
 {
-    mstr_char_t* p2 = str->buff + str->count - 1;
-    mstr_char_t* p1 = str->buff;
+    mstr_char_t* p2;
+    mstr_char_t* p1;
+    if (MSTR_FAILED(mstr_detach(str))) {
+        // 分配失败时保持原样
+        return;
+    }
+    p2 = str->buff + str->count - 1;
+    p1 = str->buff;
     while (p1 < p2) {
         char v = *p2;
         *p2 = *p1;
@@ -286,6 +390,12 @@ MSTR_EXPORT_API(void) mstr_reverse_only(MString* str)
 
 MSTR_EXPORT_API(const char*) mstr_c_str(MString* str)
 {
+#if _MSTR_USE_SHARED_BUFFER
+    if (mstr_is_heap(str) && mstr_buff_is_shared(str->buff)) {
+        // 共享的时候已经补上了'\0'
+        return str->buff;
+    }
+#endif // _MSTR_USE_SHARED_BUFFER
     // 在length的地方补上0
     // 因为cap_size至少比length大1, 因此不需要担心内存问题
     str->buff[str->count] = 0;
@@ -309,6 +419,34 @@ mstr_equal_cstr(const MString* a, const mstr_char_t* b, usize_t b_cnt)
     }
 }
 
+MSTR_EXPORT_API(int) mstr_compare(const MString* a, const MString* b)
+{
+    return mstr_compare_bytes(a->buff, a->count, b->buff, b->count);
+}
+
+MSTR_EXPORT_API(int)
+mstr_compare_view(const MStringView* a, const MStringView* b)
+{
+    return mstr_compare_bytes(a->buff, a->count, b->buff, b->count);
+}
+
+MSTR_EXPORT_API(mstr_bool_t)
+mstr_equal_constant_time(
+    const MString* a, const mstr_char_t* b, usize_t b_cnt
+)
+{
+    // volatile避免编译器在中途发现不同就提前返回
+    volatile uint32_t bit = 0;
+    usize_t i;
+    if (a->count != b_cnt) {
+        return False;
+    }
+    for (i = 0; i < b_cnt; i += 1) {
+        bit |= (uint32_t)(uint8_t)(a->buff[i] ^ b[i]);
+    }
+    return bit == 0;
+}
+
 MSTR_EXPORT_API(mstr_bool_t)
 mstr_start_with(
     const MString* str, const char* prefix, usize_t prefix_cnt
@@ -381,9 +519,12 @@ mstr_char_at(const MString* str, usize_t idx)
 MSTR_EXPORT_API(mstr_result_t)
 mstr_remove(MString* str, mstr_codepoint_t* removed_ch, usize_t idx)
 {
-    mstr_result_t res = MStr_Ok;
+    mstr_result_t res = mstr_detach(str);
     // 找到需要移除的位置
     usize_t offset = mstr_char_offset_at(str, idx);
+    if (MSTR_FAILED(res)) {
+        return res;
+    }
     // 记录返回的字符
     if (removed_ch != NULL) {
 #if _MSTR_USE_UTF_8
@@ -435,7 +576,8 @@ mstr_insert(MString* str, usize_t idx, mstr_codepoint_t ch)
         insert_data[0] = (char)ch;
         insert_data_len = 1;
 #endif // _MSTR_USE_UTF_8
-       // 保证空间足够
+        MSTR_AND_THEN(res, mstr_detach(str));
+        // 保证空间足够
         if (str->count + insert_data_len + 1 >= str->cap_size) {
             // 保证length < cap_size + 1
             // 且有足够的空间存放下一个字符
@@ -673,8 +815,8 @@ mstr_char_offset_at(const MString* str, usize_t idx)
 
 MSTR_EXPORT_API(void) mstr_free(MString* str)
 {
-    if (str->buff != NULL && str->buff != str->stack_region) {
-        mstr_heap_free(str->buff);
+    if (mstr_is_heap(str)) {
+        mstr_buff_release(str->buff);
     }
     // else: stack上分配的, 不用管它
     str->buff = NULL;
@@ -706,7 +848,7 @@ static mstr_result_t mstr_strlen(
         return 0;
     }
 #if _MSTR_USE_UTF_8
-    while (*str && str < str_end) {
+    while (str < str_end && *str) {
         usize_t cnt = mstr_char_length(*str);
         count_val += cnt;
         len_val += 1;
@@ -723,7 +865,7 @@ static mstr_result_t mstr_strlen(
         return MStr_Ok;
     }
 #else
-    while (*str && str < str_end) {
+    while (str < str_end && *str) {
         count_val += 1;
         len_val += 1;
         str += 1;
@@ -819,14 +961,79 @@ static mstr_bool_t mstr_compare_helper(
     const char* a, const char* b, usize_t len
 )
 {
-    uint32_t bit = 0;
-    for (usize_t i = 0; i < len; i += 1) {
-        uint32_t ch_a = a[i];
-        uint32_t ch_b = b[i];
-        // equ
-        bit |= ch_a ^ ch_b;
+    return mstr_mismatch(a, b, len) == len;
+}
+
+/**
+ * @brief 找到第一个不同的字节
+ *
+ * @param[in] a: 内容a
+ * @param[in] b: 内容b
+ * @param[in] len: 需要比较的字节数
+ *
+ * @return usize_t: 第一个不同的字节的位置, 全部相同时返回len
+ *
+ * @note 有SSE2时每次比较16个字节, 之后每次比较一个usize_t,
+ * 遇到不同的内容就返回
+ */
+static usize_t mstr_mismatch(const char* a, const char* b, usize_t len)
+{
+    usize_t i = 0;
+#if _MSTR_USE_SIMD_SSE2
+    while (i + 16 <= len) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(a + i));
+        __m128i y = _mm_loadu_si128((const __m128i*)(b + i));
+        uint32_t mask =
+            (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(x, y)) ^ 0xffff;
+        if (mask != 0) {
+#if MSTR_BUILD_CC == MSTR_BUILD_CC_GNUC
+            return i + (usize_t)__builtin_ctz(mask);
+#else
+            while ((mask & 1) == 0) {
+                mask >>= 1;
+                i += 1;
+            }
+            return i;
+#endif // MSTR_BUILD_CC
+        }
+        i += 16;
+    }
+#endif // _MSTR_USE_SIMD_SSE2
+    while (i + sizeof(usize_t) <= len) {
+        usize_t x, y;
+        memcpy(&x, a + i, sizeof(usize_t));
+        memcpy(&y, b + i, sizeof(usize_t));
+        if (x != y) {
+            // 不同的字节在这个字里面
+            break;
+        }
+        i += sizeof(usize_t);
+    }
+    while (i < len && a[i] == b[i]) {
+        i += 1;
+    }
+    return i;
+}
+
+/**
+ * @brief 按照字节的字典序比较
+ *
+ */
+static int mstr_compare_bytes(
+    const char* a, usize_t a_cnt, const char* b, usize_t b_cnt
+)
+{
+    usize_t len = a_cnt < b_cnt ? a_cnt : b_cnt;
+    usize_t pos = mstr_mismatch(a, b, len);
+    if (pos < len) {
+        return (int)(uint8_t)a[pos] - (int)(uint8_t)b[pos];
+    }
+    else if (a_cnt == b_cnt) {
+        return 0;
+    }
+    else {
+        return a_cnt < b_cnt ? -1 : 1;
     }
-    return bit == 0;
 }
 
 /**
@@ -845,6 +1052,31 @@ static void* mstr_string_realloc(
     usize_t new_size
 )
 {
+#if _MSTR_USE_SHARED_BUFFER
+    mstr_bool_t is_owner = !is_stack && old_ptr != NULL;
+    if (is_owner && !mstr_buff_is_shared((const char*)old_ptr)) {
+        MStrBuffHeader* new_hdr = (MStrBuffHeader*)mstr_heap_realloc(
+            MSTR_BUFF_HEADER(old_ptr),
+            new_size + sizeof(MStrBuffHeader),
+            old_size + sizeof(MStrBuffHeader)
+        );
+        return new_hdr == NULL ? NULL : (void*)(new_hdr + 1);
+    }
+    else {
+        // 共享的内存区和stack上的一样, 复制到新的内存区
+        char* new_ptr = mstr_buff_alloc(new_size);
+        if (new_ptr == NULL) {
+            return NULL;
+        }
+        if (old_ptr != NULL) {
+            memcpy(new_ptr, old_ptr, old_size);
+        }
+        if (is_owner) {
+            mstr_buff_release((char*)old_ptr);
+        }
+        return new_ptr;
+    }
+#else
     if (is_stack) {
         void* new_ptr = mstr_heap_alloc(new_size);
         if (new_ptr == NULL) {
@@ -856,7 +1088,102 @@ static void* mstr_string_realloc(
     else {
         return mstr_heap_realloc(old_ptr, new_size, old_size);
     }
+#endif // _MSTR_USE_SHARED_BUFFER
+}
+
+/**
+ * @brief 分配字符串的内存区
+ *
+ * @param[in] size: 内存区的大小
+ * @return char*: 内存区, 失败返回NULL
+ *
+ * @note 共享模式下引用计数从1开始
+ */
+static char* mstr_buff_alloc(usize_t size)
+{
+#if _MSTR_USE_SHARED_BUFFER
+    MStrBuffHeader* hdr = (MStrBuffHeader*)mstr_heap_alloc(
+        size + sizeof(MStrBuffHeader)
+    );
+    if (hdr == NULL) {
+        return NULL;
+    }
+    hdr->ref_cnt = 1;
+    return (char*)(hdr + 1);
+#else
+    return (char*)mstr_heap_alloc(size);
+#endif // _MSTR_USE_SHARED_BUFFER
+}
+
+/**
+ * @brief 释放字符串的内存区, 共享模式下引用计数为0时才释放
+ *
+ */
+static void mstr_buff_release(char* buff)
+{
+#if _MSTR_USE_SHARED_BUFFER
+    MStrBuffHeader* hdr = MSTR_BUFF_HEADER(buff);
+#if MSTR_BUILD_CC == MSTR_BUILD_CC_GNUC
+    if (__atomic_sub_fetch(&hdr->ref_cnt, 1, __ATOMIC_ACQ_REL) == 0) {
+        mstr_heap_free(hdr);
+    }
+#elif MSTR_BUILD_CC == MSTR_BUILD_CC_MSVC
+    if (_InterlockedDecrement(&hdr->ref_cnt) == 0) {
+        mstr_heap_free(hdr);
+    }
+#else
+    hdr->ref_cnt -= 1;
+    if (hdr->ref_cnt == 0) {
+        mstr_heap_free(hdr);
+    }
+#endif // MSTR_BUILD_CC
+#else
+    mstr_heap_free(buff);
+#endif // _MSTR_USE_SHARED_BUFFER
+}
+
+/**
+ * @brief 判断字符串的内容是否在堆上
+ *
+ * @note cap_size为0的是借用外部内存的字面量
+ */
+static mstr_bool_t mstr_is_heap(const MString* str)
+{
+    return str->buff != NULL && str->buff != str->stack_region &&
+           str->cap_size != 0;
+}
+
+#if _MSTR_USE_SHARED_BUFFER
+/**
+ * @brief 增加内存区的引用计数
+ *
+ */
+static void mstr_buff_retain(char* buff)
+{
+    MStrBuffHeader* hdr = MSTR_BUFF_HEADER(buff);
+#if MSTR_BUILD_CC == MSTR_BUILD_CC_GNUC
+    __atomic_add_fetch(&hdr->ref_cnt, 1, __ATOMIC_RELAXED);
+#elif MSTR_BUILD_CC == MSTR_BUILD_CC_MSVC
+    _InterlockedIncrement(&hdr->ref_cnt);
+#else
+    hdr->ref_cnt += 1;
+#endif // MSTR_BUILD_CC
+}
+
+/**
+ * @brief 判断内存区是否被多个字符串共享
+ *
+ */
+static mstr_bool_t mstr_buff_is_shared(const char* buff)
+{
+    const MStrBuffHeader* hdr = MSTR_BUFF_HEADER(buff);
+#if MSTR_BUILD_CC == MSTR_BUILD_CC_GNUC
+    return __atomic_load_n(&hdr->ref_cnt, __ATOMIC_ACQUIRE) != 1;
+#else
+    return hdr->ref_cnt != 1;
+#endif // MSTR_BUILD_CC
 }
+#endif // _MSTR_USE_SHARED_BUFFER
 
 /**
  * @brief 改变cap的策略
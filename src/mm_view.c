@@ -0,0 +1,563 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    mm_view.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   字符串视图
+ * @version 1.0
+ * @date    2023-08-26
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+
+#define MSTR_IMP_SOURCES 1
+
+#include "mm_string.h"
+#include <stddef.h>
+#include <string.h>
+#if _MSTR_USE_SIMD_SSE2
+#include <emmintrin.h>
+#endif // _MSTR_USE_SIMD_SSE2
+
+/**
+ * @brief 一次比较多个字节时最多的分隔字符数
+ *
+ */
+#define SPLIT_SMALL_SET_MAX 4
+
+//
+// private:
+//
+
+static usize_t view_char_count(const char*, usize_t);
+static mstr_result_t
+    view_char_offset(usize_t*, const MStringView*, usize_t);
+static mstr_bool_t view_is_boundary(const MStringView*, usize_t);
+static const char*
+    view_search(const char*, usize_t, const char*, usize_t);
+static const char*
+    split_find_set(const MStringSplit*, const char*, const char*);
+static const char*
+    split_find_small(const MStringSplit*, const char*, const char*);
+static mstr_bool_t split_in_set(const MStringSplit*, char);
+
+//
+// public:
+//
+
+MSTR_EXPORT_API(void)
+mstr_view_of(MStringView* view, const MString* str)
+{
+    view->buff = str->buff;
+    view->count = str->count;
+    view->length = str->length;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_view_from_cstr(
+    MStringView* view, const char* beg, const char* end
+)
+{
+    usize_t count;
+    if (beg == NULL) {
+        view->buff = "";
+        view->count = 0;
+        view->length = 0;
+        return MStr_Ok;
+    }
+    count = end == NULL ? (usize_t)strlen(beg) : (usize_t)(end - beg);
+#if _MSTR_USE_UTF_8
+    if (count > 0) {
+        // 检查最后一个字符是否完整
+        usize_t last = count - 1;
+        while (last > 0 && (beg[last] & 0xc0) == 0x80) {
+            last -= 1;
+        }
+        if (last + mstr_char_length(beg[last]) > count) {
+            return MStr_Err_EncodingNotCompleted;
+        }
+    }
+#endif // _MSTR_USE_UTF_8
+    view->buff = beg;
+    view->count = count;
+    view->length = view_char_count(beg, count);
+    return MStr_Ok;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_view_slice(
+    MStringView* out, const MStringView* view, usize_t beg, usize_t end
+)
+{
+    usize_t beg_off = 0, end_off = 0;
+    mstr_result_t res;
+    if (beg > end || end > view->length) {
+        return MStr_Err_IndexOutOfBound;
+    }
+    res = view_char_offset(&beg_off, view, beg);
+    MSTR_AND_THEN(res, view_char_offset(&end_off, view, end));
+    if (MSTR_SUCC(res)) {
+        out->buff = view->buff + beg_off;
+        out->count = end_off - beg_off;
+        out->length = end - beg;
+    }
+    return res;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_view_slice_bytes(
+    MStringView* out, const MStringView* view, usize_t beg, usize_t end
+)
+{
+    if (beg > end || end > view->count) {
+        return MStr_Err_IndexOutOfBound;
+    }
+    if (!view_is_boundary(view, beg) || !view_is_boundary(view, end)) {
+        return MStr_Err_UnicodeEncodingError;
+    }
+    out->buff = view->buff + beg;
+    out->count = end - beg;
+    out->length = view->count == view->length
+                      ? end - beg
+                      : view_char_count(view->buff + beg, end - beg);
+    return MStr_Ok;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_view_find(
+    const MStringView* view,
+    MStringMatchResult* f_res,
+    usize_t begin_pos,
+    const MStringView* pattern
+)
+{
+    usize_t offset = 0;
+    const char* pos;
+    mstr_result_t res;
+    if (begin_pos > view->length) {
+        return MStr_Err_IndexOutOfBound;
+    }
+    res = view_char_offset(&offset, view, begin_pos);
+    if (MSTR_FAILED(res)) {
+        return res;
+    }
+    pos = view_search(
+        view->buff + offset,
+        view->count - offset,
+        pattern->buff,
+        pattern->count
+    );
+    if (pos == NULL) {
+        f_res->is_matched = False;
+        f_res->begin_pos = 0;
+        f_res->begin_offset = 0;
+    }
+    else {
+        usize_t skip = (usize_t)(pos - (view->buff + offset));
+        f_res->is_matched = True;
+        f_res->begin_offset = offset + skip;
+        f_res->begin_pos =
+            begin_pos + view_char_count(view->buff + offset, skip);
+    }
+    return MStr_Ok;
+}
+
+MSTR_EXPORT_API(mstr_bool_t)
+mstr_view_split(
+    MStringView* head,
+    MStringView* rest,
+    const MStringView* view,
+    const MStringView* sep
+)
+{
+    MStringView src = *view;
+    const char* pos = NULL;
+    if (sep->count > 0) {
+        pos = view_search(src.buff, src.count, sep->buff, sep->count);
+    }
+    if (pos == NULL) {
+        *head = src;
+        rest->buff = src.buff + src.count;
+        rest->count = 0;
+        rest->length = 0;
+        return False;
+    }
+    else {
+        usize_t head_cnt = (usize_t)(pos - src.buff);
+        usize_t rest_off = head_cnt + sep->count;
+        head->buff = src.buff;
+        head->count = head_cnt;
+        head->length = view_char_count(src.buff, head_cnt);
+        rest->buff = src.buff + rest_off;
+        rest->count = src.count - rest_off;
+        rest->length = src.length - head->length - sep->length;
+        return True;
+    }
+}
+
+MSTR_EXPORT_API(mstr_bool_t)
+mstr_view_equal(const MStringView* a, const MStringView* b)
+{
+    if (a->count != b->count) {
+        return False;
+    }
+    else if (a->count == 0) {
+        return True;
+    }
+    else {
+        return memcmp(a->buff, b->buff, a->count) == 0;
+    }
+}
+
+MSTR_EXPORT_API(mstr_bool_t)
+mstr_view_start_with(
+    const MStringView* view, const MStringView* prefix
+)
+{
+    if (prefix->count > view->count) {
+        return False;
+    }
+    else if (prefix->count == 0) {
+        return True;
+    }
+    else {
+        return memcmp(view->buff, prefix->buff, prefix->count) == 0;
+    }
+}
+
+MSTR_EXPORT_API(mstr_bool_t)
+mstr_view_end_with(const MStringView* view, const MStringView* suffix)
+{
+    if (suffix->count > view->count) {
+        return False;
+    }
+    else if (suffix->count == 0) {
+        return True;
+    }
+    else {
+        const char* tail = view->buff + (view->count - suffix->count);
+        return memcmp(tail, suffix->buff, suffix->count) == 0;
+    }
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_split_by_chars(
+    MStringSplit* sp,
+    const MStringView* view,
+    const char* delims,
+    usize_t delim_cnt
+)
+{
+    usize_t i;
+    memset(sp->delim_set, 0, sizeof(sp->delim_set));
+    for (i = 0; i < delim_cnt; i += 1) {
+        uint8_t ch = (uint8_t)delims[i];
+#if _MSTR_USE_UTF_8
+        if (ch >= 0x80) {
+            // 多字节字符需要使用 mstr_split_by_str
+            return MStr_Err_UnicodeEncodingError;
+        }
+#endif // _MSTR_USE_UTF_8
+        sp->delim_set[ch >> 3] |= (uint8_t)(1u << (ch & 7));
+    }
+    memset(sp->delim, 0, sizeof(sp->delim));
+    for (i = 0; i < SPLIT_SMALL_SET_MAX && delim_cnt > 0; i += 1) {
+        // 补齐之后比较的时候不需要区分个数
+        sp->delim[i] = i < delim_cnt ? delims[i] : delims[0];
+    }
+    sp->it = view->buff;
+    sp->it_end = view->buff + view->count;
+    sp->rem_length = view->length;
+    sp->sep.buff = "";
+    sp->sep.count = 0;
+    sp->sep.length = 0;
+    sp->delim_cnt = delim_cnt;
+    return MStr_Ok;
+}
+
+MSTR_EXPORT_API(void)
+mstr_split_by_str(
+    MStringSplit* sp, const MStringView* view, const MStringView* sep
+)
+{
+    memset(sp->delim_set, 0, sizeof(sp->delim_set));
+    memset(sp->delim, 0, sizeof(sp->delim));
+    sp->it = view->buff;
+    sp->it_end = view->buff + view->count;
+    sp->rem_length = view->length;
+    sp->sep = *sep;
+    sp->delim_cnt = 0;
+}
+
+MSTR_EXPORT_API(mstr_bool_t)
+mstr_split_next(MStringSplit* sp, MStringView* field)
+{
+    const char* pos;
+    usize_t skip_cnt, skip_len;
+    if (sp->it == NULL) {
+        return False;
+    }
+    if (sp->sep.count > 0) {
+        pos = view_search(
+            sp->it,
+            (usize_t)(sp->it_end - sp->it),
+            sp->sep.buff,
+            sp->sep.count
+        );
+        skip_cnt = sp->sep.count;
+        skip_len = sp->sep.length;
+    }
+    else if (sp->delim_cnt > 0) {
+        pos = split_find_set(sp, sp->it, sp->it_end);
+        pos = pos == sp->it_end ? NULL : pos;
+        skip_cnt = 1;
+        skip_len = 1;
+    }
+    else {
+        pos = NULL;
+        skip_cnt = 0;
+        skip_len = 0;
+    }
+    field->buff = sp->it;
+    if (pos == NULL) {
+        // 最后一个字段
+        field->count = (usize_t)(sp->it_end - sp->it);
+        field->length = sp->rem_length;
+        sp->it = NULL;
+        sp->rem_length = 0;
+    }
+    else {
+        field->count = (usize_t)(pos - sp->it);
+        field->length = view_char_count(field->buff, field->count);
+        sp->it = pos + skip_cnt;
+        sp->rem_length -= field->length + skip_len;
+    }
+    return True;
+}
+
+MSTR_EXPORT_API(mstr_result_t)
+mstr_concat_view(MString* str, const MStringView* view)
+{
+    MString lit;
+    if (view->count == 0) {
+        return MStr_Ok;
+    }
+    // const MString不会被修改, 所以可强转一下
+    lit.buff = (char*)(iptr_t)view->buff;
+    lit.count = view->count;
+    lit.length = view->length;
+    lit.cap_size = 0;
+    return mstr_concat(str, &lit);
+}
+
+/**
+ * @brief 计算字符数
+ *
+ * @param[in] buff: 字符串
+ * @param[in] count: 字节数
+ *
+ * @note 字符数就是不是10xxxxxx的字节数, 每次处理8个字节
+ */
+static usize_t view_char_count(const char* buff, usize_t count)
+{
+#if _MSTR_USE_UTF_8
+    const uint64_t hi = 0x8080808080808080ull;
+    usize_t cont = 0;
+    usize_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        uint64_t x;
+        memcpy(&x, buff + i, sizeof(x));
+        // 最高两位是10的字节
+        x = x & ~(x << 1) & hi;
+        cont += (usize_t)(((x >> 7) * 0x0101010101010101ull) >> 56);
+    }
+    for (; i < count; i += 1) {
+        cont += ((uint8_t)buff[i] & 0xc0) == 0x80 ? 1 : 0;
+    }
+    return count - cont;
+#else
+    (void)buff;
+    return count;
+#endif // _MSTR_USE_UTF_8
+}
+
+/**
+ * @brief 计算字符索引对应的字节偏移
+ *
+ * @param[out] offset: 字节偏移
+ * @param[in] view: 视图
+ * @param[in] idx: 字符索引, 不超过view->length
+ */
+static mstr_result_t view_char_offset(
+    usize_t* offset, const MStringView* view, usize_t idx
+)
+{
+    usize_t off = 0;
+    if (view->count == view->length) {
+        // 全部是单字节字符
+        *offset = idx;
+        return MStr_Ok;
+    }
+    while (idx > 0) {
+        off += mstr_char_length(view->buff[off]);
+        idx -= 1;
+    }
+    if (off > view->count) {
+        return MStr_Err_UnicodeEncodingError;
+    }
+    *offset = off;
+    return MStr_Ok;
+}
+
+/**
+ * @brief 判断字节偏移是否在字符的边界上
+ *
+ */
+static mstr_bool_t view_is_boundary(
+    const MStringView* view, usize_t offset
+)
+{
+#if _MSTR_USE_UTF_8
+    if (offset == view->count) {
+        return True;
+    }
+    else {
+        return ((uint8_t)view->buff[offset] & 0xc0) != 0x80;
+    }
+#else
+    (void)view;
+    (void)offset;
+    return True;
+#endif // _MSTR_USE_UTF_8
+}
+
+/**
+ * @brief 查找子串
+ *
+ * @return const char*: 子串的位置, 找不到时返回NULL
+ *
+ * @note 先用memchr找第一个字节, 再比较剩下的部分.
+ * UTF-8的前导字节不会出现在字符的中间, 所以找到的位置一定是字符边界
+ */
+static const char* view_search(
+    const char* str, usize_t str_cnt, const char* patt, usize_t patt_cnt
+)
+{
+    const char* it = str;
+    const char* last;
+    if (patt_cnt == 0) {
+        return str;
+    }
+    else if (patt_cnt > str_cnt) {
+        return NULL;
+    }
+    last = str + (str_cnt - patt_cnt);
+    while (it <= last) {
+        const char* pos = (const char*)memchr(
+            it, (uint8_t)patt[0], (usize_t)(last - it) + 1
+        );
+        if (pos == NULL) {
+            return NULL;
+        }
+        else if (memcmp(pos + 1, patt + 1, patt_cnt - 1) == 0) {
+            return pos;
+        }
+        it = pos + 1;
+    }
+    return NULL;
+}
+
+/**
+ * @brief 判断字符是否是分隔字符
+ *
+ */
+static mstr_bool_t split_in_set(const MStringSplit* sp, char ch)
+{
+    uint8_t uch = (uint8_t)ch;
+    return (sp->delim_set[uch >> 3] >> (uch & 7)) & 1;
+}
+
+/**
+ * @brief 查找第一个分隔字符
+ *
+ * @return const char*: 分隔字符的位置, 找不到时返回end
+ */
+static const char* split_find_set(
+    const MStringSplit* sp, const char* p, const char* end
+)
+{
+    if (sp->delim_cnt == 1) {
+        const char* pos = (const char*)memchr(
+            p, (uint8_t)sp->delim[0], (usize_t)(end - p)
+        );
+        return pos == NULL ? end : pos;
+    }
+    else if (sp->delim_cnt <= SPLIT_SMALL_SET_MAX) {
+        p = split_find_small(sp, p, end);
+    }
+    while (p < end && !split_in_set(sp, *p)) {
+        p += 1;
+    }
+    return p;
+}
+
+/**
+ * @brief 跳过不包括分隔字符的部分
+ *
+ * @return const char*: 之后可能是分隔字符的位置,
+ * 剩下不足一组的字节由调用方逐个检查
+ *
+ * @note 有SSE2时每次检查16个字节, 否则每次检查8个字节
+ */
+static const char* split_find_small(
+    const MStringSplit* sp, const char* p, const char* end
+)
+{
+#if _MSTR_USE_SIMD_SSE2
+    const __m128i d0 = _mm_set1_epi8(sp->delim[0]);
+    const __m128i d1 = _mm_set1_epi8(sp->delim[1]);
+    const __m128i d2 = _mm_set1_epi8(sp->delim[2]);
+    const __m128i d3 = _mm_set1_epi8(sp->delim[3]);
+    while (end - p >= 16) {
+        __m128i x = _mm_loadu_si128((const __m128i*)p);
+        __m128i m = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(x, d0), _mm_cmpeq_epi8(x, d1)),
+            _mm_or_si128(_mm_cmpeq_epi8(x, d2), _mm_cmpeq_epi8(x, d3))
+        );
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(m);
+        if (mask != 0) {
+#if MSTR_BUILD_CC == MSTR_BUILD_CC_GNUC
+            return p + __builtin_ctz(mask);
+#else
+            while ((mask & 1) == 0) {
+                mask >>= 1;
+                p += 1;
+            }
+            return p;
+#endif // MSTR_BUILD_CC
+        }
+        p += 16;
+    }
+#else
+    const uint64_t lo = 0x0101010101010101ull;
+    const uint64_t hi = 0x8080808080808080ull;
+    const uint64_t d0 = lo * (uint8_t)sp->delim[0];
+    const uint64_t d1 = lo * (uint8_t)sp->delim[1];
+    const uint64_t d2 = lo * (uint8_t)sp->delim[2];
+    const uint64_t d3 = lo * (uint8_t)sp->delim[3];
+    while (end - p >= 8) {
+        uint64_t x, m;
+        memcpy(&x, p, sizeof(x));
+        // 等于分隔字符的字节在异或之后为0
+        m = ((x ^ d0) - lo) & ~(x ^ d0);
+        m |= ((x ^ d1) - lo) & ~(x ^ d1);
+        m |= ((x ^ d2) - lo) & ~(x ^ d2);
+        m |= ((x ^ d3) - lo) & ~(x ^ d3);
+        if ((m & hi) != 0) {
+            break;
+        }
+        p += 8;
+    }
+#endif // _MSTR_USE_SIMD_SSE2
+    return p;
+}
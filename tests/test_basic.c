@@ -15,6 +15,7 @@
 #include "unity.h"
 #include <stddef.h>
 #include <stdio.h>
+#include <string.h>
 
 void allocate_then_free()
 {
@@ -22,3 +23,31 @@ void allocate_then_free()
     TEST_ASSERT_TRUE(p != NULL);
     mstr_heap_free(p);
 }
+
+void allocate_small_remainder(void)
+{
+#if !_MSTR_USE_MALLOC
+    usize_t free_size = mstr_heap_get_free_size();
+    byte_t *a, *b, *c, *d;
+    const byte_t* a_pos;
+    a = (byte_t*)mstr_heap_alloc(128);
+    b = (byte_t*)mstr_heap_alloc(64);
+    TEST_ASSERT_TRUE(a != NULL && b != NULL);
+    a_pos = a;
+    mstr_heap_free(a);
+    // 剩下的8个字节放不下空闲块的头部, 整个块都分配出去,
+    // 而不是在b的前面写一个空闲块
+    c = (byte_t*)mstr_heap_alloc(128 - 8);
+    TEST_ASSERT_TRUE(c == a_pos);
+    memset(c, 0xcc, 128 - 8);
+    memset(b, 0x55, 64);
+    mstr_heap_free(b);
+    mstr_heap_free(c);
+    ASSERT_EQUAL_VALUE(mstr_heap_get_free_size(), free_size);
+    // 释放之后重新合并成一个块
+    d = (byte_t*)mstr_heap_alloc(256);
+    TEST_ASSERT_TRUE(d == a_pos);
+    mstr_heap_free(d);
+    ASSERT_EQUAL_VALUE(mstr_heap_get_free_size(), free_size);
+#endif // _MSTR_USE_MALLOC
+}
@@ -46,3 +46,63 @@ void fmt_seq_arg_id_err(void)
     // free
     mstr_free(&s);
 }
+
+void fmt_argv_random_access(void)
+{
+    MString s;
+    const uint8_t arr[] = {1, 2, 3};
+    MStrFmtFormatArgument args[20];
+    usize_t i;
+    for (i = 0; i < 18; i += 1) {
+        args[i].value = (iptr_t)i;
+        args[i].type = MStrFmtArgType_Int32;
+    }
+    args[18].value = (iptr_t)arr;
+    args[18].type = MStrFmtArgType_Array_Uint8;
+    args[19].value = (iptr_t)3;
+    args[19].type = MStrFmtArgType_Uint32;
+    EVAL(mstr_create_empty(&s));
+    // 乱序、重复
+    EVAL(mstr_format_argv(&s, "@{2:i32}-{0:i32}-{2:i32}@", args, 3));
+    ASSERT_EQUAL_STRING(&s, "@2-0-2@");
+    mstr_clear(&s);
+    // 超过16个参数
+    EVAL(mstr_format_argv(
+        &s, "{17:i32}{16:i32}{[18:u8]}{1:i32}", args, 20
+    ));
+    ASSERT_EQUAL_STRING(&s, "17161, 2, 31");
+    mstr_free(&s);
+}
+
+void fmt_argv_err(void)
+{
+    static const uint8_t arr[2] = {1, 2};
+    MString s;
+    mstr_result_t result = MStr_Ok;
+    MStrFmtFormatArgument args[3];
+    args[0].value = (iptr_t)123;
+    args[0].type = MStrFmtArgType_Int32;
+    args[1].value = (iptr_t)arr;
+    args[1].type = MStrFmtArgType_Array_Uint8;
+    args[2].value = (iptr_t)2;
+    args[2].type = MStrFmtArgType_Int32;
+    EVAL(mstr_create_empty(&s));
+    // ERR: 参数太少
+    result = mstr_format_argv(&s, "@{2:i32}@", args, 2);
+    TEST_ASSERT_TRUE(result == MStr_Err_InvaildArgumentID);
+    mstr_clear(&s);
+    // ERR: 参数类型不对
+    result = mstr_format_argv(&s, "@{1:i32}@", args, 2);
+    TEST_ASSERT_TRUE(result == MStr_Err_InvaildArgumentType);
+    mstr_clear(&s);
+    // ERR: 缺少数组长度
+    result = mstr_format_argv(&s, "@{[1:u8]}@", args, 2);
+    TEST_ASSERT_TRUE(result == MStr_Err_InvaildArgumentID);
+    mstr_clear(&s);
+    // ERR: 数组长度的类型不对 (应为Uint32)
+    result = mstr_format_argv(&s, "@{[1:u8]}@", args, 3);
+    TEST_ASSERT_TRUE(result == MStr_Err_InvaildArgumentType);
+    mstr_clear(&s);
+    // free
+    mstr_free(&s);
+}
@@ -47,3 +47,68 @@ void fmt_array_element_style(void)
     ASSERT_EQUAL_STRING(&s, "@0x1#0x1#0x4#0x5#0x1#0x4@");
     mstr_free(&s);
 }
+
+// 字节数组, 足够触发一次完整的16字节转换
+#define BYTES_SIZE ((size_t)20)
+
+static const uint8_t bytes[BYTES_SIZE] = {
+    'H', 'e', 'l', 'l', 'o', ',', ' ', 'w', 'o',  'r',
+    'l', 'd', '!', '\n', 0,  1,   2,   127, 128, 255,
+};
+
+void fmt_array_hex_bytes(void)
+{
+    MString s;
+    EVAL(mstr_create_empty(&s));
+    EVAL(mstr_format(&s, "@{[0:u8|::y]}@", 2, bytes, BYTES_SIZE));
+    ASSERT_EQUAL_STRING(
+        &s, "@48656c6c6f2c20776f726c64210a0001027f80ff@"
+    );
+    mstr_clear(&s);
+    EVAL(mstr_format(&s, "{[0:u8|:-:Y]}", 2, bytes, (size_t)6));
+    ASSERT_EQUAL_STRING(&s, "48-65-6C-6C-6F-2C");
+    mstr_clear(&s);
+    TEST_ASSERT_TRUE(
+        mstr_format(&s, "{[0:u16:y]}", 2, bytes, (size_t)1) ==
+        MStr_Err_UnsupportFormatType
+    );
+    mstr_free(&s);
+}
+
+void fmt_array_hexdump(void)
+{
+    MString s;
+    EVAL(mstr_create_empty(&s));
+    EVAL(mstr_format(&s, "{[0:u8:D]}", 2, bytes, BYTES_SIZE));
+    ASSERT_EQUAL_STRING(
+        &s,
+        "00000000  48 65 6c 6c 6f 2c 20 77  "
+        "6f 72 6c 64 21 0a 00 01  |Hello, world!...|\n"
+        "00000010  02 7f 80 ff                 "
+        "                      |....|"
+    );
+    mstr_free(&s);
+}
+
+void fmt_array_base_encoding(void)
+{
+    MString s;
+    EVAL(mstr_create_empty(&s));
+    EVAL(mstr_format(&s, "{[0:u8:b64]}", 2, bytes, BYTES_SIZE));
+    ASSERT_EQUAL_STRING(&s, "SGVsbG8sIHdvcmxkIQoAAQJ/gP8=");
+    mstr_clear(&s);
+    EVAL(mstr_format(&s, "{[0:u8:b64]}", 2, bytes, (size_t)5));
+    ASSERT_EQUAL_STRING(&s, "SGVsbG8=");
+    mstr_clear(&s);
+    EVAL(mstr_format(&s, "{[0:u8:b32]}", 2, bytes, BYTES_SIZE));
+    ASSERT_EQUAL_STRING(&s, "JBSWY3DPFQQHO33SNRSCCCQAAEBH7AH7");
+    mstr_clear(&s);
+    EVAL(mstr_format(&s, "{[0:u8:b32]}", 2, bytes, (size_t)3));
+    ASSERT_EQUAL_STRING(&s, "JBSWY===");
+    mstr_clear(&s);
+    TEST_ASSERT_TRUE(
+        mstr_format(&s, "{[0:u8:b16]}", 2, bytes, (size_t)1) ==
+        MStr_Err_UnsupportFormatType
+    );
+    mstr_free(&s);
+}
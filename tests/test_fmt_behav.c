@@ -52,3 +52,31 @@ void fmt_behav_signed_hex(void)
     ASSERT_EQUAL_STRING(&s, "@a@-a@");
     mstr_free(&s);
 }
+
+void fmt_behav_cache(void)
+{
+    static const char fmt[] = "@{0:i32:>4}{{{1:t:%H:%m}}}{[2:u8|:-]}@";
+    static const uint8_t array[3] = {1, 2, 3};
+    static const MStrTime tm = {.hour = 0x16, .minute = 0x55};
+    int i;
+#if _MSTR_USE_FMT_CACHE
+    MStrFmtCacheStatistics stat;
+    mstr_fmt_cache_clear();
+#endif // _MSTR_USE_FMT_CACHE
+    // 第一次解析格式化串, 之后使用缓存
+    for (i = 0; i < 3; i += 1) {
+        MString s;
+        EVAL(mstr_create_empty(&s));
+        EVAL(mstr_format(&s, fmt, 4, 42, &tm, array, 3));
+        ASSERT_EQUAL_STRING(&s, "@  42{16:55}1-2-3@");
+        mstr_free(&s);
+    }
+#if _MSTR_USE_FMT_CACHE
+    mstr_fmt_cache_statistics(&stat);
+    ASSERT_EQUAL_VALUE(stat.miss, 1);
+    ASSERT_EQUAL_VALUE(stat.hit, 2);
+    ASSERT_EQUAL_VALUE(stat.entry_count, 1);
+    TEST_ASSERT_TRUE(stat.used_size <= stat.capacity);
+    mstr_fmt_cache_clear();
+#endif // _MSTR_USE_FMT_CACHE
+}
@@ -201,3 +201,74 @@ void fmt_chrono_userdef_week(void)
     ASSERT_EQUAL_STRING(&s, "@6@");
     mstr_free(&s);
 }
+
+void fmt_chrono_timestamp(void)
+{
+    // 和time_value是同一个时间
+    const MStrTimestamp ts = {1683392119, 123456789};
+    const MStrTimestamp ts_leap = {1709164800, 0};
+    const MStrTimestamp ts_neg = {-1, 999999999};
+    const MStrTimestamp ts_min = {-62167219200, 0};
+    // 星期日
+    const MStrTimestamp ts_sun = {-1598781538, 123400000};
+    MString s;
+    EVAL(mstr_create_empty(&s));
+    EVAL(mstr_format(&s, "@{0:T:%f}@", 1, &ts));
+    ASSERT_EQUAL_STRING(&s, "@2023-05-06 16:55:19.1234 6@");
+    // 闰日, 1970年之前, 最小值
+    mstr_clear(&s);
+    EVAL(mstr_format(
+        &s, "@{0:T:%g}@{1:T:%g}@", 2, &ts_leap, &ts_neg
+    ));
+    ASSERT_EQUAL_STRING(
+        &s, "@2024-02-29 00:00:00.0000@1969-12-31 23:59:59.9999@"
+    );
+    mstr_clear(&s);
+    EVAL(mstr_format(&s, "@{0:T:%yyyy-%MM-%dd %w}@", 1, &ts_min));
+    ASSERT_EQUAL_STRING(&s, "@0000-01-01 6@");
+    mstr_clear(&s);
+    EVAL(mstr_format(&s, "@{0:T:%f}@", 1, &ts_sun));
+    ASSERT_EQUAL_STRING(&s, "@1919-05-04 14:01:02.1234 7@");
+    mstr_free(&s);
+}
+
+void fmt_chrono_timestamp_err(void)
+{
+    const MStrTimestamp ts_big = {253402300800, 0};
+    const MStrTimestamp ts_ns = {0, 1000000000};
+    mstr_result_t res;
+    MString s;
+    EVAL(mstr_create_empty(&s));
+    res = mstr_format(&s, "{0:T:%g}", 1, &ts_big);
+    TEST_ASSERT_TRUE(res == MStr_Err_TimestampOutOfRange);
+    res = mstr_format(&s, "{0:T:%g}", 1, &ts_ns);
+    TEST_ASSERT_TRUE(res == MStr_Err_TimestampOutOfRange);
+    mstr_free(&s);
+}
+
+void fmt_chrono_cache(void)
+{
+    // 可以修改的格式化串, 分隔符的地址不变但是内容改变
+    char fmt[] = "@{0:t:%HH:%mm:%ss.%xx}@";
+    MStrTime tm = time_value;
+    MString s;
+    EVAL(mstr_create_empty(&s));
+    EVAL(mstr_format(&s, fmt, 1, &tm));
+    // 只有亚秒值改变
+    tm.sub_second = 0x5678;
+    EVAL(mstr_format(&s, fmt, 1, &tm));
+    // 秒改变
+    tm.second = 0x20;
+    EVAL(mstr_format(&s, fmt, 1, &tm));
+    ASSERT_EQUAL_STRING(&s, "@16:55:19.12@@16:55:19.56@@16:55:20.56@");
+    // 格式改变
+    mstr_clear(&s);
+    fmt[9] = '-';
+    EVAL(mstr_format(&s, fmt, 1, &tm));
+    EVAL(mstr_format(&s, "@{0:t:%H:%m:%s.%x}@", 1, &tm));
+    EVAL(mstr_format(&s, "@{0:t:%g}@", 1, &tm));
+    ASSERT_EQUAL_STRING(
+        &s, "@16-55:20.56@@16:55:20.5@@2023-05-06 16:55:20.5678@"
+    );
+    mstr_free(&s);
+}
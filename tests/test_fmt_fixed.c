@@ -36,9 +36,10 @@ void fmt_quat_value_dualprec(void)
     MString s;
     EVAL(mstr_create_empty(&s));
     // 1/4096 ..
+    // 2^-31 = 4.656612873077392578125e-10
     EVAL(mstr_format(&s, "@{0:q12}@{1:q31}@", 2, 1, 1));
     ASSERT_EQUAL_STRING(
-        &s, "@0.000244140625@0.0000000000000000000002166527565@"
+        &s, "@0.000244140625@0.0000000004656612873077392578125@"
     );
     mstr_free(&s);
 }
@@ -52,3 +53,85 @@ void fmt_quat_value_singprec(void)
     ASSERT_EQUAL_STRING(&s, "@0.25@");
     mstr_free(&s);
 }
+
+void fmt_quat_value_prec(void)
+{
+    MString s;
+    EVAL(mstr_create_empty(&s));
+    // 0.000244140625和-0.000244140625
+    EVAL(mstr_format(&s, "@{0:q12:.3}@{1:q12:.6}@", 2, 1, -1));
+    ASSERT_EQUAL_STRING(&s, "@0.000@-0.000244@");
+    // 0.99951171875, 进位到整数部分
+    mstr_clear(&s);
+    EVAL(mstr_format(&s, "@{0:q11u:.2}@{1:q11:>7.1}@", 2, 2047, 3072));
+    ASSERT_EQUAL_STRING(&s, "@1.00@    1.5@");
+    mstr_free(&s);
+}
+
+void fmt_quat_value_q63(void)
+{
+    MString s;
+    // 0.25和-0.5
+    const int64_t v1 = (int64_t)1 << 61;
+    const int64_t v2 = -((int64_t)1 << 62);
+    // 2^-63 = 1.08420217248550443400745280086994171142578125e-19
+    const uint64_t v3 = 1;
+    EVAL(mstr_create_empty(&s));
+    EVAL(mstr_format(&s, "@{0:q63}@{1:q63:.3}@", 2, &v1, &v2));
+    ASSERT_EQUAL_STRING(&s, "@0.25@-0.500@");
+    mstr_clear(&s);
+    EVAL(mstr_format(&s, "@{0:q63u:.20}@", 1, &v3));
+    ASSERT_EQUAL_STRING(&s, "@0.00000000000000000011@");
+    mstr_free(&s);
+}
+
+void fmt_fixed_value(void)
+{
+    MString s;
+    EVAL(mstr_create_empty(&s));
+    // 40 / 16 = 2.5
+    EVAL(mstr_format(&s, "@{0:F12.4}@{1:F12.4}@", 2, 40, -40));
+    ASSERT_EQUAL_STRING(&s, "@2.5@-2.5@");
+    // 只使用低8位: 0xf8 = -8
+    mstr_clear(&s);
+    EVAL(mstr_format(&s, "@{0:F4.4}@{1:F4.4}@", 2, 0xf8, 0x1f8));
+    ASSERT_EQUAL_STRING(&s, "@-0.5@-0.5@");
+    // 无符号版本
+    mstr_clear(&s);
+    EVAL(mstr_format(&s, "@{0:F12.4u}@{1:F32.0u}@", 2, 0xfff8, -1));
+    ASSERT_EQUAL_STRING(&s, "@4095.5@4294967295@");
+    mstr_free(&s);
+}
+
+void fmt_fixed_value_prec(void)
+{
+    MString s;
+    EVAL(mstr_create_empty(&s));
+    // 0.0625和0.1875, 0.5时舍入到偶数
+    EVAL(mstr_format(&s, "@{0:F12.4:.2}@{1:F12.4:.3}@", 2, 1, 3));
+    ASSERT_EQUAL_STRING(&s, "@0.06@0.188@");
+    // 15.9375, 进位到整数部分
+    mstr_clear(&s);
+    EVAL(mstr_format(&s, "@{0:F4.4u:.1}@{1:F4.4u:.0}@", 2, 0xff, 0xff));
+    ASSERT_EQUAL_STRING(&s, "@15.9@16@");
+    // 和宽度, 符号一起使用
+    mstr_clear(&s);
+    EVAL(mstr_format(&s, "@{0:F12.4:>8.2}@{1:F12.4:+.1}@", 2, 40, 40));
+    ASSERT_EQUAL_STRING(&s, "@    2.50@+2.5@");
+    mstr_free(&s);
+}
+
+void fmt_fixed_value_err(void)
+{
+    MString s;
+    mstr_result_t res;
+    EVAL(mstr_create_empty(&s));
+    // 超过32位
+    res = mstr_format(&s, "{0:F30.4}", 1, 0);
+    TEST_ASSERT_TRUE(res == MStr_Err_UnsupportQuantBits);
+    // 小数位数太多
+    mstr_clear(&s);
+    res = mstr_format(&s, "{0:F12.4:.40}", 1, 0);
+    TEST_ASSERT_TRUE(res == MStr_Err_PrecisionTooLarge);
+    mstr_free(&s);
+}
@@ -77,3 +77,29 @@ void fmt_integer_array_u32(void)
     ASSERT_EQUAL_STRING(&s, "@123, 4294967295@");
     mstr_free(&s);
 }
+
+void fmt_integer_array_long(void)
+{
+    MString s, expect;
+    int16_t arr[40];
+    usize_t i;
+    EVAL(mstr_create_empty(&s));
+    EVAL(mstr_create_empty(&expect));
+    for (i = 0; i < ARRAY_SIZE(arr); i += 1) {
+        arr[i] = (int16_t)((int32_t)(i * 47) - 900);
+        EVAL(mstr_fmt_itoa(
+            &expect,
+            arr[i],
+            MStrFmtIntIndex_Dec,
+            MStrFmtSignDisplay_NegOnly
+        ));
+        if (i + 1 < ARRAY_SIZE(arr)) {
+            EVAL(mstr_concat_cstr(&expect, ", "));
+        }
+    }
+    // 跨越多个分块
+    EVAL(mstr_format(&s, "{[0:i16]}", 2, arr, ARRAY_SIZE(arr)));
+    TEST_ASSERT_TRUE(mstr_equal(&s, &expect));
+    mstr_free(&s);
+    mstr_free(&expect);
+}
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    test_hash.cpp
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   字符串的哈希
+ * @version 1.0
+ * @date    2023-08-31
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "mtfmt.hpp"
+#include "test_helper.h"
+#include "test_main.h"
+#include "unity.h"
+#include <stdio.h>
+#include <string.h>
+#include <unordered_set>
+
+/**
+ * @brief 测试数据
+ *
+ */
+static uint8_t hash_data[200];
+
+/**
+ * @brief 填充测试数据
+ *
+ */
+static void fill_hash_data(void)
+{
+    for (std::size_t i = 0; i < sizeof(hash_data); i += 1) {
+        hash_data[i] = static_cast<uint8_t>(i * 131 + 7);
+    }
+}
+
+extern "C" void hash_basic(void)
+{
+    MString str;
+    MStringView view;
+    EVAL(mstr_create(&str, "metric.cpu.load"));
+    mstr_view_of(&view, &str);
+    uint64_t h = mstr_hash(&str);
+    ASSERT_EQUAL_VALUE(h, mstr_hash_view(&view));
+    ASSERT_EQUAL_VALUE(h, mstr_hash_bytes(str.buff, str.count, 0));
+    // 内容、长度和种子都会改变哈希值
+    ASSERT_NOTEQUAL_VALUE(h, mstr_hash_bytes(str.buff, str.count, 1));
+    ASSERT_NOTEQUAL_VALUE(h, mstr_hash_bytes(str.buff, 14, 0));
+    ASSERT_NOTEQUAL_VALUE(
+        mstr_hash_bytes("", 0, 0), mstr_hash_bytes("\0", 1, 0)
+    );
+    // 改变任意一个字节
+    fill_hash_data();
+    for (std::size_t len = 1; len < sizeof(hash_data); len += 7) {
+        uint64_t h0 = mstr_hash_bytes(hash_data, len, 0);
+        for (std::size_t i = 0; i < len; i += 1) {
+            hash_data[i] ^= 1;
+            TEST_ASSERT_TRUE(mstr_hash_bytes(hash_data, len, 0) != h0);
+            hash_data[i] ^= 1;
+        }
+    }
+    mstr_free(&str);
+}
+
+extern "C" void hash_incremental(void)
+{
+    fill_hash_data();
+    for (std::size_t len = 0; len <= sizeof(hash_data); len += 1) {
+        uint64_t expect = mstr_hash_bytes(hash_data, len, 42);
+        // 分成两次输入
+        for (std::size_t split = 0; split <= len; split += 5) {
+            MStrHashState st;
+            mstr_hash_init(&st, 42);
+            mstr_hash_update(&st, hash_data, split);
+            mstr_hash_update(&st, hash_data + split, len - split);
+            ASSERT_EQUAL_VALUE(mstr_hash_final(&st), expect);
+        }
+        // 每次输入一个字节
+        MStrHashState st;
+        mstr_hash_init(&st, 42);
+        for (std::size_t i = 0; i < len; i += 1) {
+            mstr_hash_update(&st, hash_data + i, 1);
+        }
+        ASSERT_EQUAL_VALUE(mstr_hash_final(&st), expect);
+    }
+}
+
+extern "C" void hash_cpp(void)
+{
+    mtfmt::string a = u8"tag=alpha";
+    mtfmt::string b = u8"tag=beta";
+    mtfmt::string_view va = u8"tag=alpha";
+    std::hash<mtfmt::string> hs;
+    std::hash<mtfmt::string_view> hv;
+    ASSERT_EQUAL_VALUE(hs(a), hv(va));
+    ASSERT_NOTEQUAL_VALUE(hs(a), hs(b));
+    std::unordered_set<mtfmt::string> set;
+    set.insert(a);
+    set.insert(b);
+    set.insert(mtfmt::string(u8"tag=alpha"));
+    ASSERT_EQUAL_VALUE(set.size(), 2);
+    TEST_ASSERT_TRUE(set.count(b) == 1);
+}
@@ -0,0 +1,99 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    test_intern.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   字符串驻留表
+ * @version 1.0
+ * @date    2023-08-30
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "mtfmt.h"
+#include "test_helper.h"
+#include "test_main.h"
+#include "unity.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void intern_basic(void)
+{
+    MStrInternTable tab;
+    MString str;
+    MStringView view;
+    const MStrInterned* a;
+    const MStrInterned* b;
+    const MStrInterned* c;
+    mstr_intern_init(&tab, 128);
+    mstr_view_from_cstr(&view, "host=a", NULL);
+    TEST_ASSERT_TRUE(mstr_intern_lookup(&tab, &view) == NULL);
+    EVAL(mstr_intern_cstr(&tab, "host=a", &a));
+    EVAL(mstr_create(&str, "host=a"));
+    EVAL(mstr_intern(&tab, &str, &b));
+    // 内容相同时返回同一个指针
+    TEST_ASSERT_TRUE(a == b);
+    ASSERT_EQUAL_VALUE(tab.count, 1);
+    EVAL(mstr_intern_cstr(&tab, "host=b", &c));
+    TEST_ASSERT_TRUE(a != c);
+    TEST_ASSERT_TRUE(strcmp(c->view.buff, "host=b") == 0);
+    ASSERT_EQUAL_VALUE(c->view.count, 6);
+    // 查找
+    mstr_view_from_cstr(&view, "host=b", NULL);
+    TEST_ASSERT_TRUE(mstr_intern_lookup(&tab, &view) == c);
+    mstr_view_from_cstr(&view, "host=c", NULL);
+    TEST_ASSERT_TRUE(mstr_intern_lookup(&tab, &view) == NULL);
+    // 空字符串
+    EVAL(mstr_intern_cstr(&tab, "", &a));
+    ASSERT_EQUAL_VALUE(a->view.count, 0);
+    ASSERT_EQUAL_VALUE(a->view.buff[0], '\0');
+#if _MSTR_USE_UTF_8
+    EVAL(mstr_intern_cstr(&tab, "标签", &a));
+    ASSERT_EQUAL_VALUE(a->view.length, 2);
+#endif // _MSTR_USE_UTF_8
+    mstr_free(&str);
+    mstr_intern_free(&tab);
+    ASSERT_EQUAL_VALUE(tab.count, 0);
+}
+
+void intern_grow(void)
+{
+    MStrInternTable tab;
+    MStrInternStatistics stat;
+    const MStrInterned* handles[16];
+    const MStrInterned* h;
+    char name[8];
+    usize_t i;
+    mstr_intern_init(&tab, 256);
+    for (i = 0; i < 16; i += 1) {
+        sprintf(name, "k%02u", (unsigned)i);
+        EVAL(mstr_intern_cstr(&tab, name, &handles[i]));
+    }
+    // 扩大之后指针不变
+    for (i = 0; i < 16; i += 1) {
+        sprintf(name, "k%02u", (unsigned)i);
+        EVAL(mstr_intern_cstr(&tab, name, &h));
+        TEST_ASSERT_TRUE(h == handles[i]);
+    }
+    ASSERT_EQUAL_VALUE(tab.count, 16);
+    TEST_ASSERT_TRUE(tab.capacity * 7 >= tab.count * 8);
+    // 超过arena块大小的字符串
+    {
+        char long_str[160];
+        memset(long_str, 'x', sizeof(long_str) - 1);
+        long_str[sizeof(long_str) - 1] = '\0';
+        EVAL(mstr_intern_cstr(&tab, long_str, &h));
+        ASSERT_EQUAL_VALUE(h->view.count, 159);
+        EVAL(mstr_intern_cstr(&tab, "k16", &h));
+    }
+    mstr_intern_statistics(&tab, &stat);
+    ASSERT_EQUAL_VALUE(stat.entry_count, 18);
+    ASSERT_EQUAL_VALUE(stat.string_size, 16 * 3 + 159 + 3);
+    TEST_ASSERT_TRUE(stat.arena_used <= stat.arena_capacity);
+    TEST_ASSERT_TRUE(stat.arena_used >= stat.string_size);
+    ASSERT_EQUAL_VALUE(
+        stat.table_size, tab.capacity * (1 + sizeof(void*))
+    );
+    mstr_intern_free(&tab);
+}
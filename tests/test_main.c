@@ -52,6 +52,7 @@ int main()
     mstr_heap_init(heap, RUNTIME_HEAP_SIZE);
 
     RUN_TEST(allocate_then_free);
+    RUN_TEST(allocate_small_remainder);
 
     RUN_TEST(monadic_result_object_basic);
     RUN_TEST(monadic_result_copy_non_trivial_type);
@@ -68,6 +69,8 @@ int main()
 
     RUN_TEST(string_copy_create);
     RUN_TEST(string_move_create);
+    RUN_TEST(string_shared_copy);
+    RUN_TEST(string_shared_detach);
     RUN_TEST(string_length);
     RUN_TEST(string_char_at);
     RUN_TEST(string_insert);
@@ -77,6 +80,7 @@ int main()
     RUN_TEST(string_not_equal);
     RUN_TEST(string_end_with);
     RUN_TEST(string_start_with);
+    RUN_TEST(string_compare);
 
     RUN_TEST(string_concat_object);
     RUN_TEST(string_concat_c_str);
@@ -97,6 +101,12 @@ int main()
     RUN_TEST(string_find_or_error);
     RUN_TEST(string_contain);
 
+    RUN_TEST(string_view_basic);
+    RUN_TEST(string_view_cpp);
+    RUN_TEST(string_split_chars);
+    RUN_TEST(string_split_str);
+    RUN_TEST(string_split_cpp);
+
     RUN_TEST(string_retain_all);
     RUN_TEST(string_retain_endwith);
     RUN_TEST(string_retain_startwith);
@@ -133,6 +143,7 @@ int main()
     RUN_TEST(fmt_integer_array_u8);
     RUN_TEST(fmt_integer_array_u16);
     RUN_TEST(fmt_integer_array_u32);
+    RUN_TEST(fmt_integer_array_long);
 
     RUN_TEST(fmt_align_left);
     RUN_TEST(fmt_align_left_fill);
@@ -145,15 +156,23 @@ int main()
     RUN_TEST(fmt_align_middle_long);
     RUN_TEST(fmt_seq_arg_id);
     RUN_TEST(fmt_seq_arg_id_err);
+    RUN_TEST(fmt_argv_random_access);
+    RUN_TEST(fmt_argv_err);
 
     RUN_TEST(fmt_quat_value_sign);
     RUN_TEST(fmt_quat_value_dualprec);
     RUN_TEST(fmt_quat_value_singprec);
+    RUN_TEST(fmt_quat_value_prec);
+    RUN_TEST(fmt_quat_value_q63);
+    RUN_TEST(fmt_fixed_value);
+    RUN_TEST(fmt_fixed_value_prec);
+    RUN_TEST(fmt_fixed_value_err);
 
     RUN_TEST(fmt_behav_signed_bin);
     RUN_TEST(fmt_behav_signed_oct);
     RUN_TEST(fmt_behav_signed_dec);
     RUN_TEST(fmt_behav_signed_hex);
+    RUN_TEST(fmt_behav_cache);
 
     RUN_TEST(fmt_sign_add);
     RUN_TEST(fmt_sign_sub);
@@ -168,6 +187,9 @@ int main()
     RUN_TEST(fmt_array);
     RUN_TEST(fmt_array_element_style);
     RUN_TEST(fmt_array_userdefind_split);
+    RUN_TEST(fmt_array_hex_bytes);
+    RUN_TEST(fmt_array_hexdump);
+    RUN_TEST(fmt_array_base_encoding);
 
     RUN_TEST(fmt_chrono_default_f);
     RUN_TEST(fmt_chrono_default_g);
@@ -179,13 +201,46 @@ int main()
     RUN_TEST(fmt_chrono_userdef_second);
     RUN_TEST(fmt_chrono_userdef_subsecond);
     RUN_TEST(fmt_chrono_userdef_week);
+    RUN_TEST(fmt_chrono_timestamp);
+    RUN_TEST(fmt_chrono_timestamp_err);
+    RUN_TEST(fmt_chrono_cache);
 
     RUN_TEST(fmt_escape_bracket);
 
     RUN_TEST(sync_io_write);
 
+    RUN_TEST(scan_int_dec);
+    RUN_TEST(scan_int_base);
+    RUN_TEST(scan_int_err);
+    RUN_TEST(scan_fixed);
+    RUN_TEST(scan_fixed_roundtrip);
+    RUN_TEST(scan_fmt_basic);
+    RUN_TEST(scan_fmt_types);
+    RUN_TEST(scan_fmt_fill);
+    RUN_TEST(scan_fmt_repeat);
+    RUN_TEST(scan_fmt_err);
+    RUN_TEST(scan_fmt_compiled);
+    RUN_TEST(scan_float_basic);
+    RUN_TEST(scan_float_round);
+    RUN_TEST(scan_float_err);
+    RUN_TEST(scan_float_single);
+
+    RUN_TEST(rope_concat);
+    RUN_TEST(rope_format_flush);
+    RUN_TEST(intern_basic);
+    RUN_TEST(intern_grow);
+    RUN_TEST(hash_basic);
+    RUN_TEST(hash_incremental);
+    RUN_TEST(hash_cpp);
+    RUN_TEST(sort_string);
+    RUN_TEST(sort_view);
+    RUN_TEST(sort_parallel);
+
     RUN_TEST(cpp_wrap_fmt);
     RUN_TEST(cpp_wrap_fmt_parser);
+    RUN_TEST(cpp_wrap_fmt_typed_args);
+    RUN_TEST(cpp_wrap_fmt_compiled);
+    RUN_TEST(cpp_wrap_fmt_reuse);
 
     usize_t alloc_cnt, free_cnt, usage_mark;
     mstr_heap_get_allocate_count(&alloc_cnt, &free_cnt);
@@ -17,6 +17,7 @@ extern "C"
 {
 #endif
     void allocate_then_free(void);
+    void allocate_small_remainder(void);
 
     void monadic_result_object_basic(void);
     void monadic_result_copy_non_trivial_type(void);
@@ -33,6 +34,8 @@ extern "C"
 
     void string_copy_create(void);
     void string_move_create(void);
+    void string_shared_copy(void);
+    void string_shared_detach(void);
     void string_length(void);
     void string_char_at(void);
     void string_insert(void);
@@ -42,6 +45,7 @@ extern "C"
     void string_not_equal(void);
     void string_end_with(void);
     void string_start_with(void);
+    void string_compare(void);
 
     void string_concat_object(void);
     void string_concat_c_str(void);
@@ -62,6 +66,12 @@ extern "C"
     void string_find_large(void);
     void string_find_or_error(void);
 
+    void string_view_basic(void);
+    void string_view_cpp(void);
+    void string_split_chars(void);
+    void string_split_str(void);
+    void string_split_cpp(void);
+
     void string_retain_all(void);
     void string_retain_endwith(void);
     void string_retain_startwith(void);
@@ -98,6 +108,7 @@ extern "C"
     void fmt_integer_array_u8(void);
     void fmt_integer_array_u16(void);
     void fmt_integer_array_u32(void);
+    void fmt_integer_array_long(void);
 
     void fmt_align_left(void);
     void fmt_align_left_fill(void);
@@ -111,15 +122,23 @@ extern "C"
 
     void fmt_seq_arg_id(void);
     void fmt_seq_arg_id_err(void);
+    void fmt_argv_random_access(void);
+    void fmt_argv_err(void);
 
     void fmt_quat_value_sign(void);
     void fmt_quat_value_dualprec(void);
     void fmt_quat_value_singprec(void);
+    void fmt_quat_value_prec(void);
+    void fmt_quat_value_q63(void);
+    void fmt_fixed_value(void);
+    void fmt_fixed_value_prec(void);
+    void fmt_fixed_value_err(void);
 
     void fmt_behav_signed_bin(void);
     void fmt_behav_signed_oct(void);
     void fmt_behav_signed_dec(void);
     void fmt_behav_signed_hex(void);
+    void fmt_behav_cache(void);
 
     void fmt_sign_add(void);
     void fmt_sign_sub(void);
@@ -134,6 +153,9 @@ extern "C"
     void fmt_array(void);
     void fmt_array_element_style(void);
     void fmt_array_userdefind_split(void);
+    void fmt_array_hex_bytes(void);
+    void fmt_array_hexdump(void);
+    void fmt_array_base_encoding(void);
 
     void fmt_chrono_default_f(void);
     void fmt_chrono_default_g(void);
@@ -145,13 +167,46 @@ extern "C"
     void fmt_chrono_userdef_second(void);
     void fmt_chrono_userdef_subsecond(void);
     void fmt_chrono_userdef_week(void);
+    void fmt_chrono_timestamp(void);
+    void fmt_chrono_timestamp_err(void);
+    void fmt_chrono_cache(void);
 
     void fmt_escape_bracket(void);
 
     void sync_io_write(void);
 
+    void scan_int_dec(void);
+    void scan_int_base(void);
+    void scan_int_err(void);
+    void scan_fixed(void);
+    void scan_fixed_roundtrip(void);
+    void scan_fmt_basic(void);
+    void scan_fmt_types(void);
+    void scan_fmt_fill(void);
+    void scan_fmt_repeat(void);
+    void scan_fmt_err(void);
+    void scan_fmt_compiled(void);
+    void scan_float_basic(void);
+    void scan_float_round(void);
+    void scan_float_err(void);
+    void scan_float_single(void);
+
+    void rope_concat(void);
+    void rope_format_flush(void);
+    void intern_basic(void);
+    void intern_grow(void);
+    void hash_basic(void);
+    void hash_incremental(void);
+    void hash_cpp(void);
+    void sort_string(void);
+    void sort_view(void);
+    void sort_parallel(void);
+
     void cpp_wrap_fmt(void);
     void cpp_wrap_fmt_parser(void);
+    void cpp_wrap_fmt_typed_args(void);
+    void cpp_wrap_fmt_compiled(void);
+    void cpp_wrap_fmt_reuse(void);
 #if __cplusplus
 }
 #endif
@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    test_rope.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   分块的字符串构建器
+ * @version 1.0
+ * @date    2023-08-28
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "mtfmt.h"
+#include "test_helper.h"
+#include "test_main.h"
+#include "unity.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief IO写入的次数
+ *
+ */
+static usize_t write_cnt;
+
+/**
+ * @brief 把数据追加到字符串的IO
+ *
+ */
+static mstr_result_t collect_write(
+    void* ctx, const byte_t* data, usize_t len
+)
+{
+    const char* beg = (const char*)data;
+    write_cnt += 1;
+    return mstr_concat_cstr_slice((MString*)ctx, beg, beg + len);
+}
+
+void rope_concat(void)
+{
+    MStrRope rope;
+    MString str;
+    mstr_rope_init(&rope, 8);
+    EVAL(mstr_rope_concat_cstr(&rope, "Hello"));
+    EVAL(mstr_rope_concat_cstr(&rope, ", "));
+    EVAL(mstr_rope_concat_cstr(&rope, "chunked world!"));
+    ASSERT_EQUAL_VALUE(rope.count, 21);
+    EVAL(mstr_create(&str, ">"));
+    EVAL(mstr_rope_flatten(&rope, &str));
+    ASSERT_EQUAL_STRING(&str, ">Hello, chunked world!");
+    ASSERT_EQUAL_VALUE(str.length, 22);
+    // 清空之后重新使用块
+    mstr_rope_clear(&rope);
+    TEST_ASSERT_TRUE(rope.free_list != NULL);
+    EVAL(mstr_rope_concat(&rope, &str));
+    ASSERT_EQUAL_VALUE(rope.count, 22);
+    mstr_clear(&str);
+    EVAL(mstr_rope_flatten(&rope, &str));
+    ASSERT_EQUAL_STRING(&str, ">Hello, chunked world!");
+#if _MSTR_USE_UTF_8
+    mstr_rope_clear(&rope);
+    EVAL(mstr_rope_concat_cstr(&rope, "汉字😊"));
+    ASSERT_EQUAL_VALUE(rope.length, 3);
+    mstr_clear(&str);
+    EVAL(mstr_rope_flatten(&rope, &str));
+    ASSERT_EQUAL_STRING(&str, "汉字😊");
+    ASSERT_EQUAL_VALUE(str.length, 3);
+#endif // _MSTR_USE_UTF_8
+    mstr_free(&str);
+    mstr_rope_free(&rope);
+}
+
+void rope_format_flush(void)
+{
+    MStrRope rope, dst;
+    MString out;
+    MStrIOCallback io;
+    mstr_rope_init(&rope, 16);
+    EVAL(mstr_create_empty(&out));
+    EVAL(mstr_io_init(&out, &io, collect_write));
+    EVAL(mstr_rope_format(&rope, "[{0:i32}]", 1, (int32_t)-42));
+    EVAL(mstr_ioformat(
+        mstr_rope_io(&rope), " {0:s}={1:u8:h}", 2, "key", (uint8_t)0xa5
+    ));
+    EVAL(mstr_rope_concat_cstr(&rope, " 0123456789abcdef"));
+    // 每个块写一次
+    write_cnt = 0;
+    EVAL(mstr_rope_flush(&rope, &io));
+    ASSERT_EQUAL_VALUE(write_cnt, 2);
+    ASSERT_EQUAL_STRING(&out, "[-42] key=a5 0123456789abcdef");
+    ASSERT_EQUAL_VALUE(rope.count, 0);
+    mstr_rope_free(&rope);
+    // 多字节字符不会被分到两个块中, 可以写到需要完整字符的IO
+    mstr_rope_init(&rope, 8);
+    mstr_rope_init(&dst, 8);
+    EVAL(mstr_rope_concat_cstr(&rope, "汉字😊abc"));
+    EVAL(mstr_rope_flush(&rope, mstr_rope_io(&dst)));
+    mstr_clear(&out);
+    EVAL(mstr_rope_flatten(&dst, &out));
+    ASSERT_EQUAL_STRING(&out, "汉字😊abc");
+    ASSERT_EQUAL_VALUE(dst.count, 13);
+#if _MSTR_USE_UTF_8
+    ASSERT_EQUAL_VALUE(dst.length, 6);
+#endif // _MSTR_USE_UTF_8
+    mstr_free(&out);
+    mstr_rope_free(&rope);
+    mstr_rope_free(&dst);
+}
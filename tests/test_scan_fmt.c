@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    test_scan_fmt.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   按照格式化串读取值
+ * @version 1.0
+ * @date    2023-08-22
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "mtfmt.h"
+#include "test_helper.h"
+#include "test_main.h"
+#include "unity.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+void scan_fmt_basic(void)
+{
+    MString input;
+    int32_t t = 0;
+    uint16_t h = 0;
+    EVAL(mstr_create(&input, "T=-12 H=65535"));
+    EVAL(mstr_scan(&input, "T={0:i32} H={1:u16}", 2, &t, &h));
+    ASSERT_EQUAL_VALUE(t, -12);
+    ASSERT_EQUAL_VALUE(h, 65535);
+    // 同一个参数可以出现多次, 值需要相同
+    mstr_clear(&input);
+    EVAL(mstr_concat_cstr(&input, "T=7 H=8 T=7"));
+    EVAL(mstr_scan(&input, "T={0:i32} H={1:u16} T={0:i32}", 2, &t, &h));
+    ASSERT_EQUAL_VALUE(t, 7);
+    ASSERT_EQUAL_VALUE(h, 8);
+    mstr_free(&input);
+}
+
+void scan_fmt_types(void)
+{
+    MString input, name;
+    int8_t i8 = 0;
+    uint32_t x = 0, h = 0, w = 0;
+    int32_t q = 0, f = 0;
+    int64_t q63 = 0;
+    EVAL(mstr_create(&input, "{-5:0xBEEF} a5|  42|"));
+    EVAL(mstr_scan(
+        &input,
+        "{{{0:i8}:{1:u32:x}}} {2:u32:h}|{3:u32:>4}|",
+        4,
+        &i8,
+        &x,
+        &h,
+        &w
+    ));
+    ASSERT_EQUAL_VALUE(i8, -5);
+    ASSERT_EQUAL_VALUE(x, 0xbeef);
+    ASSERT_EQUAL_VALUE(h, 0xa5);
+    ASSERT_EQUAL_VALUE(w, 42);
+    mstr_clear(&input);
+    EVAL(mstr_concat_cstr(&input, "v=0.5,-2.5,-0.5;name=abc"));
+    EVAL(mstr_create_empty(&name));
+    EVAL(mstr_scan(
+        &input,
+        "v={0:q15},{1:F12.4},{2:q63};name={3:s}",
+        4,
+        &q,
+        &f,
+        &q63,
+        &name
+    ));
+    ASSERT_EQUAL_VALUE(q, 16384);
+    ASSERT_EQUAL_VALUE(f, -40);
+    ASSERT_EQUAL_VALUE(q63, INT64_MIN / 2);
+    ASSERT_EQUAL_STRING(&name, "abc");
+    // 字符串读取到下一个字面量
+    mstr_clear(&input);
+    EVAL(mstr_concat_cstr(&input, "[ab,c]"));
+    EVAL(mstr_scan(&input, "[{0:s},{1:s}]", 2, &name, &name));
+    ASSERT_EQUAL_STRING(&name, "c");
+    mstr_free(&name);
+    mstr_free(&input);
+}
+
+void scan_fmt_fill(void)
+{
+    static const char* fmt[] = {
+        "[{0:i32:0>8}]",
+        "[{0:i32:*<8}]",
+        "[{0:i32:*=8}]",
+        "[{0:i32:8}]",
+    };
+    static const int32_t value[] = {100, 0, -5, 7, 42};
+    MString s;
+    int32_t x;
+    usize_t i, j;
+    EVAL(mstr_create_empty(&s));
+    // 格式化之后再按照相同的模板读回来
+    for (i = 0; i < sizeof(fmt) / sizeof(fmt[0]); i += 1) {
+        for (j = 0; j < sizeof(value) / sizeof(value[0]); j += 1) {
+            mstr_clear(&s);
+            EVAL(mstr_format(&s, fmt[i], 1, value[j]));
+            x = -1;
+            EVAL(mstr_scan(&s, fmt[i], 1, &x));
+            ASSERT_EQUAL_VALUE(x, value[j]);
+        }
+    }
+    // 只去掉填充的一侧
+    mstr_clear(&s);
+    EVAL(mstr_format(&s, "[{0:i32:0>8}]", 1, 100));
+    ASSERT_EQUAL_STRING(&s, "[00000100]");
+    mstr_clear(&s);
+    EVAL(mstr_concat_cstr(&s, "[00000000]"));
+    EVAL(mstr_scan(&s, "[{0:i32:0>8}]", 1, &x));
+    ASSERT_EQUAL_VALUE(x, 0);
+    mstr_clear(&s);
+    EVAL(mstr_concat_cstr(&s, "[100*****]"));
+    EVAL(mstr_scan(&s, "[{0:i32:*<8}]", 1, &x));
+    ASSERT_EQUAL_VALUE(x, 100);
+    // 右对齐时结尾的填充字符不是填充的内容
+    TEST_ASSERT_TRUE(
+        MSTR_FAILED(mstr_scan(&s, "[{0:i32:*>8}]", 1, &x))
+    );
+    mstr_free(&s);
+}
+
+void scan_fmt_repeat(void)
+{
+    MString s, name;
+    int32_t x = 0;
+    EVAL(mstr_create_empty(&name));
+    // 重复的值相同
+    EVAL(mstr_create(&s, "12,12"));
+    EVAL(mstr_scan(&s, "{0:i32},{0:i32}", 1, &x));
+    ASSERT_EQUAL_VALUE(x, 12);
+    mstr_clear(&s);
+    EVAL(mstr_concat_cstr(&s, "10=16"));
+    EVAL(mstr_scan(&s, "{0:i32:h}={0:i32}", 1, &x));
+    ASSERT_EQUAL_VALUE(x, 16);
+    mstr_clear(&s);
+    EVAL(mstr_concat_cstr(&s, "ab,ab"));
+    EVAL(mstr_scan(&s, "{0:s},{0:s}", 1, &name));
+    ASSERT_EQUAL_STRING(&name, "ab");
+    // 重复的值不同
+    mstr_clear(&s);
+    EVAL(mstr_concat_cstr(&s, "12,13"));
+    ASSERT_EQUAL_VALUE(
+        mstr_scan(&s, "{0:i32},{0:i32}", 1, &x),
+        MStr_Err_InputMismatch
+    );
+    ASSERT_EQUAL_VALUE(x, 12);
+    mstr_clear(&s);
+    EVAL(mstr_concat_cstr(&s, "ab,abc"));
+    ASSERT_EQUAL_VALUE(
+        mstr_scan(&s, "{0:s},{0:s}", 1, &name),
+        MStr_Err_InputMismatch
+    );
+    ASSERT_EQUAL_STRING(&name, "ab");
+    mstr_free(&s);
+    mstr_free(&name);
+}
+
+void scan_fmt_err(void)
+{
+    MString input;
+    int32_t i32 = 0;
+    uint8_t u8 = 0;
+    mstr_result_t res;
+    EVAL(mstr_create(&input, "T=12"));
+    res = mstr_scan(&input, "H={0:i32}", 1, &i32);
+    TEST_ASSERT_TRUE(res == MStr_Err_InputMismatch);
+    res = mstr_scan(&input, "T={0:i32}C", 1, &i32);
+    TEST_ASSERT_TRUE(res == MStr_Err_InputMismatch);
+    res = mstr_scan(&input, "T=1", 0);
+    TEST_ASSERT_TRUE(res == MStr_Err_InputMismatch);
+    res = mstr_scan(&input, "T={0:i32:x}", 1, &i32);
+    TEST_ASSERT_TRUE(res == MStr_Err_InvalidNumber);
+    res = mstr_scan(&input, "T={[0:i32]}", 2, &i32, 1);
+    TEST_ASSERT_TRUE(res == MStr_Err_UnsupportType);
+    res = mstr_scan(&input, "T={0:i32", 1, &i32);
+    TEST_ASSERT_TRUE(MSTR_FAILED(res));
+    mstr_clear(&input);
+    EVAL(mstr_concat_cstr(&input, "256"));
+    res = mstr_scan(&input, "{0:u8}", 1, &u8);
+    TEST_ASSERT_TRUE(res == MStr_Err_NumberOutOfRange);
+    mstr_free(&input);
+}
+
+void scan_fmt_compiled(void)
+{
+    static const char* fmt = "T={0:i32} H={1:u16}\r\n";
+    MStrScanTemplate tpl;
+    MString input;
+    int32_t t = 0;
+    uint16_t h = 0;
+    EVAL(mstr_scan_compile(&tpl, fmt));
+    ASSERT_EQUAL_VALUE(tpl.item_cnt, 5);
+    EVAL(mstr_create(&input, "T=25 H=40\r\n"));
+    EVAL(mstr_scan_compiled(&input, &tpl, 2, &t, &h));
+    ASSERT_EQUAL_VALUE(t, 25);
+    ASSERT_EQUAL_VALUE(h, 40);
+    mstr_clear(&input);
+    EVAL(mstr_concat_cstr(&input, "T=-3 H=1\r\n"));
+    EVAL(mstr_scan_compiled(&input, &tpl, 2, &t, &h));
+    ASSERT_EQUAL_VALUE(t, -3);
+    ASSERT_EQUAL_VALUE(h, 1);
+    mstr_free(&input);
+}
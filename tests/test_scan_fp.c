@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    test_scan_fp.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   字符串到浮点数的转换
+ * @version 1.0
+ * @date    2023-08-24
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "mtfmt.h"
+#include "test_helper.h"
+#include "test_main.h"
+#include "unity.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief 字符串的开始和结束
+ *
+ */
+#define SLICE(s) (s), (s) + strlen(s)
+
+void scan_float_basic(void)
+{
+#if _MSTR_USE_FP_FLOAT64
+    double f64 = 0;
+    const char* stop = NULL;
+    const char* str = "2.5e3, 1";
+    EVAL(mstr_parse_f64(&f64, SLICE("0.1"), NULL));
+    TEST_ASSERT_TRUE(f64 == 0.1);
+    EVAL(mstr_parse_f64(&f64, SLICE("-1234.5e-2"), NULL));
+    TEST_ASSERT_TRUE(f64 == -12.345);
+    EVAL(mstr_parse_f64(&f64, SLICE("+.5"), NULL));
+    TEST_ASSERT_TRUE(f64 == 0.5);
+    EVAL(mstr_parse_f64(&f64, SLICE("7."), NULL));
+    TEST_ASSERT_TRUE(f64 == 7.0);
+    EVAL(mstr_parse_f64(&f64, SLICE("1.7976931348623157e308"), NULL));
+    TEST_ASSERT_TRUE(f64 == 1.7976931348623157e308);
+    EVAL(mstr_parse_f64(&f64, SLICE("4.9406564584124654e-324"), NULL));
+    TEST_ASSERT_TRUE(f64 == 4.9406564584124654e-324);
+    EVAL(mstr_parse_f64(&f64, SLICE("-Infinity"), NULL));
+    TEST_ASSERT_TRUE(f64 < 0 && f64 * 0.5 == f64);
+    EVAL(mstr_parse_f64(&f64, SLICE("nan"), NULL));
+    TEST_ASSERT_TRUE(f64 != f64);
+    // 太小的值转换为0
+    EVAL(mstr_parse_f64(&f64, SLICE("-1e-400"), NULL));
+    TEST_ASSERT_TRUE(f64 == 0);
+    // 转换最长的有效前缀, 'e'之后没有数字时不是指数
+    EVAL(mstr_parse_f64(&f64, SLICE(str), &stop));
+    TEST_ASSERT_TRUE(f64 == 2500.0);
+    ASSERT_EQUAL_VALUE(stop, str + 5);
+    EVAL(mstr_parse_f64(&f64, SLICE("3e+x"), &stop));
+    TEST_ASSERT_TRUE(f64 == 3.0);
+#endif // _MSTR_USE_FP_FLOAT64
+}
+
+void scan_float_round(void)
+{
+#if _MSTR_USE_FP_FLOAT64
+    double f64 = 0;
+    // 2^53 + 1, 正好在中间, 舍入到偶数
+    EVAL(mstr_parse_f64(&f64, SLICE("9007199254740993"), NULL));
+    TEST_ASSERT_TRUE(f64 == 9007199254740992.0);
+    // 超过19位有效位, 截断的部分决定了舍入的方向
+    EVAL(mstr_parse_f64(
+        &f64, SLICE("9007199254740993.00000000000000000001"), NULL
+    ));
+    TEST_ASSERT_TRUE(f64 == 9007199254740994.0);
+    EVAL(mstr_parse_f64(
+        &f64, SLICE("9007199254740994.99999999999999999999"), NULL
+    ));
+    TEST_ASSERT_TRUE(f64 == 9007199254740994.0);
+    // 最小的非规格化数的一半, 舍入到偶数 (0)
+    EVAL(mstr_parse_f64(
+        &f64,
+        SLICE("2.4703282292062327208828439643411068618252990130716"
+              "238221279284125033775363510437593264991818081799618"
+              "989828234772285886546332835517796989819938739800539"
+              "093906315035659515570226392290858392449105184435931"
+              "802849936536152500319370457678249219365623669863658"
+              "480757001585769269903706311928279558551332927834338"
+              "409351978015531246597263579574622766465272827220056"
+              "374006485499977096599470454020828166226237857393450"
+              "736339007967761930577506740176324673600968951340535"
+              "537458516661134223766678604162159680461914467291840"
+              "300530057530849048765391711386591646239524912623653"
+              "881879636239373280423891018672348497668235089863388"
+              "587925628302755995657524455507255189313690836254779"
+              "186948667994968324049705821028513185451396213837722"
+              "826145437693412532098591327667236328125e-324"),
+        NULL
+    ));
+    TEST_ASSERT_TRUE(f64 == 0);
+    EVAL(mstr_parse_f64(
+        &f64,
+        SLICE("2.47032822920623272088284396434110686183e-324"),
+        NULL
+    ));
+    TEST_ASSERT_TRUE(f64 == 4.9406564584124654e-324);
+#endif // _MSTR_USE_FP_FLOAT64
+}
+
+void scan_float_err(void)
+{
+#if _MSTR_USE_FP_FLOAT64
+    double f64 = 7;
+    const char* stop = NULL;
+    mstr_result_t res;
+    res = mstr_parse_f64(&f64, SLICE(""), NULL);
+    TEST_ASSERT_TRUE(res == MStr_Err_InvalidNumber);
+    res = mstr_parse_f64(&f64, SLICE("-."), &stop);
+    TEST_ASSERT_TRUE(res == MStr_Err_InvalidNumber);
+    res = mstr_parse_f64(&f64, SLICE("e5"), &stop);
+    TEST_ASSERT_TRUE(res == MStr_Err_InvalidNumber);
+    res = mstr_parse_f64(&f64, SLICE("1.5 "), NULL);
+    TEST_ASSERT_TRUE(res == MStr_Err_InvalidNumber);
+    res = mstr_parse_f64(&f64, SLICE("infinit"), NULL);
+    TEST_ASSERT_TRUE(res == MStr_Err_InvalidNumber);
+    res = mstr_parse_f64(&f64, SLICE("1.7976931348623159e308"), NULL);
+    TEST_ASSERT_TRUE(res == MStr_Err_NumberOutOfRange);
+    res = mstr_parse_f64(&f64, SLICE("-1e99999999999"), NULL);
+    TEST_ASSERT_TRUE(res == MStr_Err_NumberOutOfRange);
+    // 失败时不修改输出
+    TEST_ASSERT_TRUE(f64 == 7);
+    ASSERT_EQUAL_VALUE(stop, NULL);
+#endif // _MSTR_USE_FP_FLOAT64
+}
+
+void scan_float_single(void)
+{
+#if _MSTR_USE_FP_FLOAT32
+    float f32 = 0;
+    mstr_result_t res;
+    EVAL(mstr_parse_f32(&f32, SLICE("0.1"), NULL));
+    TEST_ASSERT_TRUE(f32 == 0.1f);
+    EVAL(mstr_parse_f32(&f32, SLICE("3.4028234e38"), NULL));
+    TEST_ASSERT_TRUE(f32 == 3.4028234e38f);
+    EVAL(mstr_parse_f32(&f32, SLICE("1e-45"), NULL));
+    TEST_ASSERT_TRUE(f32 == 1e-45f);
+    // 2^24 + 1
+    EVAL(mstr_parse_f32(&f32, SLICE("16777217"), NULL));
+    TEST_ASSERT_TRUE(f32 == 16777216.0f);
+    EVAL(mstr_parse_f32(
+        &f32, SLICE("16777217.000000000000000001"), NULL
+    ));
+    TEST_ASSERT_TRUE(f32 == 16777218.0f);
+    res = mstr_parse_f32(&f32, SLICE("3.5e38"), NULL);
+    TEST_ASSERT_TRUE(res == MStr_Err_NumberOutOfRange);
+    TEST_ASSERT_TRUE(f32 == 16777218.0f);
+#endif // _MSTR_USE_FP_FLOAT32
+}
@@ -0,0 +1,206 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    test_scan_int.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   字符串到整数、量化值和定点数的转换
+ * @version 1.0
+ * @date    2023-08-20
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "mtfmt.h"
+#include "test_helper.h"
+#include "test_main.h"
+#include "unity.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief 字符串的开始和结束
+ *
+ */
+#define SLICE(s) (s), (s) + strlen(s)
+
+void scan_int_dec(void)
+{
+    int32_t i32 = 0;
+    uint32_t u32 = 0;
+    int64_t i64 = 0;
+    uint64_t u64 = 0;
+    const MStrFmtIntIndex dec = MStrFmtIntIndex_Dec;
+    EVAL(mstr_parse_i32(&i32, SLICE("0"), dec, NULL));
+    ASSERT_EQUAL_VALUE(i32, 0);
+    EVAL(mstr_parse_i32(&i32, SLICE("+1234"), dec, NULL));
+    ASSERT_EQUAL_VALUE(i32, 1234);
+    EVAL(mstr_parse_i32(&i32, SLICE("-2147483648"), dec, NULL));
+    ASSERT_EQUAL_VALUE(i32, INT32_MIN);
+    EVAL(mstr_parse_i32(&i32, SLICE("2147483647"), dec, NULL));
+    ASSERT_EQUAL_VALUE(i32, INT32_MAX);
+    EVAL(mstr_parse_u32(&u32, SLICE("4294967295"), dec, NULL));
+    ASSERT_EQUAL_VALUE(u32, UINT32_MAX);
+    EVAL(mstr_parse_u32(&u32, SLICE("0000000000000042"), dec, NULL));
+    ASSERT_EQUAL_VALUE(u32, 42);
+    EVAL(mstr_parse_i64(
+        &i64, SLICE("-9223372036854775808"), dec, NULL
+    ));
+    ASSERT_EQUAL_VALUE(i64, INT64_MIN);
+    EVAL(mstr_parse_i64(&i64, SLICE("1234567890123"), dec, NULL));
+    ASSERT_EQUAL_VALUE(i64, 1234567890123ll);
+    EVAL(mstr_parse_u64(
+        &u64, SLICE("18446744073709551615"), dec, NULL
+    ));
+    ASSERT_EQUAL_VALUE(u64, UINT64_MAX);
+}
+
+void scan_int_base(void)
+{
+    int32_t i32 = 0;
+    uint32_t u32 = 0;
+    uint64_t u64 = 0;
+    const char* stop = NULL;
+    const char* str = "1f, 2";
+    EVAL(mstr_parse_u32(
+        &u32, SLICE("10100101"), MStrFmtIntIndex_Bin, NULL
+    ));
+    ASSERT_EQUAL_VALUE(u32, 165);
+    EVAL(mstr_parse_u32(&u32, SLICE("245"), MStrFmtIntIndex_Oct, NULL));
+    ASSERT_EQUAL_VALUE(u32, 165);
+    EVAL(mstr_parse_i32(&i32, SLICE("-A5"), MStrFmtIntIndex_Hex, NULL));
+    ASSERT_EQUAL_VALUE(i32, -165);
+    EVAL(mstr_parse_u32(
+        &u32, SLICE("0XdeadBEEF"), MStrFmtIntIndex_Hex_WithPrefix, NULL
+    ));
+    ASSERT_EQUAL_VALUE(u32, 0xdeadbeef);
+    EVAL(mstr_parse_u64(
+        &u64, SLICE("ffffffffffffffff"), MStrFmtIntIndex_Hex, NULL
+    ));
+    ASSERT_EQUAL_VALUE(u64, UINT64_MAX);
+    // 转换最长的有效前缀
+    EVAL(mstr_parse_u32(&u32, SLICE(str), MStrFmtIntIndex_Hex, &stop));
+    ASSERT_EQUAL_VALUE(u32, 0x1f);
+    ASSERT_EQUAL_VALUE(stop, str + 2);
+}
+
+void scan_int_err(void)
+{
+    uint32_t u32 = 7;
+    int32_t i32 = 7;
+    uint64_t u64 = 7;
+    const char* stop = NULL;
+    const MStrFmtIntIndex dec = MStrFmtIntIndex_Dec;
+    mstr_result_t res;
+    res = mstr_parse_u32(&u32, SLICE(""), dec, NULL);
+    TEST_ASSERT_TRUE(res == MStr_Err_InvalidNumber);
+    res = mstr_parse_u32(&u32, SLICE("+"), dec, &stop);
+    TEST_ASSERT_TRUE(res == MStr_Err_InvalidNumber);
+    res = mstr_parse_u32(&u32, SLICE("-1"), dec, NULL);
+    TEST_ASSERT_TRUE(res == MStr_Err_InvalidNumber);
+    res = mstr_parse_u32(&u32, SLICE("12 "), dec, NULL);
+    TEST_ASSERT_TRUE(res == MStr_Err_InvalidNumber);
+    res = mstr_parse_u32(
+        &u32, SLICE("a5"), MStrFmtIntIndex_Hex_WithPrefix, NULL
+    );
+    TEST_ASSERT_TRUE(res == MStr_Err_InvalidNumber);
+    res = mstr_parse_u32(&u32, SLICE("4294967296"), dec, NULL);
+    TEST_ASSERT_TRUE(res == MStr_Err_NumberOutOfRange);
+    res = mstr_parse_i32(&i32, SLICE("2147483648"), dec, NULL);
+    TEST_ASSERT_TRUE(res == MStr_Err_NumberOutOfRange);
+    res = mstr_parse_i32(&i32, SLICE("-2147483649"), dec, NULL);
+    TEST_ASSERT_TRUE(res == MStr_Err_NumberOutOfRange);
+    res = mstr_parse_u64(
+        &u64, SLICE("18446744073709551616"), dec, NULL
+    );
+    TEST_ASSERT_TRUE(res == MStr_Err_NumberOutOfRange);
+    res = mstr_parse_u64(
+        &u64, SLICE("100000000000000000000000"), dec, NULL
+    );
+    TEST_ASSERT_TRUE(res == MStr_Err_NumberOutOfRange);
+    res = mstr_parse_u64(
+        &u64, SLICE("10000000000000000"), MStrFmtIntIndex_Hex, NULL
+    );
+    TEST_ASSERT_TRUE(res == MStr_Err_NumberOutOfRange);
+    // 失败时不修改输出
+    ASSERT_EQUAL_VALUE(u32, 7);
+    ASSERT_EQUAL_VALUE(i32, 7);
+    ASSERT_EQUAL_VALUE(u64, 7);
+    ASSERT_EQUAL_VALUE(stop, NULL);
+}
+
+void scan_fixed(void)
+{
+    int32_t i32 = 0;
+    uint32_t u32 = 0;
+    int64_t i64 = 0;
+    uint64_t u64 = 0;
+    mstr_result_t res;
+    EVAL(mstr_parse_iq(&i32, SLICE("0.5"), 15, NULL));
+    ASSERT_EQUAL_VALUE(i32, 16384);
+    EVAL(mstr_parse_iq(&i32, SLICE("-1.25"), 8, NULL));
+    ASSERT_EQUAL_VALUE(i32, -320);
+    EVAL(mstr_parse_iq(&i32, SLICE(".1"), 15, NULL));
+    ASSERT_EQUAL_VALUE(i32, 3277);
+    EVAL(mstr_parse_iq(&i32, SLICE("-1."), 31, NULL));
+    ASSERT_EQUAL_VALUE(i32, INT32_MIN);
+    // 四舍六入五成双
+    EVAL(mstr_parse_uq(&u32, SLICE("0.25"), 1, NULL));
+    ASSERT_EQUAL_VALUE(u32, 0);
+    EVAL(mstr_parse_uq(&u32, SLICE("0.75"), 1, NULL));
+    ASSERT_EQUAL_VALUE(u32, 2);
+    EVAL(mstr_parse_uq(
+        &u32, SLICE("0.2500000000000000000001"), 1, NULL
+    ));
+    ASSERT_EQUAL_VALUE(u32, 1);
+    EVAL(mstr_parse_ifix(&i32, SLICE("-2.5"), 12, 4, NULL));
+    ASSERT_EQUAL_VALUE(i32, -40);
+    EVAL(mstr_parse_ufix(&u32, SLICE("65535.99998"), 16, 16, NULL));
+    ASSERT_EQUAL_VALUE(u32, UINT32_MAX);
+    EVAL(mstr_parse_iq64(
+        &i64,
+        SLICE("-0.9999999999999999998915797827514495565"),
+        63,
+        NULL
+    ));
+    ASSERT_EQUAL_VALUE(i64, -INT64_MAX);
+    EVAL(mstr_parse_uq64(&u64, SLICE("1.5"), 62, NULL));
+    ASSERT_EQUAL_VALUE(u64, (uint64_t)3 << 61);
+    // 错误
+    res = mstr_parse_iq(&i32, SLICE("1.0"), 31, NULL);
+    TEST_ASSERT_TRUE(res == MStr_Err_NumberOutOfRange);
+    res = mstr_parse_iq(&i32, SLICE("0.99999999999"), 31, NULL);
+    TEST_ASSERT_TRUE(res == MStr_Err_NumberOutOfRange);
+    res = mstr_parse_ifix(&i32, SLICE("2048"), 12, 4, NULL);
+    TEST_ASSERT_TRUE(res == MStr_Err_NumberOutOfRange);
+    res = mstr_parse_uq(&u32, SLICE("-0.5"), 15, NULL);
+    TEST_ASSERT_TRUE(res == MStr_Err_InvalidNumber);
+    res = mstr_parse_uq(&u32, SLICE("."), 15, NULL);
+    TEST_ASSERT_TRUE(res == MStr_Err_InvalidNumber);
+    res = mstr_parse_uq(&u32, SLICE("0.5"), 32, NULL);
+    TEST_ASSERT_TRUE(res == MStr_Err_UnsupportQuantBits);
+}
+
+void scan_fixed_roundtrip(void)
+{
+    static const int32_t values[] = {
+        0, 1, -1, 12345, -12345, 0x7fffffff, (int32_t)0x80000000,
+    };
+    usize_t i;
+    uint32_t quat;
+    for (quat = 1; quat <= 31; quat += 5) {
+        for (i = 0; i < sizeof(values) / sizeof(values[0]); i += 1) {
+            MString s;
+            int32_t val = 0;
+            EVAL(mstr_create_empty(&s));
+            EVAL(mstr_fmt_iqtoa(
+                &s, values[i], quat, MStrFmtSignDisplay_NegOnly
+            ));
+            EVAL(mstr_parse_iq(
+                &val, s.buff, s.buff + s.count, quat, NULL
+            ));
+            ASSERT_EQUAL_VALUE(val, values[i]);
+            mstr_free(&s);
+        }
+    }
+}
@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    test_sort.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   字符串数组的排序
+ * @version 1.0
+ * @date    2023-09-02
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "mtfmt.h"
+#include "test_helper.h"
+#include "test_main.h"
+#include "unity.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief 用于测试的线程池, 直接在当前线程执行
+ *
+ */
+typedef struct tagTestSortPool
+{
+    usize_t submit_count;
+    usize_t wait_count;
+    mstr_bool_t accept;
+} TestSortPool;
+
+static mstr_bool_t
+    test_pool_submit(void* ctx, MStrSortTask task, void* arg);
+static void test_pool_wait(void* ctx);
+static void test_sort_keys(MStringView* views, char* data, usize_t cnt);
+static void test_assert_sorted(const MStringView* views, usize_t cnt);
+
+void sort_string(void)
+{
+    static const char* input[] = {
+        "b", "", "ab", "a", "abc", "é", "z", "ab", "B", "a",
+    };
+    static const char* expect[] = {
+        "", "B", "a", "a", "ab", "ab", "abc", "b", "z", "é",
+    };
+    MString arr[10];
+    usize_t i;
+    for (i = 0; i < 10; i += 1) {
+        EVAL(mstr_create(&arr[i], input[i]));
+    }
+    EVAL(mstr_sort(arr, 10, NULL));
+    for (i = 0; i < 10; i += 1) {
+        TEST_ASSERT_TRUE(strcmp(mstr_c_str(&arr[i]), expect[i]) == 0);
+    }
+    for (i = 0; i < 10; i += 1) {
+        mstr_free(&arr[i]);
+    }
+}
+
+void sort_view(void)
+{
+    static char data[40 * 12];
+    MStringView views[40];
+    MStringView nul[3];
+    usize_t i;
+    test_sort_keys(views, data, 40);
+    EVAL(mstr_sort_view(views, 40, NULL));
+    test_assert_sorted(views, 40);
+    // 含有'\0'时按长度区分
+    nul[0].buff = "a\0\0";
+    nul[0].count = 3;
+    nul[1].buff = "a\0";
+    nul[1].count = 2;
+    nul[2].buff = "a";
+    nul[2].count = 1;
+    for (i = 0; i < 3; i += 1) {
+        nul[i].length = nul[i].count;
+    }
+    EVAL(mstr_sort_view(nul, 3, NULL));
+    ASSERT_EQUAL_VALUE(nul[0].count, 1);
+    ASSERT_EQUAL_VALUE(nul[1].count, 2);
+    ASSERT_EQUAL_VALUE(nul[2].count, 3);
+}
+
+void sort_parallel(void)
+{
+    static char data[40 * 12];
+    MStringView views[40];
+    TestSortPool ctx;
+    MStrSortPool pool;
+    pool.capture = &ctx;
+    pool.submit = test_pool_submit;
+    pool.wait = test_pool_wait;
+    pool.threshold = 0;
+    pool.task_size = 2;
+    // 提交成功
+    ctx.submit_count = 0;
+    ctx.wait_count = 0;
+    ctx.accept = True;
+    test_sort_keys(views, data, 40);
+    EVAL(mstr_sort_view(views, 40, &pool));
+    test_assert_sorted(views, 40);
+    TEST_ASSERT_TRUE(ctx.submit_count > 0);
+    ASSERT_EQUAL_VALUE(ctx.wait_count, 1);
+    // 拒绝提交时在当前线程执行
+    ctx.submit_count = 0;
+    ctx.wait_count = 0;
+    ctx.accept = False;
+    test_sort_keys(views, data, 40);
+    EVAL(mstr_sort_view(views, 40, &pool));
+    test_assert_sorted(views, 40);
+    ASSERT_EQUAL_VALUE(ctx.wait_count, 1);
+    // 数目没有超过threshold时不使用线程池
+    ctx.wait_count = 0;
+    pool.threshold = 40;
+    test_sort_keys(views, data, 40);
+    EVAL(mstr_sort_view(views, 40, &pool));
+    test_assert_sorted(views, 40);
+    ASSERT_EQUAL_VALUE(ctx.wait_count, 0);
+}
+
+/**
+ * @brief 生成乱序的key, 有相同的前缀和重复的内容
+ *
+ */
+static void test_sort_keys(MStringView* views, char* data, usize_t cnt)
+{
+    usize_t i;
+    for (i = 0; i < cnt; i += 1) {
+        char* p = data + i * 12;
+        unsigned int v = (unsigned int)((i * 7) % cnt) / 2;
+        const char* prefix = i % 3 == 0 ? "log/" : "log/app/";
+        sprintf(p, "%s%02u", prefix, v);
+        mstr_view_from_cstr(&views[i], p, NULL);
+    }
+}
+
+/**
+ * @brief 检查是否有序
+ *
+ */
+static void test_assert_sorted(const MStringView* views, usize_t cnt)
+{
+    usize_t i;
+    for (i = 0; i + 1 < cnt; i += 1) {
+        TEST_ASSERT_TRUE(
+            mstr_compare_view(&views[i], &views[i + 1]) <= 0
+        );
+    }
+}
+
+static mstr_bool_t
+    test_pool_submit(void* ctx, MStrSortTask task, void* arg)
+{
+    TestSortPool* pool = (TestSortPool*)ctx;
+    if (!pool->accept) {
+        return False;
+    }
+    pool->submit_count += 1;
+    task(arg);
+    return True;
+}
+
+static void test_pool_wait(void* ctx)
+{
+    TestSortPool* pool = (TestSortPool*)ctx;
+    pool->wait_count += 1;
+}
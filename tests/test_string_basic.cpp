@@ -27,6 +27,29 @@ extern "C" void string_copy_create(void)
 
 extern "C" void string_move_create(void)
 {
+    usize_t alloc_beg, alloc_end, free_cnt;
+    // 堆上的内容, 移动不会分配内存
+    mtfmt::string heap_str = u8"The quick brown fox jumps over";
+    const char* heap_buff = heap_str.view().data();
+    mstr_heap_get_allocate_count(&alloc_beg, &free_cnt);
+    mtfmt::string moved = std::move(heap_str);
+    mstr_heap_get_allocate_count(&alloc_end, &free_cnt);
+    ASSERT_EQUAL_VALUE(alloc_beg, alloc_end);
+    ASSERT_EQUAL_VALUE(moved.view().data(), heap_buff);
+    ASSERT_EQUAL_VALUE(moved, u8"The quick brown fox jumps over");
+    // 移动之后是可以继续使用的空字符串
+    ASSERT_EQUAL_VALUE(heap_str.length(), 0);
+    heap_str += u8"reuse";
+    ASSERT_EQUAL_VALUE(heap_str, u8"reuse");
+    // stack_region上的内容
+    mtfmt::string stack_str = u8"MtF";
+    mtfmt::string stack_moved(std::move(stack_str));
+    ASSERT_EQUAL_VALUE(stack_moved, u8"MtF");
+    ASSERT_EQUAL_VALUE(stack_str.length(), 0);
+    // 移动赋值
+    stack_moved = std::move(moved);
+    ASSERT_EQUAL_VALUE(stack_moved.view().data(), heap_buff);
+    ASSERT_EQUAL_VALUE(moved.byte_count(), 0);
 }
 
 extern "C" void string_length(void)
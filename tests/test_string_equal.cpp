@@ -2,7 +2,7 @@
 /**
  * @file    test_string_equal.cpp
  * @author  向阳 (hinata.hoshino@foxmail.com)
- * @brief   字符串相等, 包括equal, start_with, end_with
+ * @brief   字符串相等, 包括equal, compare, start_with, end_with
  * @version 1.0
  * @date    2023-06-23
  *
@@ -63,3 +63,40 @@ extern "C" void string_start_with(void)
     ASSERT_EQUAL_VALUE(src.start_with("xample"), False);
     ASSERT_EQUAL_VALUE(src.start_with("Example!"), False);
 }
+
+extern "C" void string_compare(void)
+{
+    mtfmt::string str1 = "String1";
+    mtfmt::string str2 = "String2";
+    mtfmt::string str3 = "String";
+    mtfmt::string str4 = u8"Stringé";
+    mtfmt::string str5 = "Stringz";
+    mtfmt::string long1 = "0123456789abcdef0123456789abcdefX";
+    mtfmt::string long2 = "0123456789abcdef0123456789abcdefY";
+    // @mstr_compare
+    TEST_ASSERT_TRUE(str1 < str2);
+    TEST_ASSERT_TRUE(str2 > str1);
+    TEST_ASSERT_TRUE(str1 <= str1);
+    TEST_ASSERT_TRUE(str1 >= str1);
+    TEST_ASSERT_TRUE(str1.compare(str1) == 0);
+    // 前缀较小
+    TEST_ASSERT_TRUE(str3 < str1);
+    TEST_ASSERT_TRUE(str1 > str3);
+    // 按无符号字节比较
+    TEST_ASSERT_TRUE(str5 < str4);
+    // 跨过向量化的部分
+    TEST_ASSERT_TRUE(long1 < long2);
+    TEST_ASSERT_TRUE(long2 > long1);
+    TEST_ASSERT_FALSE(long1 == long2);
+    // @mstr_compare_view
+    TEST_ASSERT_TRUE(str1.view() < str2.view());
+    TEST_ASSERT_TRUE(str3.view() <= str1.view());
+    TEST_ASSERT_TRUE(long1.view().compare(long1.view()) == 0);
+    // @mstr_equal_constant_time
+    MString raw;
+    TEST_ASSERT_TRUE(MSTR_SUCC(mstr_create(&raw, "String1")));
+    TEST_ASSERT_TRUE(mstr_equal_constant_time(&raw, "String1", 7));
+    TEST_ASSERT_FALSE(mstr_equal_constant_time(&raw, "String2", 7));
+    TEST_ASSERT_FALSE(mstr_equal_constant_time(&raw, "String", 6));
+    mstr_free(&raw);
+}
@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    test_string_shared.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   复制的字符串共享内存区
+ * @version 1.0
+ * @date    2023-08-29
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "mtfmt.h"
+#include "test_helper.h"
+#include "test_main.h"
+#include "unity.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief 超过stack_region的内容
+ *
+ */
+#define HEAP_TEXT "The quick brown fox jumps over the lazy dog"
+
+/**
+ * @brief 复制的字符串是否共享内存区
+ *
+ */
+#if _MSTR_USE_SHARED_BUFFER
+#define SHARED_EXPECTED True
+#else
+#define SHARED_EXPECTED False
+#endif // _MSTR_USE_SHARED_BUFFER
+
+/**
+ * @brief 确定两个字符串按照配置共享(或者不共享)内存
+ *
+ */
+#define ASSERT_SHARED(a, b) \
+    ASSERT_EQUAL_VALUE((a)->buff == (b)->buff, SHARED_EXPECTED)
+
+/**
+ * @brief 确定两个字符串不共享内存
+ *
+ */
+#define ASSERT_NOT_SHARED(a, b) \
+    ASSERT_NOTEQUAL_VALUE((a)->buff, (b)->buff)
+
+void string_shared_copy(void)
+{
+    MString a, b, c, s1, s2;
+    EVAL(mstr_create(&a, HEAP_TEXT));
+    mstr_init(&b);
+    mstr_init(&c);
+    EVAL(mstr_copy_from(&b, &a));
+    EVAL(mstr_copy_from(&c, &b));
+    ASSERT_SHARED(&a, &b);
+    ASSERT_SHARED(&b, &c);
+    ASSERT_EQUAL_STRING(&c, HEAP_TEXT);
+    ASSERT_EQUAL_VALUE(c.length, a.length);
+    TEST_ASSERT_TRUE(strcmp(mstr_c_str(&c), HEAP_TEXT) == 0);
+    // 释放其中一个不影响其它的
+    mstr_free(&a);
+    ASSERT_EQUAL_STRING(&b, HEAP_TEXT);
+    // 清空共享的字符串
+    mstr_clear(&b);
+    ASSERT_EQUAL_VALUE(b.count, 0);
+    ASSERT_EQUAL_STRING(&c, HEAP_TEXT);
+    EVAL(mstr_concat_cstr(&b, "short"));
+    ASSERT_EQUAL_STRING(&c, HEAP_TEXT);
+    // stack_region上的内容直接复制
+    EVAL(mstr_create(&s1, "stack"));
+    mstr_init(&s2);
+    EVAL(mstr_copy_from(&s2, &s1));
+    ASSERT_NOT_SHARED(&s1, &s2);
+    TEST_ASSERT_TRUE(s2.buff == s2.stack_region);
+    ASSERT_EQUAL_STRING(&s2, "stack");
+    // 复制自己
+    EVAL(mstr_copy_from(&c, &c));
+    ASSERT_EQUAL_STRING(&c, HEAP_TEXT);
+    mstr_free(&b);
+    mstr_free(&c);
+    mstr_free(&s1);
+    mstr_free(&s2);
+}
+
+void string_shared_detach(void)
+{
+    MString a, b;
+    mstr_codepoint_t ch;
+    EVAL(mstr_create(&a, HEAP_TEXT));
+    mstr_init(&b);
+    // append
+    EVAL(mstr_copy_from(&b, &a));
+    EVAL(mstr_append(&b, '!'));
+    ASSERT_NOT_SHARED(&a, &b);
+    ASSERT_EQUAL_STRING(&a, HEAP_TEXT);
+    ASSERT_EQUAL_STRING(&b, HEAP_TEXT "!");
+    // insert
+    EVAL(mstr_copy_from(&b, &a));
+    EVAL(mstr_insert(&b, 0, '>'));
+    ASSERT_EQUAL_STRING(&a, HEAP_TEXT);
+    ASSERT_EQUAL_STRING(&b, ">" HEAP_TEXT);
+    // remove
+    EVAL(mstr_copy_from(&b, &a));
+    EVAL(mstr_remove(&b, &ch, 0));
+    ASSERT_EQUAL_VALUE(ch, 'T');
+    ASSERT_EQUAL_STRING(&a, HEAP_TEXT);
+    ASSERT_EQUAL_STRING(&b, HEAP_TEXT + 1);
+    // retain
+    EVAL(mstr_copy_from(&b, &a));
+    EVAL(mstr_retain(&b, MStringReplaceOption_StartWith, "The ", 4));
+    ASSERT_EQUAL_STRING(&a, HEAP_TEXT);
+    EVAL(mstr_copy_from(&b, &a));
+    EVAL(mstr_retain(&b, MStringReplaceOption_EndWith, " dog", 4));
+    ASSERT_EQUAL_STRING(&a, HEAP_TEXT);
+    TEST_ASSERT_TRUE(strcmp(mstr_c_str(&a), HEAP_TEXT) == 0);
+    // reverse
+    EVAL(mstr_copy_from(&b, &a));
+    mstr_reverse_self(&b);
+    ASSERT_EQUAL_STRING(&a, HEAP_TEXT);
+    ASSERT_EQUAL_VALUE(b.buff[0], 'g');
+    // format
+    EVAL(mstr_copy_from(&b, &a));
+    EVAL(mstr_format(&b, "{0:i32}", 1, (int32_t)42));
+    ASSERT_EQUAL_STRING(&a, HEAP_TEXT);
+    ASSERT_EQUAL_STRING(&b, HEAP_TEXT "42");
+    // 修改原来的字符串
+    EVAL(mstr_copy_from(&b, &a));
+    EVAL(mstr_concat_cstr(&a, "."));
+    ASSERT_EQUAL_STRING(&a, HEAP_TEXT ".");
+    ASSERT_EQUAL_STRING(&b, HEAP_TEXT);
+    EVAL(mstr_detach(&b));
+    ASSERT_EQUAL_STRING(&b, HEAP_TEXT);
+    mstr_free(&a);
+    mstr_free(&b);
+}
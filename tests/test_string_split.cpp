@@ -0,0 +1,131 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    test_string_split.cpp
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   字符串分割
+ * @version 1.0
+ * @date    2023-08-27
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "mtfmt.hpp"
+#include "test_helper.h"
+#include "test_main.h"
+#include "unity.h"
+#include <stdio.h>
+
+/**
+ * @brief 判断字段的内容
+ *
+ */
+#define ASSERT_FIELD(f, s)                                   \
+    do {                                                     \
+        ASSERT_EQUAL_VALUE((f).count, strlen(s));            \
+        TEST_ASSERT_TRUE(memcmp((f).buff, (s), (f).count) == 0); \
+    } while (0)
+
+extern "C" void string_split_chars(void)
+{
+    static const char* text = "t=21.5,h=40,,ok,"
+                              "0123456789abcdef0123456789abcdef,x";
+    MStringView view, field;
+    MStringSplit sp;
+    usize_t cnt = 0;
+    EVAL(mstr_view_from_cstr(&view, text, NULL));
+    EVAL(mstr_split_by_chars(&sp, &view, ",", 1));
+    TEST_ASSERT_TRUE(mstr_split_next(&sp, &field));
+    ASSERT_FIELD(field, "t=21.5");
+    TEST_ASSERT_TRUE(mstr_split_next(&sp, &field));
+    ASSERT_FIELD(field, "h=40");
+    TEST_ASSERT_TRUE(mstr_split_next(&sp, &field));
+    ASSERT_FIELD(field, "");
+    TEST_ASSERT_TRUE(mstr_split_next(&sp, &field));
+    ASSERT_FIELD(field, "ok");
+    TEST_ASSERT_TRUE(mstr_split_next(&sp, &field));
+    ASSERT_EQUAL_VALUE(field.length, 32);
+    TEST_ASSERT_TRUE(mstr_split_next(&sp, &field));
+    ASSERT_FIELD(field, "x");
+    TEST_ASSERT_TRUE(!mstr_split_next(&sp, &field));
+    // 多个分隔字符, 超过一组的字节
+    EVAL(mstr_split_by_chars(&sp, &view, "=,", 2));
+    while (mstr_split_next(&sp, &field)) {
+        cnt += 1;
+    }
+    ASSERT_EQUAL_VALUE(cnt, 8);
+    EVAL(mstr_split_by_chars(&sp, &view, "f.=;:", 5));
+    TEST_ASSERT_TRUE(mstr_split_next(&sp, &field));
+    ASSERT_FIELD(field, "t");
+    TEST_ASSERT_TRUE(mstr_split_next(&sp, &field));
+    ASSERT_FIELD(field, "21");
+    TEST_ASSERT_TRUE(mstr_split_next(&sp, &field));
+    ASSERT_FIELD(field, "5,h");
+    TEST_ASSERT_TRUE(mstr_split_next(&sp, &field));
+    ASSERT_FIELD(field, "40,,ok,0123456789abcde");
+    // 没有分隔字符
+    EVAL(mstr_split_by_chars(&sp, &view, "", 0));
+    TEST_ASSERT_TRUE(mstr_split_next(&sp, &field));
+    ASSERT_EQUAL_VALUE(field.count, view.count);
+    TEST_ASSERT_TRUE(!mstr_split_next(&sp, &field));
+    // 空字符串有一个空的字段
+    EVAL(mstr_view_from_cstr(&view, "", NULL));
+    EVAL(mstr_split_by_chars(&sp, &view, ",", 1));
+    TEST_ASSERT_TRUE(mstr_split_next(&sp, &field));
+    ASSERT_EQUAL_VALUE(field.count, 0);
+    TEST_ASSERT_TRUE(!mstr_split_next(&sp, &field));
+}
+
+extern "C" void string_split_str(void)
+{
+    MStringView view, sep, field;
+    MStringSplit sp;
+    EVAL(mstr_view_from_cstr(&view, "a::b:c::", NULL));
+    EVAL(mstr_view_from_cstr(&sep, "::", NULL));
+    mstr_split_by_str(&sp, &view, &sep);
+    TEST_ASSERT_TRUE(mstr_split_next(&sp, &field));
+    ASSERT_FIELD(field, "a");
+    TEST_ASSERT_TRUE(mstr_split_next(&sp, &field));
+    ASSERT_FIELD(field, "b:c");
+    TEST_ASSERT_TRUE(mstr_split_next(&sp, &field));
+    ASSERT_FIELD(field, "");
+    TEST_ASSERT_TRUE(!mstr_split_next(&sp, &field));
+#if _MSTR_USE_UTF_8
+    EVAL(mstr_view_from_cstr(&view, u8"汉字、😊、ab", NULL));
+    EVAL(mstr_view_from_cstr(&sep, u8"、", NULL));
+    mstr_split_by_str(&sp, &view, &sep);
+    TEST_ASSERT_TRUE(mstr_split_next(&sp, &field));
+    ASSERT_EQUAL_VALUE(field.length, 2);
+    TEST_ASSERT_TRUE(mstr_split_next(&sp, &field));
+    ASSERT_FIELD(field, u8"😊");
+    ASSERT_EQUAL_VALUE(field.length, 1);
+    TEST_ASSERT_TRUE(mstr_split_next(&sp, &field));
+    ASSERT_EQUAL_VALUE(field.length, 2);
+    ASSERT_EQUAL_VALUE(sp.rem_length, 0);
+    // 多字节字符不能作为分隔字符
+    TEST_ASSERT_TRUE(
+        mstr_split_by_chars(&sp, &view, u8"、", 3) ==
+        MStr_Err_UnicodeEncodingError
+    );
+#endif // _MSTR_USE_UTF_8
+}
+
+extern "C" void string_split_cpp(void)
+{
+    mtfmt::string str = u8"1;22;;333";
+    usize_t total = 0, cnt = 0;
+    auto fields = str.view().split_any(";");
+    TEST_ASSERT_TRUE(fields.is_succ());
+    for (mtfmt::string_view f : fields.or_value({})) {
+        total += f.length();
+        cnt += 1;
+    }
+    ASSERT_EQUAL_VALUE(total, 6);
+    ASSERT_EQUAL_VALUE(cnt, 4);
+    cnt = 0;
+    for (mtfmt::string_view f : str.view().split_by(";;")) {
+        TEST_ASSERT_TRUE(cnt != 0 || f == "1;22");
+        TEST_ASSERT_TRUE(cnt != 1 || f == "333");
+        cnt += 1;
+    }
+    ASSERT_EQUAL_VALUE(cnt, 2);
+}
@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    test_string_view.cpp
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   字符串视图
+ * @version 1.0
+ * @date    2023-08-26
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ */
+#include "mtfmt.hpp"
+#include "test_helper.h"
+#include "test_main.h"
+#include "unity.h"
+#include <stdio.h>
+
+extern "C" void string_view_basic(void)
+{
+    MString str, out;
+    MStringView view, sub, sep, head;
+    MStringMatchResult res;
+    EVAL(mstr_create(&str, "key=value;next"));
+    mstr_view_of(&view, &str);
+    ASSERT_EQUAL_VALUE(view.count, 14);
+    // 切片
+    EVAL(mstr_view_slice(&sub, &view, 4, 9));
+    ASSERT_EQUAL_VALUE(sub.length, 5);
+    TEST_ASSERT_TRUE(memcmp(sub.buff, "value", 5) == 0);
+    TEST_ASSERT_TRUE(
+        mstr_view_slice(&sub, &view, 4, 15) == MStr_Err_IndexOutOfBound
+    );
+    // 查找, 结果相对于视图的开始
+    EVAL(mstr_view_from_cstr(&sep, ";", NULL));
+    EVAL(mstr_view_find(&view, &res, 2, &sep));
+    TEST_ASSERT_TRUE(res.is_matched);
+    ASSERT_EQUAL_VALUE(res.begin_pos, 9);
+    ASSERT_EQUAL_VALUE(res.begin_offset, 9);
+    // 分割, rest可以和view相同
+    EVAL(mstr_view_from_cstr(&sep, "=", NULL));
+    TEST_ASSERT_TRUE(mstr_view_split(&head, &view, &view, &sep));
+    TEST_ASSERT_TRUE(memcmp(head.buff, "key", head.count) == 0);
+    ASSERT_EQUAL_VALUE(view.length, 10);
+    TEST_ASSERT_TRUE(mstr_view_start_with(&view, &sub));
+    TEST_ASSERT_TRUE(!mstr_view_split(&head, &sub, &sub, &sep));
+    ASSERT_EQUAL_VALUE(head.count, 5);
+    ASSERT_EQUAL_VALUE(sub.count, 0);
+    // 拼接, head引用的是str, 所以拼接到另一个字符串
+    EVAL(mstr_create(&out, "v="));
+    EVAL(mstr_concat_view(&out, &head));
+    ASSERT_EQUAL_STRING(&out, "v=value");
+    mstr_free(&out);
+    mstr_free(&str);
+#if _MSTR_USE_UTF_8
+    EVAL(mstr_view_from_cstr(&view, u8"汉字😊ab", NULL));
+    ASSERT_EQUAL_VALUE(view.length, 5);
+    ASSERT_EQUAL_VALUE(view.count, 12);
+    EVAL(mstr_view_slice(&sub, &view, 1, 3));
+    ASSERT_EQUAL_VALUE(sub.count, 7);
+    EVAL(mstr_view_from_cstr(&sep, "a", NULL));
+    EVAL(mstr_view_find(&view, &res, 1, &sep));
+    ASSERT_EQUAL_VALUE(res.begin_pos, 3);
+    ASSERT_EQUAL_VALUE(res.begin_offset, 10);
+    EVAL(mstr_view_slice_bytes(&sub, &view, 3, 10));
+    ASSERT_EQUAL_VALUE(sub.length, 2);
+    TEST_ASSERT_TRUE(
+        mstr_view_slice_bytes(&sub, &view, 1, 10) ==
+        MStr_Err_UnicodeEncodingError
+    );
+    // 最后一个字符不完整
+    TEST_ASSERT_TRUE(
+        mstr_view_from_cstr(&sub, view.buff, view.buff + 5) ==
+        MStr_Err_EncodingNotCompleted
+    );
+#endif // _MSTR_USE_UTF_8
+}
+
+extern "C" void string_view_cpp(void)
+{
+    mtfmt::string str = u8"path/to/file.txt";
+    mtfmt::string_view view = str.view();
+    ASSERT_EQUAL_VALUE(view.length(), 16);
+    TEST_ASSERT_TRUE(view.start_with("path/"));
+    TEST_ASSERT_TRUE(view.end_with(".txt"));
+    ASSERT_EQUAL_VALUE(view.find("/").or_value(-2), 4);
+    ASSERT_EQUAL_VALUE(view.find("/", 5).or_value(-2), 7);
+    ASSERT_EQUAL_VALUE(view.find("\\").or_value(-2), -1);
+    auto parts = view.split("/").or_value({});
+    TEST_ASSERT_TRUE(parts.first == "path");
+    TEST_ASSERT_TRUE(parts.second == "to/file.txt");
+    TEST_ASSERT_TRUE(view.split("?").is_err());
+    // 切片和拼接
+    mtfmt::string name(view.slice(8, 12).or_value({}));
+    name += mtfmt::string_view(".md");
+    TEST_ASSERT_TRUE(name == u8"file.md");
+    // 迭代器
+    usize_t cnt = 0;
+    for (mtfmt::unicode_t ch : mtfmt::string_view("a/b")) {
+        cnt += ch == '/' ? 1 : 0;
+    }
+    ASSERT_EQUAL_VALUE(cnt, 1);
+    TEST_ASSERT_TRUE(*mtfmt::string_view("xyz").rbegin() == 'z');
+}
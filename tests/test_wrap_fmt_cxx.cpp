@@ -26,4 +26,146 @@ extern "C" void cpp_wrap_fmt(void)
 
 extern "C" void cpp_wrap_fmt_parser(void)
 {
+#if _MSTR_USE_CONSTEXPR_PARSER
+    using mtfmt::details::compiled_format_size_of;
+    // 转义字符作为字面量, 和前面的字面量合并为一段
+    static_assert(
+        compiled_format_size_of("a{0:i32}b{{c").segment_cnt == 4,
+        "segment count"
+    );
+    static_assert(
+        compiled_format_size_of("{0:t:%g}{[1:u8]}").field_cnt == 2,
+        "field count"
+    );
+    static_assert(
+        compiled_format_size_of("{0:t:%g}{[1:u8]}").chrono_cnt == 1,
+        "chrono count"
+    );
+    const auto& fmt = MSTR_COMPILE_FORMAT("{[1:u16|:; :*=+8X]}");
+    const auto& field = fmt.fields[0];
+    TEST_ASSERT_TRUE(fmt.segments[0].is_field);
+    TEST_ASSERT_TRUE(field.arg_class == MStrFmtArgClass_Array);
+    TEST_ASSERT_TRUE(field.id == 1);
+    TEST_ASSERT_TRUE(field.typ == MStrFmtArgType_Uint16);
+    TEST_ASSERT_TRUE(field.split_end - field.split_beg == 2);
+    TEST_ASSERT_TRUE(field.fill_char == '*');
+    TEST_ASSERT_TRUE(field.fmt_align == MStrFmtAlign_Center);
+    TEST_ASSERT_TRUE(field.sign_display == MStrFmtSignDisplay_Always);
+    TEST_ASSERT_TRUE(field.width == 8);
+    TEST_ASSERT_TRUE(
+        field.fmt_type == MStrFmtFormatType_Hex_UpperCase_WithPrefix
+    );
+    const auto& fmt_b64 = MSTR_COMPILE_FORMAT("{[0:u8:b64]}{0:i32:b}");
+    TEST_ASSERT_TRUE(
+        fmt_b64.fields[0].fmt_type == MStrFmtFormatType_Base64
+    );
+    TEST_ASSERT_TRUE(
+        fmt_b64.fields[1].fmt_type == MStrFmtFormatType_Binary
+    );
+    const auto& fmt_fix = MSTR_COMPILE_FORMAT("{0:F12.4u:>8.2}");
+    const auto& fix_field = fmt_fix.fields[0];
+    TEST_ASSERT_TRUE(
+        fix_field.typ == MStrFmtArgType_FixedUnsignedValue
+    );
+    TEST_ASSERT_TRUE(fix_field.prop_a == 12 && fix_field.prop_b == 4);
+    TEST_ASSERT_TRUE(fix_field.width == 8);
+    TEST_ASSERT_TRUE(fix_field.precision == 2);
+#endif // _MSTR_USE_CONSTEXPR_PARSER
+}
+
+extern "C" void cpp_wrap_fmt_typed_args(void)
+{
+    const uint8_t arr[] = {1, 2, 3};
+    const char* name = "mtfmt";
+    mtfmt::string str =
+        mtfmt::string::format(
+            "{1:s}:{0:u8},{2:i16},{[3:u8]},{5:q8}",
+            static_cast<uint8_t>(255),
+            name,
+            static_cast<int16_t>(-2),
+            arr,
+            3u,
+            mtfmt::fixed_value(static_cast<int32_t>(0x180))
+        )
+            .or_value("error");
+    ASSERT_EQUAL_VALUE(str, "mtfmt:255,-2,1, 2, 3,1.5");
+    // 类型和标注不一致
+    auto err = mtfmt::string::format("{0:u8}", 255);
+    TEST_ASSERT_TRUE(err.is_err());
+    TEST_ASSERT_TRUE(
+        err.unsafe_get_err_value() == MStr_Err_InvaildArgumentType
+    );
+}
+
+#if _MSTR_USE_CONSTEXPR_PARSER
+#define ASSERT_COMPILED_FORMAT(expect, fmt, ...)                       \
+    do {                                                               \
+        mtfmt::string compiled =                                       \
+            mtfmt::string::format(MSTR_COMPILE_FORMAT(fmt), __VA_ARGS__) \
+                .or_value("error");                                    \
+        mtfmt::string runtime =                                        \
+            mtfmt::string::format(fmt, __VA_ARGS__).or_value("error"); \
+        ASSERT_EQUAL_VALUE(compiled, expect);                          \
+        ASSERT_EQUAL_VALUE(runtime, expect);                           \
+    } while (0)
+#endif // _MSTR_USE_CONSTEXPR_PARSER
+
+extern "C" void cpp_wrap_fmt_compiled(void)
+{
+#if _MSTR_USE_CONSTEXPR_PARSER
+    const uint8_t arr[] = {1, 2, 3};
+    const MStrTime tm = {0x2023, 0x05, 0x06, 0x16, 0x55, 0x19, 0x6, 0x1234};
+    const MStrTimestamp ts = {1683392119, 123456789};
+    ASSERT_COMPILED_FORMAT("{a}", "{{a}}", 0);
+    ASSERT_COMPILED_FORMAT("[  +12]", "[{0:i32:+5}]", 12);
+    ASSERT_COMPILED_FORMAT("*0XFF**", "{0:u32:*=7X}", 255u);
+    ASSERT_COMPILED_FORMAT("a=1|2|3.", "a={[0:u8|:|]}.", arr, 3u);
+    ASSERT_COMPILED_FORMAT("1,2,3", "{[0:u8|:,]}", arr, 3u);
+    ASSERT_COMPILED_FORMAT("mtfmt  |", "{0:s:<7}|", "mtfmt");
+    ASSERT_COMPILED_FORMAT("2023-05-06 16:55:19.1234", "{0:t:%g}", &tm);
+    ASSERT_COMPILED_FORMAT("16:55 6", "{0:t:%HH:%mm %w}", &tm);
+    ASSERT_COMPILED_FORMAT("2023-05-06 16:55:19.1234", "{0:T:%g}", &ts);
+    // 没有replacement field
+    mtfmt::string str =
+        mtfmt::string::format(MSTR_COMPILE_FORMAT("mtfmt")).or_value("");
+    ASSERT_EQUAL_VALUE(str, "mtfmt");
+    // 类型和标注不一致
+    auto err = mtfmt::string::format(MSTR_COMPILE_FORMAT("{0:u8}"), 255);
+    TEST_ASSERT_TRUE(err.is_err());
+    TEST_ASSERT_TRUE(
+        err.unsafe_get_err_value() == MStr_Err_InvaildArgumentType
+    );
+#endif // _MSTR_USE_CONSTEXPR_PARSER
+}
+
+extern "C" void cpp_wrap_fmt_reuse(void)
+{
+    usize_t alloc_beg, alloc_end, free_cnt;
+    mtfmt::string out;
+    auto res = mtfmt::string::format_to(out, "{0:s}={1:i32}", "key", 1);
+    TEST_ASSERT_TRUE(res.is_succ());
+    ASSERT_EQUAL_VALUE(out, "key=1");
+    res = out.format_append(",{0:u8:h}", static_cast<uint8_t>(0xa5));
+    TEST_ASSERT_TRUE(res.is_succ());
+    ASSERT_EQUAL_VALUE(out, "key=1,a5");
+    // 容量足够之后不会再分配内存
+    TEST_ASSERT_TRUE(out.reserve(64).is_succ());
+    mstr_heap_get_allocate_count(&alloc_beg, &free_cnt);
+    for (int32_t i = 0; i < 8; i += 1) {
+        res = mtfmt::string::format_to(out, "request #{0:i32} done", i);
+        TEST_ASSERT_TRUE(res.is_succ());
+    }
+    mstr_heap_get_allocate_count(&alloc_end, &free_cnt);
+    ASSERT_EQUAL_VALUE(alloc_beg, alloc_end);
+    ASSERT_EQUAL_VALUE(out, "request #7 done");
+    // 失败的时候返回错误
+    res = mtfmt::string::format_to(out, "{0:u8}", 255);
+    TEST_ASSERT_TRUE(res.is_err());
+#if _MSTR_USE_CONSTEXPR_PARSER
+    res = mtfmt::string::format_to(
+        out, MSTR_COMPILE_FORMAT("[{0:i32}]"), 7
+    );
+    TEST_ASSERT_TRUE(res.is_succ());
+    ASSERT_EQUAL_VALUE(out, "[7]");
+#endif // _MSTR_USE_CONSTEXPR_PARSER
 }
@@ -0,0 +1,1356 @@
+// SPDX-License-Identifier: LGPL-3.0
+/**
+ * @file    mtfmt_codegen.c
+ * @author  向阳 (hinata.hoshino@foxmail.com)
+ * @brief   格式化串的AOT代码生成工具
+ * @version 1.0
+ * @date    2023-08-02
+ *
+ * @copyright Copyright (c) 向阳, all rights reserved.
+ *
+ * 扫描C源文件中 mstr_format / mstr_ioformat / mstr_print
+ * 使用的字面量格式化串, 使用 mm_parser.c 在构建期解析它们,
+ * 然后为每个格式化串生成一个专用的函数, 并生成一个头文件,
+ * 通过宏把调用替换为生成的函数.
+ *
+ * 用法: mtfmt_codegen -o <输出文件名(不含扩展名)> <源文件>...
+ */
+#include "mtfmt.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * @brief 扫描的函数名
+ *
+ */
+typedef struct tagAotCallee
+{
+    //! 名称
+    const char* name;
+
+    //! 格式化串是第几个参数
+    usize_t fmt_arg_index;
+} AotCallee;
+
+/**
+ * @brief 格式化串中的一段
+ *
+ */
+typedef struct tagAotSegment
+{
+    //! 是否为replacement field
+    mstr_bool_t is_field;
+
+    //! 字面量: [beg, end)
+    usize_t beg, end;
+
+    //! replacement field的解析结果
+    MStrFmtParseResult field;
+} AotSegment;
+
+/**
+ * @brief 一个格式化串
+ *
+ */
+typedef struct tagAotFormat
+{
+    //! 格式化串 (已经处理了转义)
+    char* fmt;
+
+    //! 格式化串的长度
+    usize_t len;
+
+    //! 是否可以生成专用的函数
+    mstr_bool_t supported;
+
+    //! 各段
+    AotSegment* segs;
+
+    //! 段数
+    usize_t seg_cnt;
+
+    //! 参数的类型
+    MStrFmtArgType arg_types[MFMT_PLACE_MAX_NUM];
+
+    //! 参数数目
+    usize_t arg_cnt;
+} AotFormat;
+
+/**
+ * @brief 所有的格式化串
+ *
+ */
+typedef struct tagAotContext
+{
+    AotFormat* formats;
+    usize_t count;
+    usize_t cap;
+} AotContext;
+
+/**
+ * @brief 需要扫描的调用
+ *
+ * @note mstr_print 展开为 mstr_ioformat, 因此只需要替换后者
+ */
+static const AotCallee aot_callees[] = {
+    {"mstr_format", 1},
+    {"mstr_ioformat", 1},
+    {"mstr_print", 0},
+};
+
+static void* aot_xrealloc(void*, usize_t);
+static char* aot_read_file(const char*, usize_t*);
+static void aot_scan_source(AotContext*, const char*, usize_t);
+static usize_t aot_skip_blank(const char*, usize_t, usize_t);
+static usize_t aot_skip_literal(const char*, usize_t, usize_t);
+static usize_t aot_skip_argument(const char*, usize_t, usize_t);
+static mstr_bool_t aot_read_string(
+    const char*, usize_t, usize_t, char**, usize_t*
+);
+static void aot_add_format(AotContext*, char*, usize_t);
+static void aot_analyze(AotFormat*);
+static mstr_bool_t aot_add_arg(AotFormat*, uint32_t, MStrFmtArgType);
+static void aot_push_segment(AotFormat*, const AotSegment*);
+static void aot_push_literal(AotFormat*, usize_t, usize_t);
+static mstr_bool_t aot_is_direct_field(const MStrFmtParseResult*);
+static void aot_emit_string(FILE*, const char*, usize_t);
+static void aot_emit_char(FILE*, char);
+static void aot_emit_pointer(
+    FILE*, const AotFormat*, usize_t, const char*, const char*
+);
+static void aot_emit_source(FILE*, const AotContext*, const char*);
+static void aot_emit_field(FILE*, const AotFormat*, usize_t, usize_t);
+static void aot_emit_function(FILE*, const AotFormat*, usize_t);
+static void aot_emit_header(FILE*, const AotContext*, const char*);
+static void aot_emit_dispatch(
+    FILE*, const AotContext*, const char*, const char*, const char*
+);
+
+int main(int argc, char** argv)
+{
+    AotContext ctx = {NULL, 0, 0};
+    const char* out_name = NULL;
+    char* path = NULL;
+    const char* base_name = NULL;
+    FILE* fp = NULL;
+    int i = 1;
+    usize_t supported = 0;
+    // 命令行
+    if (argc > 2 && strcmp(argv[1], "-o") == 0) {
+        out_name = argv[2];
+        i = 3;
+    }
+    if (out_name == NULL || i >= argc) {
+        fprintf(
+            stderr, "usage: %s -o <output> <source>...\n", argv[0]
+        );
+        return 1;
+    }
+    for (; i < argc; i += 1) {
+        usize_t len = 0;
+        char* src = aot_read_file(argv[i], &len);
+        if (src == NULL) {
+            fprintf(stderr, "error: cannot read '%s'\n", argv[i]);
+            return 1;
+        }
+        aot_scan_source(&ctx, src, len);
+        free(src);
+    }
+    for (usize_t k = 0; k < ctx.count; k += 1) {
+        aot_analyze(&ctx.formats[k]);
+        supported += ctx.formats[k].supported ? 1 : 0;
+    }
+    // 输出的 .h 和 .c
+    base_name = strrchr(out_name, '/');
+    base_name = base_name == NULL ? out_name : base_name + 1;
+    path = (char*)aot_xrealloc(NULL, strlen(out_name) + 3);
+    sprintf(path, "%s.h", out_name);
+    fp = fopen(path, "w");
+    if (fp == NULL) {
+        fprintf(stderr, "error: cannot write '%s'\n", path);
+        return 1;
+    }
+    aot_emit_header(fp, &ctx, base_name);
+    fclose(fp);
+    sprintf(path, "%s.c", out_name);
+    fp = fopen(path, "w");
+    if (fp == NULL) {
+        fprintf(stderr, "error: cannot write '%s'\n", path);
+        return 1;
+    }
+    aot_emit_source(fp, &ctx, base_name);
+    fclose(fp);
+    printf(
+        "%s: %u format strings, %u specialized\n",
+        out_name,
+        (unsigned)ctx.count,
+        (unsigned)supported
+    );
+    return 0;
+}
+
+/**
+ * @brief realloc, 失败时退出
+ *
+ */
+static void* aot_xrealloc(void* ptr, usize_t size)
+{
+    void* new_ptr = realloc(ptr, size == 0 ? 1 : size);
+    if (new_ptr == NULL) {
+        fprintf(stderr, "error: out of memory\n");
+        exit(1);
+    }
+    return new_ptr;
+}
+
+/**
+ * @brief 读取整个文件
+ *
+ */
+static char* aot_read_file(const char* path, usize_t* plen)
+{
+    FILE* fp = fopen(path, "rb");
+    char* buff = NULL;
+    usize_t len = 0;
+    usize_t cap = 0;
+    if (fp == NULL) {
+        return NULL;
+    }
+    for (;;) {
+        usize_t n;
+        if (len + 4096 + 1 > cap) {
+            cap = cap * 2 + 4096 + 1;
+            buff = (char*)aot_xrealloc(buff, cap);
+        }
+        n = fread(buff + len, 1, 4096, fp);
+        len += n;
+        if (n < 4096) {
+            break;
+        }
+    }
+    fclose(fp);
+    buff[len] = '\0';
+    *plen = len;
+    return buff;
+}
+
+/**
+ * @brief 是否为标识符的字符
+ *
+ */
+static mstr_bool_t aot_is_ident_char(char ch)
+{
+    return (ch >= 'a' && ch <= 'z') || (ch >= 'A' && ch <= 'Z') ||
+           (ch >= '0' && ch <= '9') || ch == '_';
+}
+
+/**
+ * @brief 扫描源文件, 找出调用中的字面量格式化串
+ *
+ */
+static void aot_scan_source(
+    AotContext* ctx, const char* src, usize_t len
+)
+{
+    usize_t pos = 0;
+    while (pos < len) {
+        const char ch = src[pos];
+        if (ch == '/' && (src[pos + 1] == '/' || src[pos + 1] == '*')) {
+            pos = aot_skip_blank(src, pos, len);
+        }
+        else if (ch == '"' || ch == '\'') {
+            pos = aot_skip_literal(src, pos, len);
+        }
+        else if (aot_is_ident_char(ch)) {
+            usize_t beg = pos;
+            usize_t n_callee = sizeof(aot_callees) / sizeof(AotCallee);
+            while (pos < len && aot_is_ident_char(src[pos])) {
+                pos += 1;
+            }
+            for (usize_t i = 0; i < n_callee; i += 1) {
+                const AotCallee* callee = &aot_callees[i];
+                usize_t arg_pos;
+                char* fmt = NULL;
+                usize_t fmt_len = 0;
+                if (strlen(callee->name) != pos - beg ||
+                    memcmp(callee->name, src + beg, pos - beg) != 0) {
+                    continue;
+                }
+                arg_pos = aot_skip_blank(src, pos, len);
+                if (arg_pos >= len || src[arg_pos] != '(') {
+                    break;
+                }
+                arg_pos += 1;
+                for (usize_t a = 0; a < callee->fmt_arg_index; a += 1) {
+                    arg_pos = aot_skip_argument(src, arg_pos, len);
+                    if (arg_pos >= len || src[arg_pos] != ',') {
+                        arg_pos = len;
+                        break;
+                    }
+                    arg_pos += 1;
+                }
+                if (aot_read_string(
+                        src, arg_pos, len, &fmt, &fmt_len
+                    )) {
+                    aot_add_format(ctx, fmt, fmt_len);
+                }
+                break;
+            }
+        }
+        else {
+            pos += 1;
+        }
+    }
+}
+
+/**
+ * @brief 跳过空白和注释
+ *
+ */
+static usize_t aot_skip_blank(const char* src, usize_t pos, usize_t len)
+{
+    while (pos < len) {
+        if (src[pos] == ' ' || src[pos] == '\t' || src[pos] == '\r' ||
+            src[pos] == '\n') {
+            pos += 1;
+        }
+        else if (src[pos] == '/' && src[pos + 1] == '/') {
+            while (pos < len && src[pos] != '\n') {
+                pos += 1;
+            }
+        }
+        else if (src[pos] == '/' && src[pos + 1] == '*') {
+            pos += 2;
+            while (pos < len &&
+                   !(src[pos] == '*' && src[pos + 1] == '/')) {
+                pos += 1;
+            }
+            pos = pos < len ? pos + 2 : len;
+        }
+        else {
+            break;
+        }
+    }
+    return pos;
+}
+
+/**
+ * @brief 跳过字符串或者字符字面量
+ *
+ */
+static usize_t aot_skip_literal(
+    const char* src, usize_t pos, usize_t len
+)
+{
+    const char quote = src[pos];
+    pos += 1;
+    while (pos < len && src[pos] != quote && src[pos] != '\n') {
+        pos += src[pos] == '\\' ? 2 : 1;
+    }
+    return pos < len ? pos + 1 : len;
+}
+
+/**
+ * @brief 跳过一个参数, 停在顶层的 `,` 或者 `)` 上
+ *
+ */
+static usize_t aot_skip_argument(
+    const char* src, usize_t pos, usize_t len
+)
+{
+    usize_t depth = 0;
+    while (pos < len) {
+        const char ch = src[pos];
+        if (ch == '"' || ch == '\'') {
+            pos = aot_skip_literal(src, pos, len);
+            continue;
+        }
+        else if (ch == '/' &&
+                 (src[pos + 1] == '/' || src[pos + 1] == '*')) {
+            pos = aot_skip_blank(src, pos, len);
+            continue;
+        }
+        else if (ch == '(' || ch == '[' || ch == '{') {
+            depth += 1;
+        }
+        else if (ch == ')' || ch == ']' || ch == '}') {
+            if (depth == 0) {
+                break;
+            }
+            depth -= 1;
+        }
+        else if (ch == ',' && depth == 0) {
+            break;
+        }
+        pos += 1;
+    }
+    return pos;
+}
+
+/**
+ * @brief 读取一个参数, 它必须只由字符串字面量组成
+ *
+ * @param[out] pfmt: 字符串 (处理了转义)
+ * @param[out] plen: 字符串长度
+ */
+static mstr_bool_t aot_read_string(
+    const char* src,
+    usize_t pos,
+    usize_t len,
+    char** pfmt,
+    usize_t* plen
+)
+{
+    char* buff = (char*)aot_xrealloc(NULL, len - pos + 1);
+    usize_t cnt = 0;
+    mstr_bool_t matched = False;
+    pos = aot_skip_blank(src, pos, len);
+    while (pos < len && src[pos] == '"') {
+        pos += 1;
+        while (pos < len && src[pos] != '"') {
+            char ch = src[pos];
+            if (ch == '\n') {
+                free(buff);
+                return False;
+            }
+            else if (ch != '\\') {
+                buff[cnt++] = ch;
+                pos += 1;
+                continue;
+            }
+            pos += 1;
+            ch = src[pos];
+            pos += 1;
+            switch (ch) {
+            case 'n': buff[cnt++] = '\n'; break;
+            case 't': buff[cnt++] = '\t'; break;
+            case 'r': buff[cnt++] = '\r'; break;
+            case 'a': buff[cnt++] = '\a'; break;
+            case 'b': buff[cnt++] = '\b'; break;
+            case 'f': buff[cnt++] = '\f'; break;
+            case 'v': buff[cnt++] = '\v'; break;
+            case 'x':
+            {
+                unsigned v = 0;
+                while (pos < len) {
+                    char h = src[pos];
+                    if (h >= '0' && h <= '9') {
+                        v = v * 16 + (unsigned)(h - '0');
+                    }
+                    else if (h >= 'a' && h <= 'f') {
+                        v = v * 16 + (unsigned)(h - 'a' + 10);
+                    }
+                    else if (h >= 'A' && h <= 'F') {
+                        v = v * 16 + (unsigned)(h - 'A' + 10);
+                    }
+                    else {
+                        break;
+                    }
+                    pos += 1;
+                }
+                buff[cnt++] = (char)v;
+                break;
+            }
+            default:
+                if (ch >= '0' && ch <= '7') {
+                    unsigned v = (unsigned)(ch - '0');
+                    for (int k = 0; k < 2 && src[pos] >= '0' &&
+                                    src[pos] <= '7';
+                         k += 1) {
+                        v = v * 8 + (unsigned)(src[pos] - '0');
+                        pos += 1;
+                    }
+                    buff[cnt++] = (char)v;
+                }
+                else {
+                    // \\ \" \' \?
+                    buff[cnt++] = ch;
+                }
+                break;
+            }
+        }
+        pos += 1;
+        matched = True;
+        pos = aot_skip_blank(src, pos, len);
+    }
+    buff[cnt] = '\0';
+    // 必须紧跟 `,` 或者 `)`, 并且不能有内嵌的 '\0'
+    if (!matched || pos >= len ||
+        (src[pos] != ',' && src[pos] != ')') || strlen(buff) != cnt) {
+        free(buff);
+        return False;
+    }
+    *pfmt = buff;
+    *plen = cnt;
+    return True;
+}
+
+/**
+ * @brief 添加格式化串 (去重)
+ *
+ */
+static void aot_add_format(AotContext* ctx, char* fmt, usize_t len)
+{
+    AotFormat* item;
+    for (usize_t i = 0; i < ctx->count; i += 1) {
+        if (strcmp(ctx->formats[i].fmt, fmt) == 0) {
+            free(fmt);
+            return;
+        }
+    }
+    if (ctx->count == ctx->cap) {
+        ctx->cap = ctx->cap * 2 + 8;
+        ctx->formats = (AotFormat*)aot_xrealloc(
+            ctx->formats, ctx->cap * sizeof(AotFormat)
+        );
+    }
+    item = &ctx->formats[ctx->count];
+    memset(item, 0, sizeof(AotFormat));
+    item->fmt = fmt;
+    item->len = len;
+    ctx->count += 1;
+}
+
+/**
+ * @brief 使用 mm_parser.c 解析格式化串
+ *
+ * @note 和 mstr_context_format 一样遍历格式化串.
+ * 会出错或者依赖于va_arg顺序读取行为的格式化串不生成专用函数,
+ * 在运行时仍然交给 mstr_format 处理, 从而保持一致的行为
+ */
+static void aot_analyze(AotFormat* item)
+{
+    const char* fmt = item->fmt;
+    usize_t pos = 0;
+    item->supported = True;
+    while (pos < item->len && item->supported) {
+        if (fmt[pos] != '{' && fmt[pos] != '}') {
+            usize_t beg = pos;
+            while (pos < item->len && fmt[pos] != '{' &&
+                   fmt[pos] != '}') {
+                pos += 1;
+            }
+            aot_push_literal(item, beg, pos);
+        }
+        else {
+            byte_t state_memory[MFMT_PARSER_STATE_SIZE];
+            MStrFmtParserState* state;
+            AotSegment seg;
+            mstr_result_t result;
+            memset(&seg, 0, sizeof(seg));
+            mstr_fmt_parser_init(state_memory, fmt + pos, &state);
+            result = mstr_fmt_parse_goal(state, &seg.field);
+            if (MSTR_FAILED(result)) {
+                item->supported = False;
+                break;
+            }
+            switch (seg.field.arg_class) {
+            case MStrFmtArgClass_EscapeChar:
+                // `{{` 或者 `}}` 取第一个字符
+                aot_push_literal(item, pos, pos + 1);
+                break;
+            case MStrFmtArgClass_Value:
+                seg.is_field = True;
+                item->supported = aot_add_arg(
+                    item, seg.field.val.val.id, seg.field.val.val.typ
+                );
+                aot_push_segment(item, &seg);
+                break;
+            case MStrFmtArgClass_Array:
+            {
+                MStrFmtParseResultArrayResult* arr = &seg.field.val.arr;
+                MStrFmtArgType array_type = (MStrFmtArgType)(
+                    arr->ele_typ | MStrFmtArgType_Array_Bit
+                );
+                seg.is_field = True;
+                item->supported =
+                    aot_add_arg(item, arr->id, array_type) &&
+                    aot_add_arg(
+                        item, arr->id + 1, MStrFmtArgType_Uint32
+                    );
+                aot_push_segment(item, &seg);
+                break;
+            }
+            }
+            pos += mstr_fmt_parser_end_position(state, fmt + pos);
+        }
+    }
+}
+
+/**
+ * @brief 记录参数的类型
+ *
+ * @note va_arg 只能顺序读取: 参数第一次出现的顺序必须是 0, 1, 2...,
+ * 并且同一个参数的类型要一致
+ */
+static mstr_bool_t aot_add_arg(
+    AotFormat* item, uint32_t id, MStrFmtArgType type
+)
+{
+    if (id < item->arg_cnt) {
+        return item->arg_types[id] == type;
+    }
+    else if (id == item->arg_cnt && id < MFMT_PLACE_MAX_NUM) {
+        item->arg_types[id] = type;
+        item->arg_cnt += 1;
+        return True;
+    }
+    else {
+        return False;
+    }
+}
+
+/**
+ * @brief 添加一段
+ *
+ */
+static void aot_push_segment(AotFormat* item, const AotSegment* seg)
+{
+    item->segs = (AotSegment*)aot_xrealloc(
+        item->segs, (item->seg_cnt + 1) * sizeof(AotSegment)
+    );
+    item->segs[item->seg_cnt] = *seg;
+    item->seg_cnt += 1;
+}
+
+/**
+ * @brief 添加一段字面量, 相邻的字面量合并在一起
+ *
+ */
+static void aot_push_literal(AotFormat* item, usize_t beg, usize_t end)
+{
+    AotSegment seg;
+    if (item->seg_cnt > 0) {
+        AotSegment* last = &item->segs[item->seg_cnt - 1];
+        if (!last->is_field && last->end == beg) {
+            last->end = end;
+            return;
+        }
+    }
+    memset(&seg, 0, sizeof(seg));
+    seg.is_field = False;
+    seg.beg = beg;
+    seg.end = end;
+    aot_push_segment(item, &seg);
+}
+
+/**
+ * @brief 是否可以直接调用转换函数
+ *
+ * @note 没有宽度 (也就不需要对齐和填充) 时, 转换结果直接写到输出
+ */
+static mstr_bool_t aot_is_direct_field(const MStrFmtParseResult* field)
+{
+    const MStrFmtParseResultValueResult* val = &field->val.val;
+    if (field->arg_class != MStrFmtArgClass_Value ||
+        val->spec.width != -1) {
+        return False;
+    }
+    switch (val->typ) {
+    case MStrFmtArgType_Int8:
+    case MStrFmtArgType_Int16:
+    case MStrFmtArgType_Int32:
+    case MStrFmtArgType_Uint8:
+    case MStrFmtArgType_Uint16:
+    case MStrFmtArgType_Uint32:
+        // 十六进制转储由运行时报告错误
+        return val->spec.fmt_spec.fmt_type <=
+               MStrFmtFormatType_Hex_UpperCase_WithPrefix;
+    case MStrFmtArgType_QuantizedValue:
+    case MStrFmtArgType_QuantizedUnsignedValue:
+    case MStrFmtArgType_QuantizedValue64:
+    case MStrFmtArgType_QuantizedUnsignedValue64:
+    case MStrFmtArgType_FixedValue:
+    case MStrFmtArgType_FixedUnsignedValue: return True;
+    case MStrFmtArgType_CString:
+    case MStrFmtArgType_Time:
+    case MStrFmtArgType_Timestamp:
+        return val->spec.fmt_spec.fmt_type == MStrFmtFormatType_UnSpec;
+    default: return False;
+    }
+}
+
+/**
+ * @brief 整数的格式化类型对应的index
+ *
+ */
+static const char* aot_int_index_name(MStrFmtFormatType type)
+{
+    switch (type) {
+    case MStrFmtFormatType_Binary: return "MStrFmtIntIndex_Bin";
+    case MStrFmtFormatType_Oct: return "MStrFmtIntIndex_Oct";
+    case MStrFmtFormatType_Hex: return "MStrFmtIntIndex_Hex";
+    case MStrFmtFormatType_Hex_UpperCase:
+        return "MStrFmtIntIndex_Hex_UpperCase";
+    case MStrFmtFormatType_Hex_WithPrefix:
+        return "MStrFmtIntIndex_Hex_WithPrefix";
+    case MStrFmtFormatType_Hex_UpperCase_WithPrefix:
+        return "MStrFmtIntIndex_Hex_UpperCase_WithPrefix";
+    default: return "MStrFmtIntIndex_Dec";
+    }
+}
+
+/**
+ * @brief 输出C字符串字面量
+ *
+ */
+static void aot_emit_string(FILE* fp, const char* str, usize_t len)
+{
+    fputc('"', fp);
+    for (usize_t i = 0; i < len; i += 1) {
+        unsigned char ch = (unsigned char)str[i];
+        if (ch == '"' || ch == '\\' || ch == '?') {
+            fprintf(fp, "\\%c", ch);
+        }
+        else if (ch < 0x20 || ch == 0x7f) {
+            fprintf(fp, "\\%03o", ch);
+        }
+        else {
+            fputc(ch, fp);
+        }
+    }
+    fputc('"', fp);
+}
+
+/**
+ * @brief 输出C字符字面量
+ *
+ */
+static void aot_emit_char(FILE* fp, char ch)
+{
+    unsigned char uch = (unsigned char)ch;
+    if (ch == '\'' || ch == '\\') {
+        fprintf(fp, "'\\%c'", ch);
+    }
+    else if (uch < 0x20 || uch >= 0x7f) {
+        fprintf(fp, "'\\%03o'", uch);
+    }
+    else {
+        fprintf(fp, "'%c'", ch);
+    }
+}
+
+/**
+ * @brief 输出split的指针
+ *
+ * @note 指向格式化串内的指针按照偏移输出,
+ * 否则 (parser的默认值) 输出到单独的字符数组
+ */
+static void aot_emit_pointer(
+    FILE* fp,
+    const AotFormat* item,
+    usize_t index,
+    const char* name,
+    const char* ptr
+)
+{
+    if (ptr == NULL) {
+        fputs("NULL", fp);
+    }
+    else if (ptr >= item->fmt && ptr <= item->fmt + item->len) {
+        fprintf(
+            fp,
+            "mstr_aot_fmt_%u + %u",
+            (unsigned)index,
+            (unsigned)(ptr - item->fmt)
+        );
+    }
+    else {
+        fputs(name, fp);
+    }
+}
+
+/**
+ * @brief 输出不在格式化串内的split
+ *
+ */
+static void aot_emit_split_decl(
+    FILE* fp,
+    const AotFormat* item,
+    const char* name,
+    const char* beg,
+    const char* end
+)
+{
+    if (beg == NULL ||
+        (beg >= item->fmt && beg <= item->fmt + item->len)) {
+        return;
+    }
+    fprintf(fp, "static const char %s[] = ", name);
+    aot_emit_string(fp, beg, (usize_t)(end - beg));
+    fputs(";\n", fp);
+}
+
+/**
+ * @brief 输出replacement field的解析结果
+ *
+ */
+static void aot_emit_field(
+    FILE* fp, const AotFormat* item, usize_t index, usize_t seg_index
+)
+{
+    const MStrFmtParseResult* field = &item->segs[seg_index].field;
+    const mstr_bool_t is_array =
+        field->arg_class == MStrFmtArgClass_Array;
+    const MStrFmtFormatDescript* spec = &field->val.val.spec;
+    const MStrFmtArgType typ =
+        is_array ? field->val.arr.ele_typ : field->val.val.typ;
+    const MStrFmtChronoFormatSpec* chrono = &spec->fmt_spec.spec.chrono;
+    const mstr_bool_t is_chrono =
+        typ == MStrFmtArgType_Time || typ == MStrFmtArgType_Timestamp;
+    char name[64];
+    // 不在格式化串内的split
+    if (is_array) {
+        sprintf(
+            name,
+            "mstr_aot_split_%u_%u",
+            (unsigned)index,
+            (unsigned)seg_index
+        );
+        aot_emit_split_decl(
+            fp,
+            item,
+            name,
+            field->val.arr.split_beg,
+            field->val.arr.split_end
+        );
+    }
+    for (usize_t i = 0; is_chrono && i < chrono->item_cnt; i += 1) {
+        sprintf(
+            name,
+            "mstr_aot_split_%u_%u_%u",
+            (unsigned)index,
+            (unsigned)seg_index,
+            (unsigned)i
+        );
+        aot_emit_split_decl(
+            fp,
+            item,
+            name,
+            chrono->items[i].split_beg,
+            chrono->items[i].split_end
+        );
+    }
+    fprintf(
+        fp,
+        "static const MStrFmtParseResult mstr_aot_field_%u_%u = {\n",
+        (unsigned)index,
+        (unsigned)seg_index
+    );
+    fprintf(
+        fp, "    .arg_class = (MStrFmtArgClass)%d,\n", field->arg_class
+    );
+    fprintf(fp, "    .val.%s = {\n", is_array ? "arr" : "val");
+    fprintf(fp, "        .id = %u,\n", (unsigned)field->val.val.id);
+    fprintf(
+        fp,
+        "        .%s = (MStrFmtArgType)%d,\n",
+        is_array ? "ele_typ" : "typ",
+        typ
+    );
+    fprintf(
+        fp,
+        "        .%s = {%u, %u},\n",
+        is_array ? "ele_prop" : "prop",
+        (unsigned)field->val.val.prop.a,
+        (unsigned)field->val.val.prop.b
+    );
+    fputs("        .spec = {\n            .fill_char = ", fp);
+    aot_emit_char(fp, spec->fill_char);
+    fprintf(
+        fp,
+        ",\n            .fmt_align = (MStrFmtAlign)%d,\n"
+        "            .sign_display = (MStrFmtSignDisplay)%d,\n"
+        "            .width = %d,\n"
+        "            .precision = %d,\n"
+        "            .fmt_spec.fmt_type = (MStrFmtFormatType)%d,\n",
+        spec->fmt_align,
+        spec->sign_display,
+        (int)spec->width,
+        (int)spec->precision,
+        spec->fmt_spec.fmt_type
+    );
+    if (is_chrono) {
+        fputs("            .fmt_spec.spec.chrono = {\n", fp);
+        fputs("                .items = {\n", fp);
+        for (usize_t i = 0; i < chrono->item_cnt; i += 1) {
+            const MStrFmtChronoItemFormatSpec* it = &chrono->items[i];
+            sprintf(
+                name,
+                "mstr_aot_split_%u_%u_%u",
+                (unsigned)index,
+                (unsigned)seg_index,
+                (unsigned)i
+            );
+            fprintf(
+                fp,
+                "                    {(MStrFmtChronoValueType)%d, "
+                "{(mstr_bool_t)%d, %u}, ",
+                it->value_type,
+                (int)it->chrono_spec.fixed_length,
+                (unsigned)it->chrono_spec.format_length
+            );
+            aot_emit_pointer(fp, item, index, name, it->split_beg);
+            fputs(", ", fp);
+            if (it->split_beg != NULL && it->split_end != NULL) {
+                aot_emit_pointer(fp, item, index, name, it->split_beg);
+                fprintf(
+                    fp,
+                    " + %u",
+                    (unsigned)(it->split_end - it->split_beg)
+                );
+            }
+            else {
+                fputs("NULL", fp);
+            }
+            fputs("},\n", fp);
+        }
+        fputs("                },\n", fp);
+        fprintf(
+            fp,
+            "                .item_cnt = %u,\n            },\n",
+            (unsigned)chrono->item_cnt
+        );
+    }
+    fputs("        },\n", fp);
+    if (is_array) {
+        const char* split_beg = field->val.arr.split_beg;
+        const char* split_end = field->val.arr.split_end;
+        sprintf(
+            name,
+            "mstr_aot_split_%u_%u",
+            (unsigned)index,
+            (unsigned)seg_index
+        );
+        fputs("        .split_beg = ", fp);
+        aot_emit_pointer(fp, item, index, name, split_beg);
+        fputs(",\n        .split_end = ", fp);
+        aot_emit_pointer(fp, item, index, name, split_beg);
+        fprintf(fp, " + %u,\n", (unsigned)(split_end - split_beg));
+    }
+    fputs("    },\n};\n\n", fp);
+}
+
+/**
+ * @brief 输出一个格式化串的专用函数
+ *
+ */
+static void aot_emit_function(
+    FILE* fp, const AotFormat* item, usize_t index
+)
+{
+    const unsigned n = (unsigned)index;
+    mstr_bool_t need_ctx = False;
+    // 格式化串 & 解析结果
+    fputs("static const char ", fp);
+    fprintf(fp, "mstr_aot_fmt_%u[] = ", n);
+    aot_emit_string(fp, item->fmt, item->len);
+    fputs(";\n\n", fp);
+    for (usize_t i = 0; i < item->seg_cnt; i += 1) {
+        const AotSegment* seg = &item->segs[i];
+        if (!seg->is_field) {
+            continue;
+        }
+        if (!aot_is_direct_field(&seg->field)) {
+            need_ctx = True;
+            aot_emit_field(fp, item, index, i);
+        }
+        else if (seg->field.val.val.typ == MStrFmtArgType_Time ||
+                 seg->field.val.val.typ == MStrFmtArgType_Timestamp) {
+            aot_emit_field(fp, item, index, i);
+        }
+    }
+    // vformat
+    fprintf(
+        fp,
+        "static mstr_result_t mstr_aot_vformat_%u(\n"
+        "    MString* res_str, usize_t fmt_place, va_list* ap_ptr\n"
+        ")\n{\n"
+        "    mstr_result_t result = MStr_Ok;\n",
+        n
+    );
+    if (item->arg_cnt > 0) {
+        fprintf(
+            fp,
+            "    MStrFmtFormatArgument argv[%u];\n",
+            (unsigned)item->arg_cnt
+        );
+    }
+    if (need_ctx) {
+        fputs("    MStrFmtArgsContext ctx;\n", fp);
+    }
+    fprintf(
+        fp,
+        "    if (fmt_place < %u || fmt_place > MFMT_PLACE_MAX_NUM) {\n"
+        "        return mstr_vformat(\n"
+        "            mstr_aot_fmt_%u, res_str, fmt_place, ap_ptr\n"
+        "        );\n"
+        "    }\n",
+        (unsigned)item->arg_cnt,
+        n
+    );
+    for (usize_t i = 0; i < item->arg_cnt; i += 1) {
+        fprintf(
+            fp,
+            "    argv[%u].value = va_arg(*ap_ptr, iptr_t);\n"
+            "    argv[%u].type = (MStrFmtArgType)%d;\n",
+            (unsigned)i,
+            (unsigned)i,
+            item->arg_types[i]
+        );
+    }
+    if (need_ctx) {
+        fprintf(
+            fp,
+            "    ctx.p_ap = NULL;\n"
+            "    ctx.p_args = argv;\n"
+            "    ctx.max_place = %u;\n",
+            (unsigned)item->arg_cnt
+        );
+    }
+    for (usize_t i = 0; i < item->seg_cnt; i += 1) {
+        const AotSegment* seg = &item->segs[i];
+        const MStrFmtParseResultValueResult* val = &seg->field.val.val;
+        const unsigned id = (unsigned)val->id;
+        fputs("    MSTR_AND_THEN(\n        result,\n        ", fp);
+        if (!seg->is_field) {
+            fprintf(
+                fp,
+                "mstr_concat_cstr_slice(\n"
+                "            res_str,\n"
+                "            mstr_aot_fmt_%u + %u,\n"
+                "            mstr_aot_fmt_%u + %u\n"
+                "        )",
+                n,
+                (unsigned)seg->beg,
+                n,
+                (unsigned)seg->end
+            );
+        }
+        else if (!aot_is_direct_field(&seg->field)) {
+            fprintf(
+                fp,
+                "mstr_context_format_field(\n"
+                "            res_str, &mstr_aot_field_%u_%u, &ctx\n"
+                "        )",
+                n,
+                (unsigned)i
+            );
+        }
+        else {
+            switch (val->typ) {
+            case MStrFmtArgType_Int8:
+            case MStrFmtArgType_Int16:
+            case MStrFmtArgType_Int32:
+                fprintf(
+                    fp,
+                    "mstr_fmt_itoa(\n"
+                    "            res_str,\n"
+                    "            (int32_t)argv[%u].value,\n"
+                    "            %s,\n"
+                    "            (MStrFmtSignDisplay)%d\n"
+                    "        )",
+                    id,
+                    aot_int_index_name(val->spec.fmt_spec.fmt_type),
+                    val->spec.sign_display
+                );
+                break;
+            case MStrFmtArgType_Uint8:
+            case MStrFmtArgType_Uint16:
+            case MStrFmtArgType_Uint32:
+                fprintf(
+                    fp,
+                    "mstr_fmt_utoa(\n"
+                    "            res_str,\n"
+                    "            (uint32_t)argv[%u].value,\n"
+                    "            %s\n"
+                    "        )",
+                    id,
+                    aot_int_index_name(val->spec.fmt_spec.fmt_type)
+                );
+                break;
+            case MStrFmtArgType_QuantizedValue:
+            case MStrFmtArgType_QuantizedValue64:
+                fprintf(
+                    fp,
+                    "mstr_fmt_iq64toa(\n"
+                    "            res_str,\n"
+                    "            %sargv[%u].value,\n"
+                    "            %u,\n"
+                    "            %d,\n"
+                    "            (MStrFmtSignDisplay)%d\n"
+                    "        )",
+                    val->typ == MStrFmtArgType_QuantizedValue
+                        ? "(int32_t)"
+                        : "*(const int64_t*)",
+                    id,
+                    (unsigned)val->prop.a,
+                    (int)val->spec.precision,
+                    val->spec.sign_display
+                );
+                break;
+            case MStrFmtArgType_QuantizedUnsignedValue:
+            case MStrFmtArgType_QuantizedUnsignedValue64:
+                fprintf(
+                    fp,
+                    "mstr_fmt_uq64toa(\n"
+                    "            res_str,\n"
+                    "            %sargv[%u].value,\n"
+                    "            %u,\n"
+                    "            %d\n"
+                    "        )",
+                    val->typ == MStrFmtArgType_QuantizedUnsignedValue
+                        ? "(uint32_t)"
+                        : "*(const uint64_t*)",
+                    id,
+                    (unsigned)val->prop.a,
+                    (int)val->spec.precision
+                );
+                break;
+            case MStrFmtArgType_FixedValue:
+                fprintf(
+                    fp,
+                    "mstr_fmt_ifixtoa(\n"
+                    "            res_str,\n"
+                    "            (int32_t)argv[%u].value,\n"
+                    "            %u,\n"
+                    "            %u,\n"
+                    "            %d,\n"
+                    "            (MStrFmtSignDisplay)%d\n"
+                    "        )",
+                    id,
+                    (unsigned)val->prop.a,
+                    (unsigned)val->prop.b,
+                    (int)val->spec.precision,
+                    val->spec.sign_display
+                );
+                break;
+            case MStrFmtArgType_FixedUnsignedValue:
+                fprintf(
+                    fp,
+                    "mstr_fmt_ufixtoa(\n"
+                    "            res_str,\n"
+                    "            (uint32_t)argv[%u].value,\n"
+                    "            %u,\n"
+                    "            %u,\n"
+                    "            %d\n"
+                    "        )",
+                    id,
+                    (unsigned)val->prop.a,
+                    (unsigned)val->prop.b,
+                    (int)val->spec.precision
+                );
+                break;
+            case MStrFmtArgType_CString:
+                fprintf(
+                    fp,
+                    "mstr_concat_cstr(\n"
+                    "            res_str, (const char*)argv[%u].value\n"
+                    "        )",
+                    id
+                );
+                break;
+            case MStrFmtArgType_Timestamp:
+                fprintf(
+                    fp,
+                    "mstr_fmt_tstoa(\n"
+                    "            res_str,\n"
+                    "            (const MStrTimestamp*)argv[%u]"
+                    ".value,\n"
+                    "            &mstr_aot_field_%u_%u.val.val.spec"
+                    ".fmt_spec.spec.chrono\n"
+                    "        )",
+                    id,
+                    n,
+                    (unsigned)i
+                );
+                break;
+            default:
+                // MStrFmtArgType_Time
+                fprintf(
+                    fp,
+                    "mstr_fmt_ttoa(\n"
+                    "            res_str,\n"
+                    "            (const MStrTime*)argv[%u].value,\n"
+                    "            &mstr_aot_field_%u_%u.val.val.spec"
+                    ".fmt_spec.spec.chrono\n"
+                    "        )",
+                    id,
+                    n,
+                    (unsigned)i
+                );
+                break;
+            }
+        }
+        fputs("\n    );\n", fp);
+    }
+    fputs("    return result;\n}\n\n", fp);
+    // mstr_format
+    fprintf(
+        fp,
+        "mstr_result_t mstr_aot_format_%u(\n"
+        "    MString* res_str,\n"
+        "    const char* fmt,\n"
+        "    usize_t fmt_place,\n"
+        "    ...\n"
+        ")\n{\n"
+        "    va_list ap;\n"
+        "    mstr_result_t result;\n"
+        "    (void)fmt;\n"
+        "    va_start(ap, fmt_place);\n"
+        "    result = mstr_aot_vformat_%u(res_str, fmt_place, &ap);\n"
+        "    va_end(ap);\n"
+        "    return result;\n}\n\n",
+        n,
+        n
+    );
+    // mstr_ioformat
+    fprintf(
+        fp,
+        "mstr_result_t mstr_aot_ioformat_%u(\n"
+        "    MStrIOCallback* io,\n"
+        "    const char* fmt,\n"
+        "    usize_t fmt_place,\n"
+        "    ...\n"
+        ")\n{\n"
+        "    va_list ap;\n"
+        "    MString buff;\n"
+        "    mstr_result_t result;\n"
+        "    (void)fmt;\n"
+        "    result = mstr_create_empty(&buff);\n"
+        "    if (MSTR_FAILED(result)) {\n"
+        "        return result;\n"
+        "    }\n"
+        "    va_start(ap, fmt_place);\n"
+        "    result = mstr_aot_vformat_%u(&buff, fmt_place, &ap);\n"
+        "    va_end(ap);\n"
+        "    MSTR_AND_THEN(\n"
+        "        result,\n"
+        "        io->io_write(\n"
+        "            io->capture,\n"
+        "            (const byte_t*)buff.buff,\n"
+        "            buff.count\n"
+        "        )\n"
+        "    );\n"
+        "    mstr_free(&buff);\n"
+        "    return result;\n}\n\n",
+        n,
+        n
+    );
+}
+
+/**
+ * @brief 输出 .c
+ *
+ */
+static void aot_emit_source(
+    FILE* fp, const AotContext* ctx, const char* base_name
+)
+{
+    fputs(
+        "// Generated by mtfmt_codegen, DO NOT EDIT.\n"
+        "// clang-format off\n",
+        fp
+    );
+    fprintf(fp, "#include \"%s.h\"\n\n", base_name);
+    for (usize_t i = 0; i < ctx->count; i += 1) {
+        if (ctx->formats[i].supported) {
+            aot_emit_function(fp, &ctx->formats[i], i);
+        }
+    }
+}
+
+/**
+ * @brief 输出 .h
+ *
+ */
+static void aot_emit_header(
+    FILE* fp, const AotContext* ctx, const char* base_name
+)
+{
+    fputs(
+        "// Generated by mtfmt_codegen, DO NOT EDIT.\n"
+        "// clang-format off\n",
+        fp
+    );
+    fputs(
+        "#if !defined(_INCLUDE_MTFMT_AOT_H_)\n"
+        "#define _INCLUDE_MTFMT_AOT_H_ 1\n"
+        "#include \"mtfmt.h\"\n"
+        "#include <string.h>\n\n"
+        "#if defined(__cplusplus)\n"
+        "extern \"C\" {\n"
+        "#endif // __cplusplus\n",
+        fp
+    );
+    (void)base_name;
+    for (usize_t i = 0; i < ctx->count; i += 1) {
+        if (!ctx->formats[i].supported) {
+            continue;
+        }
+        fprintf(
+            fp,
+            "mstr_result_t mstr_aot_format_%u("
+            "MString*, const char*, usize_t, ...);\n"
+            "mstr_result_t mstr_aot_ioformat_%u("
+            "MStrIOCallback*, const char*, usize_t, ...);\n",
+            (unsigned)i,
+            (unsigned)i
+        );
+    }
+    fputs(
+        "#if defined(__cplusplus)\n"
+        "}\n"
+        "#endif // __cplusplus\n\n"
+        "#if defined(__GNUC__)\n"
+        "#define MSTR_AOT_STREQ(a, b) \\\n"
+        "    (__builtin_strcmp((a), (b)) == 0)\n"
+        "#else\n"
+        "#define MSTR_AOT_STREQ(a, b) (strcmp((a), (b)) == 0)\n"
+        "#endif\n\n"
+        "#if !defined(MSTR_AOT_DISABLE)\n",
+        fp
+    );
+    aot_emit_dispatch(
+        fp, ctx, "MSTR_AOT_FORMAT_FN", "format", "mstr_format"
+    );
+    aot_emit_dispatch(
+        fp, ctx, "MSTR_AOT_IOFORMAT_FN", "ioformat", "mstr_ioformat"
+    );
+    fputs(
+        "#define mstr_format(res_str, fmt, ...) \\\n"
+        "    (MSTR_AOT_FORMAT_FN(fmt)((res_str), (fmt), __VA_ARGS__))\n"
+        "#define mstr_ioformat(io, fmt, ...) \\\n"
+        "    (MSTR_AOT_IOFORMAT_FN(fmt)((io), (fmt), __VA_ARGS__))\n"
+        "#endif // MSTR_AOT_DISABLE\n"
+        "#endif // _INCLUDE_MTFMT_AOT_H_\n",
+        fp
+    );
+}
+
+/**
+ * @brief 输出选择函数的宏
+ *
+ * @note 参数为字面量时, 比较会在编译期完成, 只留下对专用函数的调用
+ */
+static void aot_emit_dispatch(
+    FILE* fp,
+    const AotContext* ctx,
+    const char* macro,
+    const char* suffix,
+    const char* fallback
+)
+{
+    fprintf(fp, "#define %s(fmt) ( \\\n", macro);
+    for (usize_t i = 0; i < ctx->count; i += 1) {
+        const AotFormat* item = &ctx->formats[i];
+        if (!item->supported) {
+            continue;
+        }
+        fputs("    MSTR_AOT_STREQ((fmt), ", fp);
+        aot_emit_string(fp, item->fmt, item->len);
+        fprintf(fp, ") ? mstr_aot_%s_%u : \\\n", suffix, (unsigned)i);
+    }
+    fprintf(fp, "    (%s))\n", fallback);
+}